@@ -0,0 +1,139 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include "Definitions.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * Synthetic circuits of scalable size used by the benchmarks. All generators
+ * are deterministic for a given seed so that runs of different releases can be
+ * compared against each other.
+ */
+namespace bench {
+
+// quantum Fourier transform without the final qubit reversal
+[[maybe_unused]] inline qc::QuantumComputation qft(const std::size_t nqubits) {
+  qc::QuantumComputation qc(nqubits);
+  for (std::size_t i = 0; i < nqubits; ++i) {
+    const auto target = static_cast<qc::Qubit>(i);
+    qc.h(target);
+    for (std::size_t j = i + 1; j < nqubits; ++j) {
+      const auto control = static_cast<qc::Qubit>(j);
+      qc.cp(qc::PI / static_cast<qc::fp>(1ULL << (j - i)),
+            qc::Control{control}, target);
+    }
+  }
+  return qc;
+}
+
+// two random distinct qubits
+[[maybe_unused]] inline std::pair<qc::Qubit, qc::Qubit>
+randomPair(const std::size_t nqubits, std::mt19937_64& rng) {
+  std::uniform_int_distribution<std::size_t> dist(0, nqubits - 1);
+  const auto first = dist(rng);
+  auto second = dist(rng);
+  while (second == first) {
+    second = dist(rng);
+  }
+  return {static_cast<qc::Qubit>(first), static_cast<qc::Qubit>(second)};
+}
+
+// CNOTs between uniformly chosen qubit pairs
+[[maybe_unused]] inline qc::QuantumComputation
+randomCnot(const std::size_t nqubits, const std::size_t ngates,
+           const std::uint64_t seed = 42U) {
+  std::mt19937_64 rng(seed);
+  qc::QuantumComputation qc(nqubits);
+  for (std::size_t i = 0; i < ngates; ++i) {
+    const auto [control, target] = randomPair(nqubits, rng);
+    qc.cx(qc::Control{control}, target);
+  }
+  return qc;
+}
+
+// random Clifford circuit made of H, S and CNOT gates
+[[maybe_unused]] inline qc::QuantumComputation
+randomClifford(const std::size_t nqubits, const std::size_t ngates,
+               const std::uint64_t seed = 42U) {
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<std::size_t> gateDist(0, 2);
+  std::uniform_int_distribution<std::size_t> qubitDist(0, nqubits - 1);
+  qc::QuantumComputation qc(nqubits);
+  for (std::size_t i = 0; i < ngates; ++i) {
+    switch (gateDist(rng)) {
+    case 0:
+      qc.h(static_cast<qc::Qubit>(qubitDist(rng)));
+      break;
+    case 1:
+      qc.s(static_cast<qc::Qubit>(qubitDist(rng)));
+      break;
+    default:
+      if (nqubits > 1) {
+        const auto [control, target] = randomPair(nqubits, rng);
+        qc.cx(qc::Control{control}, target);
+      }
+      break;
+    }
+  }
+  return qc;
+}
+
+/**
+ * @brief edges of a random graph on `nqubits` vertices containing a ring, so
+ * that every qubit interacts, and `nqubits / 2` random chords
+ */
+[[maybe_unused]] inline std::vector<std::pair<qc::Qubit, qc::Qubit>>
+qaoaEdges(const std::size_t nqubits, const std::uint64_t seed = 42U) {
+  std::mt19937_64 rng(seed);
+  std::vector<std::pair<qc::Qubit, qc::Qubit>> edges;
+  for (std::size_t i = 0; i + 1 < nqubits; ++i) {
+    edges.emplace_back(static_cast<qc::Qubit>(i),
+                       static_cast<qc::Qubit>(i + 1));
+  }
+  if (nqubits > 2) {
+    edges.emplace_back(static_cast<qc::Qubit>(nqubits - 1), 0U);
+    for (std::size_t i = 0; i < nqubits / 2; ++i) {
+      edges.emplace_back(randomPair(nqubits, rng));
+    }
+  }
+  return edges;
+}
+
+/**
+ * @brief QAOA-like circuit for MaxCut on the graph given by `qaoaEdges`, where
+ * each cost term is decomposed into CNOT-RZ-CNOT
+ */
+[[maybe_unused]] inline qc::QuantumComputation
+qaoaLike(const std::size_t nqubits, const std::size_t layers,
+         const std::uint64_t seed = 42U) {
+  const auto edges = qaoaEdges(nqubits, seed);
+  qc::QuantumComputation qc(nqubits);
+  for (std::size_t i = 0; i < nqubits; ++i) {
+    qc.h(static_cast<qc::Qubit>(i));
+  }
+  for (std::size_t layer = 0; layer < layers; ++layer) {
+    const auto gamma = qc::PI / static_cast<qc::fp>(layer + 2);
+    for (const auto& [u, v] : edges) {
+      qc.cx(qc::Control{u}, v);
+      qc.rz(gamma, v);
+      qc.cx(qc::Control{u}, v);
+    }
+    for (std::size_t i = 0; i < nqubits; ++i) {
+      qc.rx(gamma / 2, static_cast<qc::Qubit>(i));
+    }
+  }
+  return qc;
+}
+
+} // namespace bench
@@ -0,0 +1,67 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "CircuitGenerators.hpp"
+#include "cliffordsynthesis/CliffordSynthesizer.hpp"
+#include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/TargetMetric.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+/**
+ * @brief synthesizes a random Clifford circuit with `state.range(0)` qubits
+ * and `state.range(1)` gates
+ */
+void synthesize(benchmark::State& state, const cs::Configuration& config) {
+  auto qc = bench::randomClifford(static_cast<std::size_t>(state.range(0)),
+                                  static_cast<std::size_t>(state.range(1)));
+
+  std::size_t gates = 0;
+  for (auto _ : state) {
+    cs::CliffordSynthesizer synthesizer(qc);
+    synthesizer.synthesize(config);
+    gates = synthesizer.getResults().getGates();
+    benchmark::DoNotOptimize(gates);
+  }
+  state.counters["gates"] = static_cast<double>(gates);
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          state.range(1));
+}
+
+void BM_CliffordOptimalGates(benchmark::State& state) {
+  cs::Configuration config{};
+  config.target = cs::TargetMetric::Gates;
+  synthesize(state, config);
+}
+void BM_CliffordOptimalDepth(benchmark::State& state) {
+  cs::Configuration config{};
+  config.target = cs::TargetMetric::Depth;
+  synthesize(state, config);
+}
+void BM_CliffordHeuristicGates(benchmark::State& state) {
+  cs::Configuration config{};
+  config.target = cs::TargetMetric::Gates;
+  config.heuristic = true;
+  synthesize(state, config);
+}
+
+} // namespace
+
+BENCHMARK(BM_CliffordOptimalGates)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{2, 3}, {8, 16}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CliffordOptimalDepth)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{2, 3}, {8, 16}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CliffordHeuristicGates)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{4, 8, 16}, {32, 64}})
+    ->Unit(benchmark::kMillisecond);
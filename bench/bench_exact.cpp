@@ -0,0 +1,57 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "Architecture.hpp"
+#include "CircuitGenerators.hpp"
+#include "configuration/Configuration.hpp"
+#include "configuration/Method.hpp"
+#include "exact/ExactMapper.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+/**
+ * @brief maps `state.range(1)` random CNOTs on `state.range(0)` qubits to the
+ * 5-qubit IBMQ London architecture
+ */
+void mapExact(benchmark::State& state, const bool useSubsets) {
+  Architecture arch;
+  arch.loadCouplingMap("architectures/ibmq_london.arch");
+  const auto qc =
+      bench::randomCnot(static_cast<std::size_t>(state.range(0)),
+                        static_cast<std::size_t>(state.range(1)));
+
+  Configuration config{};
+  config.method = Method::Exact;
+  config.useSubsets = useSubsets;
+
+  std::size_t swaps = 0;
+  for (auto _ : state) {
+    ExactMapper mapper(qc, arch);
+    mapper.map(config);
+    swaps = mapper.getResults().output.swaps;
+    benchmark::DoNotOptimize(swaps);
+  }
+  state.counters["swaps"] = static_cast<double>(swaps);
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          state.range(1));
+}
+
+void BM_ExactSubsets(benchmark::State& state) { mapExact(state, true); }
+void BM_ExactNoSubsets(benchmark::State& state) { mapExact(state, false); }
+
+void exactArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"qubits", "gates"})
+      ->ArgsProduct({{3, 4}, {4, 8, 12}})
+      ->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+BENCHMARK(BM_ExactSubsets)->Apply(exactArguments);
+BENCHMARK(BM_ExactNoSubsets)->Apply(exactArguments);
@@ -0,0 +1,118 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "Architecture.hpp"
+#include "CircuitGenerators.hpp"
+#include "configuration/Configuration.hpp"
+#include "configuration/Heuristic.hpp"
+#include "configuration/Layering.hpp"
+#include "configuration/LookaheadHeuristic.hpp"
+#include "heuristic/HeuristicMapper.hpp"
+#include "ir/QuantumComputation.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+constexpr Heuristic GATE_COUNT_HEURISTICS[] = {
+    Heuristic::GateCountMaxDistance, Heuristic::GateCountSumDistance,
+    Heuristic::GateCountSumDistanceMinusSharedSwaps,
+    Heuristic::GateCountMaxDistanceOrSumDistanceMinusSharedSwaps};
+constexpr Layering HEURISTIC_LAYERINGS[] = {Layering::IndividualGates,
+                                            Layering::DisjointQubits,
+                                            Layering::Disjoint2qBlocks};
+
+enum class Circuit : std::uint8_t { QFT, RandomCnot, QAOA };
+
+qc::QuantumComputation generate(const Circuit circuit,
+                                const std::size_t nqubits) {
+  switch (circuit) {
+  case Circuit::QFT:
+    return bench::qft(nqubits);
+  case Circuit::RandomCnot:
+    return bench::randomCnot(nqubits, 20 * nqubits);
+  default:
+    return bench::qaoaLike(nqubits, 2);
+  }
+}
+
+/**
+ * @brief maps a synthetic circuit with `state.range(0)` qubits to IBMQ Tokyo
+ * (20 qubits) using the heuristic and layering with the indices
+ * `state.range(1)` and `state.range(2)`
+ */
+void mapHeuristic(benchmark::State& state, const Circuit circuit) {
+  Architecture arch;
+  arch.loadCouplingMap("architectures/ibmq_tokyo.arch");
+  const auto qc = generate(circuit, static_cast<std::size_t>(state.range(0)));
+
+  Configuration config{};
+  config.heuristic =
+      GATE_COUNT_HEURISTICS[static_cast<std::size_t>(state.range(1))];
+  config.layering =
+      HEURISTIC_LAYERINGS[static_cast<std::size_t>(state.range(2))];
+  state.SetLabel(toString(config.heuristic) + "/" + toString(config.layering));
+
+  std::size_t swaps = 0;
+  for (auto _ : state) {
+    HeuristicMapper mapper(qc, arch);
+    mapper.map(config);
+    swaps = mapper.getResults().output.swaps;
+    benchmark::DoNotOptimize(swaps);
+  }
+  state.counters["swaps"] = static_cast<double>(swaps);
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(qc.getNops()));
+}
+
+void BM_HeuristicQFT(benchmark::State& state) {
+  mapHeuristic(state, Circuit::QFT);
+}
+void BM_HeuristicRandomCnot(benchmark::State& state) {
+  mapHeuristic(state, Circuit::RandomCnot);
+}
+void BM_HeuristicQAOA(benchmark::State& state) {
+  mapHeuristic(state, Circuit::QAOA);
+}
+
+// fidelity-aware mapping to IBMQ London using its bundled calibration data
+void BM_HeuristicFidelityRandomCnot(benchmark::State& state) {
+  Architecture arch;
+  arch.loadCouplingMap("architectures/ibmq_london.arch");
+  arch.loadProperties("calibration/ibmq_london.csv");
+  const auto ngates = static_cast<std::size_t>(state.range(0));
+  const auto qc = bench::randomCnot(5U, ngates);
+
+  Configuration config{};
+  config.heuristic = Heuristic::FidelityBestLocation;
+  config.lookaheadHeuristic = LookaheadHeuristic::None;
+
+  for (auto _ : state) {
+    HeuristicMapper mapper(qc, arch);
+    mapper.map(config);
+    benchmark::DoNotOptimize(mapper.getResults().output.swaps);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          state.range(0));
+}
+
+void heuristicArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"qubits", "heuristic", "layering"})
+      ->ArgsProduct({{4, 8, 12, 16, 20}, {0, 1, 2, 3}, {0, 1, 2}})
+      ->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+BENCHMARK(BM_HeuristicQFT)->Apply(heuristicArguments);
+BENCHMARK(BM_HeuristicRandomCnot)->Apply(heuristicArguments);
+BENCHMARK(BM_HeuristicQAOA)->Apply(heuristicArguments);
+BENCHMARK(BM_HeuristicFidelityRandomCnot)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMillisecond);
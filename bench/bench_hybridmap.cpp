@@ -0,0 +1,67 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "CircuitGenerators.hpp"
+#include "hybridmap/HybridNeutralAtomMapper.hpp"
+#include "hybridmap/NeutralAtomArchitecture.hpp"
+#include "hybridmap/NeutralAtomUtils.hpp"
+#include "ir/QuantumComputation.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+// the architectures of the hybridmap tests
+const std::string HYBRID_ARCHITECTURES[] = {"rubidium", "rubidium_hybrid",
+                                            "rubidium_shuttling"};
+
+/**
+ * @brief maps a circuit to the architecture with the index `state.range(1)`
+ * and converts the result to AOD operations
+ */
+void mapHybrid(benchmark::State& state, const qc::QuantumComputation& qc) {
+  const auto& name =
+      HYBRID_ARCHITECTURES[static_cast<std::size_t>(state.range(1))];
+  const auto arch =
+      na::NeutralAtomArchitecture("architectures/" + name + ".json");
+  state.SetLabel(name);
+
+  for (auto _ : state) {
+    auto circ = qc;
+    na::NeutralAtomMapper mapper(arch);
+    mapper.mapAndConvert(circ, na::InitialMapping::Identity, false);
+    benchmark::DoNotOptimize(mapper.getMappedQcAODObject().getNops());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(qc.getNops()));
+}
+
+void BM_HybridQFT(benchmark::State& state) {
+  mapHybrid(state, bench::qft(static_cast<std::size_t>(state.range(0))));
+}
+void BM_HybridRandomCnot(benchmark::State& state) {
+  const auto nqubits = static_cast<std::size_t>(state.range(0));
+  mapHybrid(state, bench::randomCnot(nqubits, 10 * nqubits));
+}
+void BM_HybridQAOA(benchmark::State& state) {
+  mapHybrid(state,
+            bench::qaoaLike(static_cast<std::size_t>(state.range(0)), 2));
+}
+
+// all architectures have at least 11 atoms
+void hybridArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"qubits", "architecture"})
+      ->ArgsProduct({{4, 8, 11}, {0, 1, 2}})
+      ->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+BENCHMARK(BM_HybridQFT)->Apply(hybridArguments);
+BENCHMARK(BM_HybridRandomCnot)->Apply(hybridArguments);
+BENCHMARK(BM_HybridQAOA)->Apply(hybridArguments);
@@ -0,0 +1,158 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "Architecture.hpp"
+#include "CircuitGenerators.hpp"
+#include "Configuration.hpp"
+#include "Definitions.hpp"
+#include "NAMapper.hpp"
+#include "ir/QuantumComputation.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// the zoned architecture of the NAMapper tests with 1296 sites
+na::Architecture natureArchitecture() {
+  std::istringstream archIS(R"({
+      "name": "Nature",
+      "initialZones": ["storage"],
+      "zones": [
+          {"name": "entangling", "xmin": -300, "xmax": 656, "ymin": -10,
+           "ymax": 46, "fidelity": 0.9959},
+          {"name": "storage", "xmin": -300, "xmax": 656, "ymin": 47,
+           "ymax": 121, "fidelity": 1},
+          {"name": "readout", "xmin": -300, "xmax": 656, "ymin": 122,
+           "ymax": 156, "fidelity": 0.99}
+      ],
+      "operations": [
+          {"name": "rz", "type": "local",
+           "zones": ["entangling", "storage", "readout"], "time": 0.5,
+           "fidelity": 0.999},
+          {"name": "ry", "type": "global",
+           "zones": ["entangling", "storage", "readout"], "time": 0.5,
+           "fidelity": 0.999},
+          {"name": "cz", "type": "global", "zones": ["entangling"],
+           "time": 0.2, "fidelity": 0.9959},
+          {"name": "measure", "type": "global", "zones": ["readout"],
+           "time": 0.2, "fidelity": 0.95}
+      ],
+      "decoherence": {"t1": 100000000, "t2": 1500000},
+      "interactionRadius": 2,
+      "noInteractionRadius": 5,
+      "minAtomDistance": 1,
+      "shuttling": [
+          {"rows": 5, "columns": 5, "xmin": -2.5, "xmax": 2.5, "ymin": -2.5,
+           "ymax": 2.5, "move": {"speed": 0.55, "fidelity": 1},
+           "load": {"time": 20, "fidelity": 1},
+           "store": {"time": 20, "fidelity": 1}}
+      ]
+  })");
+  std::stringstream gridSS;
+  gridSS << "x,y\n";
+  // entangling zone (4 x 36 = 144 sites)
+  for (std::size_t y = 0; y <= 36; y += 12) {
+    for (std::size_t x = 3; x <= 353; x += 10) {
+      gridSS << x << "," << y << "\n";
+    }
+  }
+  // storage zone (12 x 72 = 864 sites)
+  for (std::size_t y = 56; y <= 111; y += 5) {
+    for (std::size_t x = 0; x <= 355; x += 5) {
+      gridSS << x << "," << y << "\n";
+    }
+  }
+  // readout zone (4 x 72 = 288 sites)
+  for (std::size_t y = 131; y <= 146; y += 5) {
+    for (std::size_t x = 0; x <= 355; x += 5) {
+      gridSS << x << "," << y << "\n";
+    }
+  }
+  return {archIS, gridSS};
+}
+
+/**
+ * @brief QAOA-like circuit in the native gate set of the architecture, i.e.,
+ * global RY, local RZ and CZ gates on the edges of `bench::qaoaEdges`
+ */
+qc::QuantumComputation qaoaNative(const std::size_t nqubits,
+                                  const std::size_t layers) {
+  std::stringstream qasm;
+  qasm << "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[" << nqubits
+       << "];\nry(pi/2) q;\n";
+  const auto edges = bench::qaoaEdges(nqubits);
+  for (std::size_t layer = 0; layer < layers; ++layer) {
+    for (const auto& [u, v] : edges) {
+      qasm << "cz q[" << u << "],q[" << v << "];\n";
+    }
+    for (std::size_t i = 0; i < nqubits; ++i) {
+      qasm << "rz(" << qc::PI / static_cast<qc::fp>(layer + 2) << ") q[" << i
+           << "];\n";
+    }
+    qasm << "ry(-pi/4) q;\n";
+  }
+  return qc::QuantumComputation::fromQASM(qasm.str());
+}
+
+// CZ gates between uniformly chosen qubit pairs enclosed by global RY gates
+qc::QuantumComputation randomCz(const std::size_t nqubits,
+                                const std::size_t ngates) {
+  std::mt19937_64 rng(42); // NOLINT(cert-msc51-cpp)
+  std::stringstream qasm;
+  qasm << "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[" << nqubits
+       << "];\nry(pi/2) q;\n";
+  for (std::size_t i = 0; i < ngates; ++i) {
+    const auto [u, v] = bench::randomPair(nqubits, rng);
+    qasm << "cz q[" << u << "],q[" << v << "];\n";
+  }
+  qasm << "ry(-pi/2) q;\n";
+  return qc::QuantumComputation::fromQASM(qasm.str());
+}
+
+void mapNA(benchmark::State& state, const qc::QuantumComputation& qc,
+           const na::NAMappingMethod method) {
+  const auto arch = natureArchitecture();
+  for (auto _ : state) {
+    na::NAMapper mapper(arch, na::Configuration(1, 1, method));
+    mapper.map(qc);
+    benchmark::DoNotOptimize(mapper.getResult());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(qc.getNops()));
+}
+
+void BM_NAMapperQAOA(benchmark::State& state) {
+  mapNA(state, qaoaNative(static_cast<std::size_t>(state.range(0)), 2),
+        na::NAMappingMethod::MaximizeParallelismHeuristic);
+}
+void BM_NAMapperRandomCz(benchmark::State& state) {
+  const auto nqubits = static_cast<std::size_t>(state.range(0));
+  mapNA(state, randomCz(nqubits, 5 * nqubits),
+        na::NAMappingMethod::MaximizeParallelismHeuristic);
+}
+void BM_NAMapperNaiveRandomCz(benchmark::State& state) {
+  const auto nqubits = static_cast<std::size_t>(state.range(0));
+  mapNA(state, randomCz(nqubits, 5 * nqubits), na::NAMappingMethod::Naive);
+}
+
+} // namespace
+
+BENCHMARK(BM_NAMapperQAOA)
+    ->RangeMultiplier(2)
+    ->Range(8, 64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NAMapperRandomCz)
+    ->RangeMultiplier(2)
+    ->Range(8, 64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NAMapperNaiveRandomCz)
+    ->RangeMultiplier(2)
+    ->Range(8, 64)
+    ->Unit(benchmark::kMillisecond);
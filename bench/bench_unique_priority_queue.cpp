@@ -0,0 +1,121 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "heuristic/HeuristicMapper.hpp"
+#include "heuristic/UniquePriorityQueue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+using Node = HeuristicMapper::Node;
+
+/**
+ * @brief the queue design used before the indexed heap, which rebuilds the
+ * whole heap whenever an element is replaced by a cheaper equivalent one
+ */
+class RebuildUniquePriorityQueue {
+  using Heap = std::priority_queue<Node, std::vector<Node>, std::greater<Node>>;
+
+public:
+  bool push(const Node& v) {
+    const auto& insertionPair = membership.insert(v);
+    if (insertionPair.second) {
+      queue.push(v);
+    } else if (std::greater<Node>()(*(insertionPair.first), v)) {
+      membership.erase(insertionPair.first);
+      membership.insert(v);
+      queue = Heap();
+      for (const auto& element : membership) {
+        queue.push(element);
+      }
+      return true;
+    }
+    return insertionPair.second;
+  }
+  void pop() {
+    membership.erase(queue.top());
+    queue.pop();
+  }
+  [[nodiscard]] const Node& top() const { return queue.top(); }
+  [[nodiscard]] bool empty() const { return queue.empty(); }
+
+private:
+  Heap queue;
+  std::set<Node, std::less<Node>> membership;
+};
+
+using IndexedUniquePriorityQueue =
+    UniquePriorityQueue<Node, std::greater<Node>,
+                        HeuristicMapper::NodeLayoutHash,
+                        HeuristicMapper::NodeLayoutEqual>;
+
+/**
+ * @brief generate search nodes on a 20-qubit layout where about every second
+ * node has the same layout as an earlier one (as it happens when different
+ * swap sequences lead to the same mapping during the A* search)
+ */
+std::vector<Node> generateNodes(const std::size_t n) {
+  constexpr std::int16_t NQUBITS = 20;
+  std::mt19937_64 rng(42); // NOLINT(cert-msc51-cpp)
+  std::uniform_real_distribution<double> cost(0., 100.);
+
+  std::vector<std::array<std::int16_t, MAX_DEVICE_QUBITS>> layouts(
+      std::max<std::size_t>(n / 2, 1));
+  for (auto& layout : layouts) {
+    layout.fill(DEFAULT_POSITION);
+    std::iota(layout.begin(), layout.begin() + NQUBITS, std::int16_t{0});
+    std::shuffle(layout.begin(), layout.begin() + NQUBITS, rng);
+  }
+
+  std::uniform_int_distribution<std::size_t> pick(0, layouts.size() - 1);
+  std::vector<Node> nodes{};
+  nodes.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    auto& node = nodes.emplace_back(i);
+    node.qubits = layouts[i < layouts.size() ? i : pick(rng)];
+    node.costFixed = cost(rng);
+    node.costHeur = cost(rng);
+  }
+  return nodes;
+}
+
+template <class Queue> void pushPop(benchmark::State& state) {
+  const auto nodes = generateNodes(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    Queue queue{};
+    for (const auto& node : nodes) {
+      benchmark::DoNotOptimize(queue.push(node));
+    }
+    while (!queue.empty()) {
+      benchmark::DoNotOptimize(queue.top().id);
+      queue.pop();
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          state.range(0));
+}
+
+void BM_UniquePriorityQueueRebuild(benchmark::State& state) {
+  pushPop<RebuildUniquePriorityQueue>(state);
+}
+void BM_UniquePriorityQueueIndexed(benchmark::State& state) {
+  pushPop<IndexedUniquePriorityQueue>(state);
+}
+
+} // namespace
+
+BENCHMARK(BM_UniquePriorityQueueRebuild)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_UniquePriorityQueueIndexed)->RangeMultiplier(4)->Range(64, 4096);
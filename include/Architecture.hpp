@@ -10,10 +10,15 @@
 #include "utils.hpp"
 
 #include <algorithm>
+#include <bitset>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <set>
 #include <string>
@@ -39,6 +44,9 @@ constexpr std::uint32_t COST_DIRECTION_REVERSE = 4 * COST_SINGLE_QUBIT_GATE;
 
 constexpr std::uint16_t MAX_DEVICE_QUBITS = 128;
 
+/** set of physical qubits, bit `q` is set if qubit `q` is contained */
+using QubitSubsetMask = std::bitset<MAX_DEVICE_QUBITS>;
+
 class Architecture {
 public:
   class Properties {
@@ -236,6 +244,14 @@ public:
   }
   [[nodiscard]] CouplingMap& getCouplingMap() { return couplingMap; }
 
+  /**
+   * @brief adjacency structure of the coupling map, built whenever a coupling
+   * map is loaded
+   */
+  [[nodiscard]] const CouplingGraph& getCouplingGraph() const {
+    return couplingGraph;
+  }
+
   void setCouplingMap(const CouplingMap& cm) {
     couplingMap = cm;
     createDistanceTable();
@@ -244,18 +260,27 @@ public:
   [[nodiscard]] bool
   isEdgeConnected(const Edge& edge, const bool considerDirection = true) const {
     if (considerDirection) {
-      return couplingMap.find(edge) != couplingMap.end();
+      return couplingGraph.hasEdge(edge.first, edge.second);
     }
-    return couplingMap.find(edge) != couplingMap.end() ||
-           couplingMap.find({edge.second, edge.first}) != couplingMap.end();
+    return couplingGraph.isConnected(edge.first, edge.second);
   }
 
   [[nodiscard]] bool isEdgeBidirectional(const Edge& edge) const {
-    return couplingMap.find(edge) != couplingMap.end() &&
-           couplingMap.find({edge.second, edge.first}) != couplingMap.end();
+    return couplingGraph.isBidirectional(edge.first, edge.second);
   }
 
-  CouplingMap& getCurrentTeleportations() { return currentTeleportations; }
+  [[nodiscard]] const CouplingMap& getCurrentTeleportations() const {
+    return currentTeleportations;
+  }
+  /**
+   * @brief sets the edges currently added to the coupling map by the
+   * teleportation qubits
+   *
+   * The distances in the extended coupling map are only computed when the
+   * edges change, and the tables of recently used edge sets are kept, so
+   * search nodes sharing the same teleportation endpoints share the distances.
+   */
+  void setCurrentTeleportations(const CouplingMap& teleportations);
   std::vector<std::pair<std::int16_t, std::int16_t>>& getTeleportationQubits() {
     return teleportationQubits;
   }
@@ -268,6 +293,18 @@ public:
     return distanceTable;
   }
 
+  /**
+   * @brief the distance table as returned by `getDistanceTable` in flat
+   * storage
+   */
+  [[nodiscard]] const DistanceTable&
+  getDistances(bool includeReversalCost = true) const {
+    if (includeReversalCost) {
+      return distancesReversals;
+    }
+    return distances;
+  }
+
   [[nodiscard]] const Properties& getProperties() const { return properties; }
 
   [[nodiscard]] Properties& getProperties() { return properties; }
@@ -314,10 +351,10 @@ public:
     if (q2 >= nqubits) {
       throw QMAPException("Qubit out of range.");
     }
-    if (skipEdges >= fidelityDistanceTables.size()) {
+    if (skipEdges >= fidelityDistances.size()) {
       return 0.;
     }
-    return fidelityDistanceTables.at(skipEdges).at(q1).at(q2);
+    return fidelityDistances[skipEdges](q1, q2);
   }
 
   [[nodiscard]] double fidelityDistance(std::uint16_t q1,
@@ -415,8 +452,11 @@ public:
     name = "";
     nqubits = 0;
     couplingMap.clear();
+    couplingGraph = {};
     distanceTable.clear();
     distanceTableReversals.clear();
+    distances.clear();
+    distancesReversals.clear();
     isBidirectional = true;
     isUnidirectional = true;
     properties.clear();
@@ -427,17 +467,19 @@ public:
     twoQubitFidelityCosts.clear();
     swapFidelityCosts.clear();
     fidelityDistanceTables.clear();
+    fidelityDistances.clear();
   }
 
   [[nodiscard]] double distance(std::uint16_t control, std::uint16_t target,
                                 bool includeReversalCost = true) const {
     if (currentTeleportations.empty()) {
+      assert(control < distances.size() && target < distances.size());
       if (includeReversalCost) {
-        return distanceTableReversals.at(control).at(target);
+        return distancesReversals(control, target);
       }
-      return distanceTable.at(control).at(target);
+      return distances(control, target);
     }
-    return static_cast<double>(bfs(control, target, currentTeleportations));
+    return (*teleportationDistances)(control, target);
   }
 
   [[nodiscard]] std::set<std::uint16_t> getQubitSet() const {
@@ -449,28 +491,43 @@ public:
     return result;
   }
 
+  /**
+   * @brief minimal number of SWAPs realizing the given permutation
+   *
+   * The `i`-th smallest qubit in `permutation` is moved to `permutation[i]`
+   * using only SWAPs between the qubits in `permutation`. A bidirectional
+   * breadth-first search over the permutations is used, unless caching is
+   * enabled (see `setSwapDistanceCaching`).
+   *
+   * @param limit if not -1, `limit + 1` is returned as soon as it is clear
+   * that more than `limit` SWAPs are required
+   */
   std::uint64_t minimumNumberOfSwaps(std::vector<std::uint16_t>& permutation,
                                      std::int64_t limit = -1);
+  /**
+   * @brief minimal sequence of SWAPs realizing the given permutation (see
+   * above)
+   */
   void minimumNumberOfSwaps(std::vector<std::uint16_t>& permutation,
                             std::vector<Edge>& swaps);
 
-  struct Node {
-    std::uint64_t nswaps = 0U;
-    std::vector<Edge> swaps;
-    std::unordered_map<std::uint16_t, std::uint16_t> permutation;
-
-    void print(std::ostream& out) {
-      out << swaps.size() << ": ";
-      for (const auto& p : permutation) {
-        out << p.first << "->" << p.second << " ";
-      }
-      out << " | ";
-      for (const auto& swap : swaps) {
-        out << swap.first << "<->" << swap.second << " ";
-      }
-      out << '\n';
-    }
-  };
+  /**
+   * @brief enables or disables caching in `minimumNumberOfSwaps`
+   *
+   * If enabled, the SWAP distances of all permutations of a set of qubits are
+   * computed by a single breadth-first search once the first permutation of
+   * this set is requested. All further requests for the same set are answered
+   * from this table until the coupling map changes. Only sets of up to 10
+   * qubits are cached, larger permutations are always searched directly.
+   * Copies of the architecture share the cache and all methods are safe to be
+   * called concurrently.
+   */
+  void setSwapDistanceCaching(bool enable);
+  [[nodiscard]] bool swapDistanceCaching() const {
+    return swapDistanceCache != nullptr;
+  }
+  /** @brief number of qubit sets whose SWAP distances are cached */
+  [[nodiscard]] std::size_t getSwapDistanceCacheSize() const;
 
   [[nodiscard]] std::size_t getCouplingLimit() const;
   [[nodiscard]] std::size_t
@@ -478,8 +535,31 @@ public:
 
   void getHighestFidelityCouplingMap(std::uint16_t subsetSize,
                                      CouplingMap& reducedMap) const;
+  /**
+   * @brief all subsets of `subsetSize` qubits that are connected in the
+   * coupling graph (in the order of increasing bitmasks of the subsets)
+   */
   [[nodiscard]] std::vector<QubitSubset>
   getAllConnectedSubsets(std::uint16_t subsetSize) const;
+  /**
+   * @brief calls `callback` once for every subset of `subsetSize` qubits that
+   * is connected in the coupling graph (ignoring the direction of edges)
+   *
+   * The subsets are generated one after another by the ESU algorithm (S.
+   * Wernicke, "Efficient Detection of Network Motifs", IEEE/ACM TCBB 2006),
+   * which only ever visits connected subsets and keeps none of them in
+   * memory. Hence, the callback may start working on the first subsets while
+   * the enumeration is still running. If no architecture is available or
+   * `subsetSize` equals the number of qubits, all qubits form the only subset.
+   *
+   * @param callback called for each subset, returning false stops the
+   * enumeration
+   * @return false if the enumeration was stopped by the callback
+   */
+  bool forEachConnectedSubset(
+      std::uint16_t subsetSize,
+      const std::function<bool(const QubitSubsetMask&)>& callback) const;
+  [[nodiscard]] static QubitSubset toQubitSubset(const QubitSubsetMask& mask);
   void getReducedCouplingMaps(std::uint16_t subsetSize,
                               std::vector<CouplingMap>& couplingMaps) const;
   void getReducedCouplingMap(const QubitSubset& qubitChoice,
@@ -505,7 +585,14 @@ protected:
   std::string name;
   std::uint16_t nqubits = 0;
   CouplingMap couplingMap;
+  /** adjacency structure of `couplingMap` (see `createDistanceTable`) */
+  CouplingGraph couplingGraph;
   CouplingMap currentTeleportations;
+  /** distances in the coupling map extended by `currentTeleportations` */
+  std::shared_ptr<const DistanceTable> teleportationDistances;
+  /** distances of the recently used sets of teleportation edges */
+  std::map<CouplingMap, std::shared_ptr<const DistanceTable>>
+      teleportationDistanceCache;
 
   /** true if the coupling map contains no unidirectional edges */
   bool isBidirectional = true;
@@ -515,8 +602,11 @@ protected:
   // unidirectional, and coupling maps containing both bidirectional and
   // unidirectional edges are neither bidirectional nor unidirectional
 
+  /** `distances` and `distancesReversals` as nested vectors */
   Matrix distanceTable;
   Matrix distanceTableReversals;
+  DistanceTable distances;
+  DistanceTable distancesReversals;
   std::vector<std::pair<std::int16_t, std::int16_t>> teleportationQubits;
   Properties properties;
   bool fidelityAvailable = false;
@@ -525,17 +615,43 @@ protected:
   std::vector<double> singleQubitFidelityCosts;
   Matrix twoQubitFidelityCosts;
   Matrix swapFidelityCosts;
+  /** `fidelityDistances` as nested vectors */
   std::vector<Matrix> fidelityDistanceTables;
+  std::vector<DistanceTable> fidelityDistances;
+
+  /** SWAP distances of all permutations of a set of qubits */
+  struct SwapDistanceTable {
+    std::once_flag computed;
+    /** distance of each reachable permutation (packed as in
+     * `minimumNumberOfSwaps`) from the identity */
+    std::unordered_map<std::uint64_t, std::uint8_t> distances;
+  };
+  struct SwapDistanceCache {
+    std::mutex mutex;
+    std::unordered_map<QubitSubsetMask, std::shared_ptr<SwapDistanceTable>>
+        tables;
+  };
+  /** cache of `minimumNumberOfSwaps`, nullptr if caching is disabled */
+  std::shared_ptr<SwapDistanceCache> swapDistanceCache;
+
+  /**
+   * @brief cached SWAP distances of the permutations of `qubits`, `compute`
+   * fills the table when it is first requested
+   *
+   * @return nullptr if caching is disabled
+   */
+  [[nodiscard]] std::shared_ptr<const SwapDistanceTable> getSwapDistanceTable(
+      const QubitSubsetMask& qubits,
+      const std::function<void(std::unordered_map<std::uint64_t,
+                                                  std::uint8_t>&)>& compute)
+      const;
 
   void createDistanceTable();
   void createFidelityTable();
 
   // added for teleportation
-  static bool contains(const std::vector<int>& v, const int e) {
-    return std::find(v.begin(), v.end(), e) != v.end();
-  }
-  [[nodiscard]] std::uint64_t bfs(std::uint16_t start, std::uint16_t goal,
-                                  const std::set<Edge>& teleportations) const;
+  [[nodiscard]] std::shared_ptr<const DistanceTable>
+  createTeleportationDistanceTable(const CouplingMap& teleportations) const;
 
   static std::size_t findCouplingLimit(const CouplingMap& cm,
                                        std::uint16_t nQubits);
@@ -8,24 +8,61 @@
 #include "Architecture.hpp"
 #include "Definitions.hpp"
 #include "MappingResults.hpp"
+#include "configuration/DataLoggingFormat.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/CompoundOperation.hpp"
 #include "utils.hpp"
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+/**
+ * @brief logs the search process of the heuristic mapper
+ *
+ * The search nodes of layer `i` are either written as text to
+ * `nodes_layer_i.csv` or, in the binary format, to `nodes_layer_i.bin` with
+ * the swaps of all nodes in `swaps_layer_i.bin`. Both binary files start with
+ * a header of `BINARY_HEADER_SIZE` bytes (8 bytes magic string, followed by
+ * the format version, the number of qubits and the record size as 32-bit
+ * integers), followed by fixed-size records in native byte order:
+ * - node records: node id, parent id (64-bit), fixed cost, heuristic cost,
+ *   lookahead penalty (double), depth, index of the first swap in the swap
+ *   file (64-bit), number of swaps (32-bit), valid mapping (8-bit), 3 bytes
+ *   padding, layout (16-bit per qubit), padded to a multiple of 8 bytes
+ * - swap records: both qubits, middle ancilla (16-bit), operation type
+ *   (8-bit), 1 byte padding
+ *
+ * Binary records are collected in blocks, which are handed to a background
+ * thread through a lock-free ring buffer, so that writing the files happens
+ * off the critical path of the search.
+ */
 class DataLogger {
 public:
-  DataLogger(std::string path, Architecture& arch, qc::QuantumComputation qc)
+  static constexpr std::uint32_t BINARY_FORMAT_VERSION = 1U;
+  static constexpr std::size_t BINARY_HEADER_SIZE = 32U;
+  static constexpr std::size_t BINARY_NODE_HEADER_SIZE = 64U;
+  static constexpr std::size_t BINARY_SWAP_SIZE = 8U;
+
+  /**
+   * @param lastLayers number of layers (in the order they are searched), of
+   * which the search nodes are kept (0 to keep all)
+   */
+  DataLogger(std::string path, Architecture& arch, qc::QuantumComputation qc,
+             const DataLoggingFormat logFormat = DataLoggingFormat::CSV,
+             const std::size_t lastLayers = 0)
       : dataLoggingPath(std::move(path)), architecture(&arch),
-        nqubits(arch.getNqubits()), inputCircuit(std::move(qc)) {
+        nqubits(arch.getNqubits()), inputCircuit(std::move(qc)),
+        format(logFormat), keptLayers(lastLayers) {
     initLog();
     logArchitecture();
     logInputCircuit(inputCircuit);
@@ -35,7 +72,18 @@ public:
     for (std::size_t i = 0; i < inputCircuit.getNcbits(); ++i) {
       cregs.emplace_back("c", "c[" + std::to_string(i) + "]");
     }
+    if (format == DataLoggingFormat::Binary) {
+      nodeRecordSize =
+          (BINARY_NODE_HEADER_SIZE + sizeof(std::int16_t) * nqubits + 7U) /
+          8U * 8U;
+      writer = std::thread([this] { writeBlocks(); });
+    }
   }
+  DataLogger(const DataLogger&) = delete;
+  DataLogger(DataLogger&&) = delete;
+  DataLogger& operator=(const DataLogger&) = delete;
+  DataLogger& operator=(DataLogger&&) = delete;
+  ~DataLogger();
 
   void initLog();
   void clearLog();
@@ -82,6 +130,55 @@ protected:
   qc::RegisterNames cregs;
   std::vector<std::ofstream> searchNodesLogFiles; // 1 per layer
   bool deactivated = false;
+  DataLoggingFormat format;
+  std::size_t keptLayers;
+  // layers with logged search nodes in the order they were started
+  std::deque<std::size_t> loggedLayers;
 
   void openNewLayer(std::size_t layer);
+  // removes the search nodes of the oldest layers exceeding `keptLayers`
+  void removeOldLayers();
+  [[nodiscard]] std::string nodesFileName(std::size_t layer) const;
+
+  // binary format
+  struct LogBlock {
+    enum class Kind : std::uint8_t { Nodes, Swaps, CloseLayer, RemoveLayer };
+    Kind kind = Kind::Nodes;
+    std::size_t layer = 0;
+    std::vector<char> data;
+  };
+  // size from which a block is handed to the writer thread
+  static constexpr std::size_t BLOCK_SIZE = 1U << 16U;
+  static constexpr std::size_t RING_SIZE = 64U;
+  std::size_t nodeRecordSize = 0;
+  // blocks being filled by the mapper
+  std::size_t currentLayer = 0;
+  std::unique_ptr<LogBlock> nodeBlock;
+  std::unique_ptr<LogBlock> swapBlock;
+  // number of swaps logged and whether the layer has been finalized, per layer
+  std::vector<std::uint64_t> loggedSwaps;
+  std::vector<bool> finalizedLayers;
+
+  // single-producer single-consumer ring buffer, `ringHead` is only advanced
+  // by the writer thread and `ringTail` only by the mapper
+  std::array<std::unique_ptr<LogBlock>, RING_SIZE> ring;
+  std::atomic<std::size_t> ringHead = 0;
+  std::atomic<std::size_t> ringTail = 0;
+  std::atomic<bool> writerStopped = false;
+  std::atomic<bool> writerFailed = false;
+  std::thread writer;
+
+  void logSearchNodeBinary(
+      std::size_t layer, std::size_t nodeId, std::size_t parentId,
+      double costFixed, double costHeur, double lookaheadPenalty,
+      const std::array<std::int16_t, MAX_DEVICE_QUBITS>& qubits,
+      bool validMapping, const std::vector<Exchange>& swaps,
+      std::size_t depth);
+  void pushBlock(std::unique_ptr<LogBlock> block);
+  void flushBlocks();
+  // returns once the writer thread has processed all blocks pushed so far
+  void waitForWriter() const;
+  void stopWriter();
+  // main loop of the writer thread
+  void writeBlocks();
 };
@@ -324,6 +324,18 @@ public:
 
   virtual MappingResults& getResults() { return results; }
 
+  [[nodiscard]] const qc::QuantumComputation& getMappedCircuit() const {
+    return qcMapped;
+  }
+
+  /**
+   * @brief moves the mapped circuit out of the mapper, which is left without
+   * a mapped circuit
+   */
+  [[nodiscard]] qc::QuantumComputation takeMappedCircuit() {
+    return std::move(qcMapped);
+  }
+
   virtual nlohmann::basic_json<> json() { return results.json(); }
 
   virtual std::string csv() { return results.csv(); }
@@ -5,10 +5,12 @@
 
 #include "configuration/Configuration.hpp"
 #include "configuration/Method.hpp"
+#include "ir/QuantumComputation.hpp"
 
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
@@ -88,6 +90,27 @@ struct MappingResults {
     }
   };
 
+  /** outcome of one configuration run by the portfolio mapper */
+  struct PortfolioRunInfo {
+    Configuration config{};
+    double time = 0.;
+    // number of elementary gates added during routing
+    std::size_t routingGates = 0;
+    // true if the run was stopped since it could no longer beat the best run
+    bool stoppedEarly = false;
+
+    [[nodiscard]] nlohmann::basic_json<> json() const {
+      nlohmann::basic_json resultJSON{};
+      resultJSON["config"] = config.json();
+      resultJSON["time"] = time;
+      resultJSON["stopped_early"] = stoppedEarly;
+      if (!stoppedEarly) {
+        resultJSON["routing_gates"] = routingGates;
+      }
+      return resultJSON;
+    }
+  };
+
   CircuitInfo input{};
 
   std::string architecture;
@@ -97,13 +120,21 @@ struct MappingResults {
   bool timeout = true;
 
   CircuitInfo output{};
+  // the mapped circuit as OpenQASM string, if set explicitly
   std::string mappedCircuit;
+  // the mapped circuit itself (shared by all copies of the results), from
+  // which the OpenQASM string is generated on request
+  std::shared_ptr<qc::QuantumComputation> mappedCircuitObject;
 
   std::string wcnf;
 
   HeuristicBenchmarkInfo heuristicBenchmark{};
   std::vector<LayerHeuristicBenchmarkInfo> layerHeuristicBenchmark;
 
+  // runs of the portfolio mapper in the order of its configurations
+  std::vector<PortfolioRunInfo> portfolioRuns;
+  std::size_t portfolioWinner = 0;
+
   MappingResults() = default;
   virtual ~MappingResults() = default;
 
@@ -115,6 +146,21 @@ struct MappingResults {
     wcnf = mappingResults.wcnf;
     heuristicBenchmark = mappingResults.heuristicBenchmark;
     layerHeuristicBenchmark = mappingResults.layerHeuristicBenchmark;
+    portfolioRuns = mappingResults.portfolioRuns;
+    portfolioWinner = mappingResults.portfolioWinner;
+  }
+
+  /**
+   * @brief the mapped circuit as OpenQASM 3 string (`mappedCircuit` if set,
+   * otherwise dumped from `mappedCircuitObject`)
+   */
+  [[nodiscard]] std::string getMappedCircuit() const {
+    if (!mappedCircuit.empty() || mappedCircuitObject == nullptr) {
+      return mappedCircuit;
+    }
+    std::stringstream qasm{};
+    mappedCircuitObject->dump(qasm, qc::Format::OpenQASM3);
+    return qasm.str();
   }
 
   [[nodiscard]] std::string toString() const { return json().dump(2); }
@@ -135,8 +181,8 @@ struct MappingResults {
     mappedCirc["gates"] = output.gates;
     mappedCirc["single_qubit_gates"] = output.singleQubitGates;
     mappedCirc["cnots"] = output.cnots;
-    if (!mappedCircuit.empty()) {
-      mappedCirc["qasm"] = mappedCircuit;
+    if (!mappedCircuit.empty() || mappedCircuitObject != nullptr) {
+      mappedCirc["qasm"] = getMappedCircuit();
     }
 
     resultJSON["config"] = config.json();
@@ -158,6 +204,15 @@ struct MappingResults {
       stats["teleportations"] = output.teleportations;
       stats["benchmark"] = heuristicBenchmark.json();
     }
+    if (!portfolioRuns.empty()) {
+      auto& portfolio = stats["portfolio"];
+      portfolio["winner"] = portfolioWinner;
+      auto& runs = portfolio["runs"];
+      runs = nlohmann::basic_json<>::array();
+      for (const auto& run : portfolioRuns) {
+        runs.emplace_back(run.json());
+      }
+    }
     stats["additional_gates"] =
         static_cast<std::make_signed_t<decltype(output.gates)>>(output.gates) -
         static_cast<std::make_signed_t<decltype(input.gates)>>(input.gates);
@@ -0,0 +1,149 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief fixed set of worker threads for fine-grained data-parallel loops
+ *
+ * The threads are kept alive between calls of `parallelFor`, so that even
+ * loops over only a handful of cheap iterations (e.g., the successors of a
+ * single search node) can be distributed without spawning threads each time.
+ * The calling thread takes part in the work as well.
+ */
+class ThreadPool {
+public:
+  /**
+   * @param nThreads total number of threads working on each loop (including
+   * the calling thread); values below 2 result in sequential execution
+   */
+  explicit ThreadPool(const std::size_t nThreads) {
+    for (std::size_t i = 1; i < nThreads; ++i) {
+      workers.emplace_back([this] { work(); });
+    }
+  }
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+  ~ThreadPool() {
+    {
+      const std::lock_guard lock(mutex);
+      stop = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  /** @brief total number of threads working on each loop */
+  [[nodiscard]] std::size_t size() const { return workers.size() + 1; }
+
+  /**
+   * @brief calls `f(i)` for all `i` in `[0, n)` and returns once all calls
+   * have returned
+   *
+   * The order in which the calls are started is unspecified, i.e., `f` must
+   * only write to state owned by iteration `i`. If any call throws, the
+   * remaining calls are still made and the first exception caught is
+   * rethrown afterwards.
+   */
+  template <class Function>
+  void parallelFor(const std::size_t n, Function&& f) {
+    if (n == 0) {
+      return;
+    }
+    if (workers.empty() || n == 1) {
+      for (std::size_t i = 0; i < n; ++i) {
+        f(i);
+      }
+      return;
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->task = [&f](const std::size_t i) { f(i); };
+    batch->size = n;
+    {
+      const std::lock_guard lock(mutex);
+      current = batch;
+      ++generation;
+    }
+    wake.notify_all();
+
+    batch->run();
+    std::unique_lock lock(batch->mutex);
+    batch->finished.wait(lock,
+                         [&batch] { return batch->completed == batch->size; });
+    if (batch->error) {
+      std::rethrow_exception(batch->error);
+    }
+  }
+
+private:
+  /** @brief iterations of a single `parallelFor` call */
+  struct Batch {
+    std::function<void(std::size_t)> task;
+    std::size_t size = 0;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> completed{0};
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    void run() {
+      for (auto i = next.fetch_add(1); i < size; i = next.fetch_add(1)) {
+        try {
+          task(i);
+        } catch (...) {
+          const std::lock_guard lock(mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+        if (completed.fetch_add(1) + 1 == size) {
+          const std::lock_guard lock(mutex);
+          finished.notify_all();
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake;
+  /** most recent batch, workers join it once they notice a new generation */
+  std::shared_ptr<Batch> current;
+  std::uint64_t generation = 0;
+  bool stop = false;
+
+  void work() {
+    std::uint64_t seen = 0;
+    while (true) {
+      std::shared_ptr<Batch> batch;
+      {
+        std::unique_lock lock(mutex);
+        wake.wait(lock, [this, seen] { return stop || generation != seen; });
+        if (stop) {
+          return;
+        }
+        seen = generation;
+        batch = current;
+      }
+      batch->run();
+    }
+  }
+};
@@ -17,7 +17,6 @@
 #include <limits>
 #include <memory>
 #include <plog/Log.h>
-#include <sstream>
 #include <utility>
 
 namespace cs {
@@ -53,10 +52,10 @@ public:
   [[nodiscard]] Results& getResults() { return results; };
 
   void initResultCircuitFromResults() {
-    std::stringstream ss;
-    ss << results.getResultCircuit();
-    resultCircuit = std::make_unique<qc::QuantumComputation>();
-    resultCircuit->import(ss, qc::Format::OpenQASM3);
+    resultCircuit = results.getResultCircuitObject();
+    if (resultCircuit == nullptr) {
+      resultCircuit = std::make_shared<qc::QuantumComputation>();
+    }
   }
 
   [[nodiscard]] qc::QuantumComputation& getResultCircuit() {
@@ -64,9 +63,10 @@ public:
     return *resultCircuit;
   };
   [[nodiscard]] Tableau& getResultTableau() {
-    std::stringstream ss;
-    ss << results.getResultTableau();
-    resultTableau.fromString(ss.str());
+    if (const auto& tableau = results.getResultTableauObject();
+        tableau != nullptr) {
+      resultTableau = *tableau;
+    }
     return resultTableau;
   }
 
@@ -81,6 +81,8 @@ protected:
   std::shared_ptr<qc::QuantumComputation> resultCircuit;
   Tableau resultTableau;
   std::size_t solverCalls{};
+  // encoder reused by all solver calls of the current binary or linear search
+  std::shared_ptr<encoding::SATEncoder> incrementalEncoder;
 
   static bool requiresMultiGateEncoding(const TargetMetric metric) {
     return metric == TargetMetric::Depth;
@@ -90,6 +92,7 @@ protected:
   std::pair<std::size_t, std::size_t> determineUpperBound(EncoderConfig config);
   void runMaxSAT(const EncoderConfig& config);
   Results callSolver(const EncoderConfig& config);
+  void startIncrementalSolving(const EncoderConfig& config);
 
   void minimizeGatesFixedDepth(EncoderConfig config);
 
@@ -111,6 +114,7 @@ protected:
     PLOG_INFO << "Running binary search in range [" << lowerBound << ", "
               << upperBound << ")";
 
+    startIncrementalSolving(config);
     while (lowerBound != upperBound) {
       value = (lowerBound + upperBound) / 2;
       PLOG_INFO << "Trying value " << value << " in range [" << lowerBound
@@ -125,6 +129,7 @@ protected:
         PLOG_INFO << "No solution found. New lower bound is " << lowerBound;
       }
     }
+    incrementalEncoder.reset();
     PLOG_INFO << "Found optimum: " << lowerBound;
   }
 
@@ -137,6 +142,7 @@ protected:
     if (upperBound == 0U) {
       upperBound = std::numeric_limits<std::size_t>::max();
     }
+    startIncrementalSolving(config);
     for (value = lowerBound; value < upperBound; ++value) {
       PLOG_INFO << "Trying value " << value << " in range [" << lowerBound
                 << ", " << upperBound << ")";
@@ -144,16 +150,18 @@ protected:
       updateResults(configuration, r, results);
       if (r.sat()) {
         PLOG_INFO << "Found optimum " << value;
+        incrementalEncoder.reset();
         return;
       }
       PLOG_INFO << "No solution found. Trying next value.";
     }
+    incrementalEncoder.reset();
     PLOG_INFO << "No solution found in given interval.";
   }
 
   static std::shared_ptr<qc::QuantumComputation>
   synthesizeSubcircuit(const std::shared_ptr<qc::QuantumComputation>& qc,
-                       std::size_t begin, std::size_t end,
+                       Results::HeuristicBlockInfo& block,
                        const Configuration& config);
   static void updateResults(const Configuration& config,
                             const Results& newResults, Results& currentResults);
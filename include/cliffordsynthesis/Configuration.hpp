@@ -30,6 +30,7 @@ struct Configuration {
   std::size_t minimalTimesteps = 0U;
   bool useMaxSAT = false;
   bool linearSearch = false;
+  bool incrementalSolving = true;
   TargetMetric target = TargetMetric::Gates;
   bool useSymmetryBreaking = true;
   bool dumpIntermediateResults = false;
@@ -38,6 +39,11 @@ struct Configuration {
 
   /// Settings for the SAT solver
   SolverParameterMap solverParameters;
+  // encode directly into clauses instead of Z3 expressions (of the solver
+  // parameters, only `timeout` and `max_conflicts` are supported)
+  bool useCNFBackend = false;
+  // external DIMACS solver used by the CNF backend (built-in solver if empty)
+  std::string cnfSolverCommand;
 
   /// Settings for depth-optimal synthesis
   bool minimizeGatesAfterDepthOptimization = false;
@@ -58,6 +64,7 @@ struct Configuration {
     j["minimal_timesteps"] = minimalTimesteps;
     j["use_max_sat"] = useMaxSAT;
     j["linear_search"] = linearSearch;
+    j["incremental_solving"] = incrementalSolving;
     j["target_metric"] = toString(target);
     j["use_symmetry_breaking"] = useSymmetryBreaking;
     j["minimize_gates_after_depth_optimization"] =
@@ -70,6 +77,10 @@ struct Configuration {
     j["heuristic"] = heuristic;
     j["split_size"] = splitSize;
     j["n_threads_heuristic"] = nThreadsHeuristic;
+    j["use_cnf_backend"] = useCNFBackend;
+    if (!cnfSolverCommand.empty()) {
+      j["cnf_solver_command"] = cnfSolverCommand;
+    }
     if (!solverParameters.empty()) {
       nlohmann::basic_json solverParametersJson;
       for (const auto& entry : solverParameters) {
@@ -12,14 +12,37 @@
 
 #include <cstddef>
 #include <limits>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace cs {
 class Results {
 public:
+  // statistics on a block of the circuit synthesized by the heuristic
+  struct HeuristicBlockInfo {
+    // the block covers the operations [begin, end) of the original circuit
+    std::size_t begin = 0U;
+    std::size_t end = 0U;
+    std::size_t depth = 0U;
+    double runtime = 0.0;
+    std::size_t solverCalls = 0U;
+
+    [[nodiscard]] nlohmann::basic_json<> json() const {
+      nlohmann::basic_json blockJSON{};
+      blockJSON["begin"] = begin;
+      blockJSON["end"] = end;
+      blockJSON["depth"] = depth;
+      blockJSON["runtime"] = runtime;
+      blockJSON["solver_calls"] = solverCalls;
+      return blockJSON;
+    }
+  };
+
   Results() = default;
   Results(qc::QuantumComputation& qc, const Tableau& tableau) {
     // SWAP gates are not natively supported in the encoding, so we need to
@@ -49,9 +72,37 @@ public:
     return solverResult;
   }
   [[nodiscard]] std::size_t getSolverCalls() const { return solverCalls; }
+  [[nodiscard]] const std::vector<HeuristicBlockInfo>&
+  getHeuristicBlocks() const {
+    return heuristicBlocks;
+  }
 
-  [[nodiscard]] std::string getResultCircuit() const { return resultCircuit; }
-  [[nodiscard]] std::string getResultTableau() const { return resultTableau; }
+  // the result circuit and tableau as strings, generated on request
+  [[nodiscard]] std::string getResultCircuit() const {
+    if (resultCircuit == nullptr) {
+      return "";
+    }
+    std::stringstream ss;
+    resultCircuit->dumpOpenQASM3(ss);
+    return ss.str();
+  }
+  [[nodiscard]] std::string getResultTableau() const {
+    if (resultTableau == nullptr) {
+      return "";
+    }
+    std::stringstream ss;
+    ss << *resultTableau;
+    return ss.str();
+  }
+  // the result circuit and tableau themselves (shared by all copies of the
+  // results, `nullptr` if not set)
+  [[nodiscard]] const std::shared_ptr<qc::QuantumComputation>&
+  getResultCircuitObject() const {
+    return resultCircuit;
+  }
+  [[nodiscard]] const std::shared_ptr<Tableau>& getResultTableauObject() const {
+    return resultTableau;
+  }
 
   void setSingleQubitGates(const std::size_t g) { singleQubitGates = g; }
   void setTwoQubitGates(const std::size_t g) { twoQubitGates = g; }
@@ -59,16 +110,15 @@ public:
   void setRuntime(const double t) { runtime = t; }
   void setSolverResult(const logicbase::Result r) { solverResult = r; }
   void setSolverCalls(const std::size_t c) { solverCalls = c; }
+  void setHeuristicBlocks(std::vector<HeuristicBlockInfo> blocks) {
+    heuristicBlocks = std::move(blocks);
+  }
 
-  void setResultCircuit(qc::QuantumComputation& qc) {
-    std::stringstream ss;
-    qc.dumpOpenQASM3(ss);
-    resultCircuit = ss.str();
+  void setResultCircuit(qc::QuantumComputation qc) {
+    resultCircuit = std::make_shared<qc::QuantumComputation>(std::move(qc));
   }
-  void setResultTableau(const Tableau& tableau) {
-    std::stringstream ss;
-    ss << tableau;
-    resultTableau = ss.str();
+  void setResultTableau(Tableau tableau) {
+    resultTableau = std::make_shared<Tableau>(std::move(tableau));
   }
 
   [[nodiscard]] bool sat() const {
@@ -86,6 +136,12 @@ public:
     resultJSON["depth"] = depth;
     resultJSON["runtime"] = runtime;
     resultJSON["solver_calls"] = solverCalls;
+    if (!heuristicBlocks.empty()) {
+      auto& blocks = resultJSON["heuristic_blocks"];
+      for (const auto& block : heuristicBlocks) {
+        blocks.emplace_back(block.json());
+      }
+    }
 
     return resultJSON;
   }
@@ -102,9 +158,11 @@ protected:
   std::size_t depth = std::numeric_limits<std::size_t>::max();
   double runtime = 0.0;
   std::size_t solverCalls = 0U;
+  // blocks in circuit order (only set by the heuristic synthesis)
+  std::vector<HeuristicBlockInfo> heuristicBlocks;
 
-  std::string resultTableau;
-  std::string resultCircuit;
+  std::shared_ptr<Tableau> resultTableau;
+  std::shared_ptr<qc::QuantumComputation> resultCircuit;
 };
 
 } // namespace cs
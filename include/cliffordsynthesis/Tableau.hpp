@@ -21,17 +21,53 @@
 #include <vector>
 
 namespace cs {
+/**
+ * The tableau is stored column-major with every column packed into 64-bit
+ * words, i.e., bit `i % 64` of word `i / 64` of a column holds the entry of
+ * row `i`. Clifford gates only combine a few columns across all rows, so they
+ * are applied to 64 rows at once in loops the compiler can vectorize.
+ */
 class Tableau {
   using EntryType = std::uint8_t;
   using RowType = std::vector<EntryType>;
   using TableauType = std::vector<RowType>;
+  using WordType = std::uint64_t;
+  static constexpr std::size_t WORD_BITS = 64U;
+
   std::size_t nQubits{};
-  TableauType tableau;
+  std::size_t nRows{};
+  std::size_t nColumns{};
+  // number of words per column
+  std::size_t nWords{};
+  // all columns one after another, unused bits of the last words are zero
+  std::vector<WordType> bits;
 
 private:
   void loadStabilizerDestabilizerString(const std::string& string);
   static RowType parseStabilizer(const std::string& stab);
 
+  void resize(std::size_t rows, std::size_t columns);
+  void setRows(const TableauType& rows);
+
+  [[nodiscard]] WordType* columnWords(const std::size_t index) {
+    return bits.data() + (index * nWords);
+  }
+  [[nodiscard]] const WordType*
+  columnWords(const std::size_t index) const {
+    return bits.data() + (index * nWords);
+  }
+  [[nodiscard]] EntryType entry(const std::size_t row,
+                                const std::size_t col) const {
+    return static_cast<EntryType>(
+        (columnWords(col)[row / WORD_BITS] >> (row % WORD_BITS)) & 1U);
+  }
+  void setEntry(const std::size_t row, const std::size_t col,
+                const bool value) {
+    const auto mask = WordType{1} << (row % WORD_BITS);
+    auto& word = columnWords(col)[row / WORD_BITS];
+    word = value ? (word | mask) : (word & ~mask);
+  }
+
 public:
   Tableau() = default;
   explicit Tableau(const qc::QuantumComputation& qc, std::size_t begin = 0,
@@ -44,37 +80,40 @@ public:
   }
   explicit Tableau(const std::string& description) {
     fromString(description);
-    if (tableau.empty()) {
+    if (nRows == 0U) {
       throw std::runtime_error("Tableau is empty");
     }
-    nQubits = tableau.back().size() / 2U;
+    nQubits = nColumns / 2U;
   }
   explicit Tableau(const std::string& stabilizers,
                    const std::string& destabilizers) {
     fromString(stabilizers, destabilizers);
-    nQubits = tableau.size() / 2U;
+    nQubits = nRows / 2U;
   }
 
-  [[nodiscard]] RowType operator[](const std::size_t index) {
-    return tableau[index];
-  }
   [[nodiscard]] RowType operator[](const std::size_t index) const {
-    return tableau[index];
+    RowType row(nColumns);
+    for (std::size_t j = 0U; j < nColumns; ++j) {
+      row[j] = entry(index, j);
+    }
+    return row;
   }
 
-  [[nodiscard]] RowType at(const std::size_t index) {
-    return tableau.at(index);
+  [[nodiscard]] RowType at(const std::size_t index) const {
+    if (index >= nRows) {
+      throw std::out_of_range("Tableau::at: row index out of range");
+    }
+    return (*this)[index];
   }
 
   [[nodiscard]] std::size_t getQubitCount() const { return nQubits; }
 
-  [[nodiscard]] std::size_t getTableauSize() const { return tableau.size(); }
+  [[nodiscard]] std::size_t getTableauSize() const { return nRows; }
 
-  [[nodiscard]] bool hasDestabilizers() const {
-    return tableau.size() == 2 * nQubits;
-  }
+  [[nodiscard]] bool hasDestabilizers() const { return nRows == 2 * nQubits; }
 
-  [[nodiscard]] auto& getTableau() const { return tableau; }
+  // the entries in row-major order (created on demand)
+  [[nodiscard]] TableauType getTableau() const;
 
   void dump(const std::string& filename) const;
 
@@ -90,17 +129,17 @@ public:
     assert(nQ <= getTableauSize());
     assert(nQ <= N);
     for (std::size_t i = 0U; i < nQ; ++i) {
-      if (bv[i]) {
-        tableau[i][column] = 1;
-      } else {
-        tableau[i][column] = 0;
-      }
+      setEntry(i, column, bv[i]);
     }
   }
   void populateTableauFrom(const std::uint64_t bv, const std::size_t nQ,
                            const std::size_t column) {
     populateTableauFrom(std::bitset<64>(bv), nQ, column);
   }
+  // sets the first `nQ` entries of a column from words as returned by
+  // `getBVWordsFrom`, which allows tableaus with more than 64 rows
+  void populateTableauFrom(const std::vector<std::uint64_t>& words,
+                           std::size_t nQ, std::size_t column);
 
   void applyGate(const qc::Operation* gate);
   void applyH(std::size_t target);
@@ -120,7 +159,8 @@ public:
   void applyECR(std::size_t q1, std::size_t q2);
 
   [[gnu::pure]] friend bool operator==(const Tableau& lhs, const Tableau& rhs) {
-    return lhs.tableau == rhs.tableau;
+    return lhs.nRows == rhs.nRows && lhs.nColumns == rhs.nColumns &&
+           lhs.bits == rhs.bits;
   }
   [[gnu::pure]] friend bool operator!=(const Tableau& lhs, const Tableau& rhs) {
     return !(lhs == rhs);
@@ -154,14 +194,23 @@ public:
     assert(nQubits <= N);
     std::bitset<N> bv;
     for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-      if (tableau[i][column] == 1U) {
+      if (entry(i, column) == 1U) {
         bv[i] = 1;
       }
     }
     return bv;
   }
   [[nodiscard]] std::uint64_t getBVFrom(const std::size_t column) const {
-    return getBVFrom<64>(column).to_ullong();
+    assert(column <= 2 * nQubits);
+    return nWords == 0U ? 0U : columnWords(column)[0];
+  }
+  // all entries of a column in 64-bit words, row `i` is bit `i % 64` of word
+  // `i / 64`
+  [[nodiscard]] std::vector<std::uint64_t>
+  getBVWordsFrom(const std::size_t column) const {
+    assert(column <= 2 * nQubits);
+    const auto* const words = columnWords(column);
+    return {words, words + nWords};
   }
 };
 } // namespace cs
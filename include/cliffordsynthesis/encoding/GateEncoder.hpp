@@ -58,6 +58,10 @@ public:
 
   virtual void encodeSymmetryBreakingConstraints();
 
+  // the condition that no gate is applied at the given timestep
+  [[nodiscard]] logicbase::LogicTerm
+  createNoGateAtTimestep(std::size_t pos) const;
+
   // extracting the circuit
   void extractCircuitFromModel(Results& res, logicbase::Model& model);
 
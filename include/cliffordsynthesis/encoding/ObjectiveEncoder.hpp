@@ -36,6 +36,12 @@ public:
         op(cost, logicbase::LogicTerm(static_cast<int>(maxGateCount))));
   }
 
+  // a fresh variable that limits the gate count to at most `maxGateCount` if
+  // it is true (e.g., to impose the limit via an assumption)
+  [[nodiscard]] logicbase::LogicTerm
+  createGateCountLimitVariable(std::size_t maxGateCount,
+                               bool includeSingleQubitGates = true) const;
+
   void optimizeMetric(TargetMetric targetMetric) const;
 
   void optimizeGateCount(bool includeSingleQubitGates = true) const;
@@ -16,8 +16,10 @@
 #include "logicblocks/LogicBlock.hpp"
 
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
 
 namespace cs::encoding {
 
@@ -58,6 +60,12 @@ public:
     std::optional<std::size_t> twoQubitGateLimit = std::nullopt;
 
     SolverParameterMap solverParameters;
+
+    // whether to encode plain SAT calls directly into clauses
+    bool useCNFBackend = false;
+
+    // the external solver used by the CNF backend (built-in if empty)
+    std::string cnfSolverCommand;
   };
 
   SATEncoder() = default;
@@ -68,10 +76,27 @@ public:
 
   virtual Results run();
 
+  // Creates the formulation once for the configured timestep limit, so that
+  // `runIncremental` can solve it repeatedly with fewer timesteps or stricter
+  // gate limits. Only supported without MaxSAT.
+  void prepareIncrementalRuns();
+
+  // Solves the formulation created by `prepareIncrementalRuns` with the
+  // timesteps from `timesteps` on left empty and the given gate limits. The
+  // limits are imposed via assumptions, so everything the solver learned in
+  // previous runs is kept.
+  Results runIncremental(std::size_t timesteps,
+                         std::optional<std::size_t> gateLimit,
+                         std::optional<std::size_t> twoQubitGateLimit);
+
+  [[nodiscard]] std::size_t getTimestepLimit() const { return T; }
+
 protected:
   void initializeSolver();
   void createFormulation();
   [[nodiscard]] logicbase::Result solve() const;
+  [[nodiscard]] logicbase::Result
+  solve(const logicbase::LogicVector& assumptions) const;
   void extractResultsFromModel(Results& res) const;
   void cleanup() const;
 
@@ -80,6 +105,15 @@ protected:
   std::shared_ptr<GateEncoder> gateEncoder;
   std::shared_ptr<ObjectiveEncoder> objectiveEncoder;
 
+  // variables that keep the respective timestep free of gates if true (only
+  // used for incremental runs)
+  logicbase::LogicVector idleTimesteps;
+  // variables imposing gate limits if true, created on demand for each limit
+  std::map<std::size_t, logicbase::LogicTerm> gateLimits;
+  std::map<std::size_t, logicbase::LogicTerm> twoQubitGateLimits;
+  // time spent on the formulation that is not yet part of any results
+  double pendingRuntime = 0.;
+
   // all configuration options for the encoder
   Configuration config{};
 
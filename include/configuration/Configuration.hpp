@@ -6,6 +6,7 @@
 #pragma once
 
 #include "CommanderGrouping.hpp"
+#include "DataLoggingFormat.hpp"
 #include "EarlyTermination.hpp"
 #include "Encoding.hpp"
 #include "Heuristic.hpp"
@@ -20,6 +21,7 @@
 #include <nlohmann/json.hpp>
 #include <set>
 #include <string>
+#include <vector>
 
 // NOLINTNEXTLINE(clang-analyzer-optin.performance.Padding)
 struct Configuration {
@@ -39,6 +41,14 @@ struct Configuration {
   bool verbose = false;
   bool debug = false;
   std::string dataLoggingPath;
+  // format of the logged search nodes; the binary format is written by a
+  // background thread and can be memory-mapped when reading it
+  DataLoggingFormat dataLoggingFormat = DataLoggingFormat::CSV;
+  // only log the nodes taken from the priority queue (i.e., expanded and
+  // solution nodes) instead of all generated nodes
+  bool dataLoggingOnlyExpandedNodes = false;
+  // only keep the search nodes of the last layers searched (0 to keep all)
+  std::size_t dataLoggingLastLayers = 0;
 
   // map to particular subgraph of architecture (in exact mapper)
   std::set<std::uint16_t> subgraph;
@@ -91,12 +101,29 @@ struct Configuration {
   EarlyTermination earlyTermination = EarlyTermination::None;
   std::size_t earlyTerminationLimit = 0;
 
+  // number of threads evaluating the successors of a search node in parallel
+  // in the heuristic mapper (values below 2 disable parallel expansion); the
+  // result does not depend on this setting
+  std::size_t nThreadsExpansion = 1;
+
+  // configurations of the heuristic mapper run concurrently by the portfolio
+  // mapper, of which the result with the fewest gates added during routing is
+  // kept (if empty, variations of this configuration's initial layout and
+  // bidirectional routing settings are used)
+  std::vector<Configuration> portfolio;
+  // number of threads running the portfolio (0 to use one thread per
+  // configuration, limited by the available hardware threads)
+  std::size_t nThreadsPortfolio = 0;
+
   // encoding of at most and exactly one constraints in exact mapper
   Encoding encoding = Encoding::Commander;
   CommanderGrouping commanderGrouping = CommanderGrouping::Fixed3;
 
   // use qubit subsets in exact mapper
   bool useSubsets = true;
+  // number of threads solving the instances of different qubit subsets
+  // concurrently in exact mapper (values below 2 solve them one after another)
+  std::size_t nThreadsSubsets = 1;
 
   // include WCNF file in results of exact mapper
   bool includeWCNF = false;
@@ -105,6 +132,9 @@ struct Configuration {
   bool enableSwapLimits = true;
   SwapReduction swapReduction = SwapReduction::CouplingLimit;
   std::size_t swapLimit = 0;
+  // cache the SWAP distances of all permutations of each qubit subset in the
+  // architecture, where they are kept for further mapping runs
+  bool cacheSwapDistances = false;
 
   [[nodiscard]] nlohmann::basic_json<> json() const;
   [[nodiscard]] std::string toString() const { return json().dump(2); }
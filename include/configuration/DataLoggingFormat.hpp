@@ -0,0 +1,34 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+enum class DataLoggingFormat : std::uint8_t { CSV, Binary };
+
+[[maybe_unused]] static inline std::string
+toString(const DataLoggingFormat format) {
+  switch (format) {
+  case DataLoggingFormat::CSV:
+    return "csv";
+  case DataLoggingFormat::Binary:
+    return "binary";
+  }
+  return " ";
+}
+
+[[maybe_unused]] static DataLoggingFormat
+dataLoggingFormatFromString(const std::string& format) {
+  if (format == "csv" || format == "0") {
+    return DataLoggingFormat::CSV;
+  }
+  if (format == "binary" || format == "1") {
+    return DataLoggingFormat::Binary;
+  }
+  throw std::invalid_argument("Invalid data logging format value: " + format);
+}
@@ -9,7 +9,7 @@
 #include <stdexcept>
 #include <string>
 
-enum class Method : std::uint8_t { None, Exact, Heuristic };
+enum class Method : std::uint8_t { None, Exact, Heuristic, Portfolio };
 
 [[maybe_unused]] static inline std::string toString(const Method method) {
   switch (method) {
@@ -19,6 +19,8 @@ enum class Method : std::uint8_t { None, Exact, Heuristic };
     return "exact";
   case Method::Heuristic:
     return "heuristic";
+  case Method::Portfolio:
+    return "portfolio";
   }
   return " ";
 }
@@ -33,5 +35,8 @@ enum class Method : std::uint8_t { None, Exact, Heuristic };
   if (method == "heuristic" || method == "2") {
     return Method::Heuristic;
   }
+  if (method == "portfolio" || method == "3") {
+    return Method::Portfolio;
+  }
   throw std::invalid_argument("Invalid method value: " + method);
 }
@@ -10,13 +10,21 @@
 #include "configuration/Configuration.hpp"
 #include "utils.hpp"
 
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <mutex>
 #include <set>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+namespace z3 {
+class context;
+} // namespace z3
+
 using Swap = std::pair<std::uint16_t, std::uint16_t>;
 using Swaps = std::vector<Swap>;
 using QubitChoice = std::set<std::uint16_t>;
@@ -26,13 +34,95 @@ class ExactMapper : public Mapper {
   using Mapper::Mapper;
 
 protected:
+  /** qubit choices per thread that are enumerated before solving them */
+  static constexpr std::size_t QUBIT_CHOICES_PER_THREAD = 4;
+
+  /**
+   * @brief state shared by all qubit choices evaluated (possibly concurrently)
+   * in a single mapping run
+   */
+  class QubitChoiceSearch {
+  public:
+    /**
+     * @brief fewest gates added by SWAPs and direction reverses in any choice
+     * mapped so far
+     */
+    std::atomic<std::size_t> bestRoutingGates{
+        std::numeric_limits<std::size_t>::max()};
+
+    /** @brief true once a choice needs neither SWAPs nor direction reverses */
+    [[nodiscard]] bool perfect() const { return perfectFound.load(); }
+
+    /**
+     * @brief registers a solver about to be run, so that it can be interrupted
+     * by `setPerfect`
+     *
+     * @return false if a perfect choice has already been found, i.e., solving
+     * is pointless
+     */
+    bool startSolving(z3::context& ctx);
+    void stopSolving(z3::context& ctx);
+
+    /** @brief unregisters a solver registered by `startSolving` (if `search`
+     * is not nullptr) when leaving the scope, also if solving throws */
+    class SolvingGuard {
+    public:
+      SolvingGuard(QubitChoiceSearch* s, z3::context& c) : search(s), ctx(c) {}
+      SolvingGuard(const SolvingGuard&) = delete;
+      SolvingGuard(SolvingGuard&&) = delete;
+      SolvingGuard& operator=(const SolvingGuard&) = delete;
+      SolvingGuard& operator=(SolvingGuard&&) = delete;
+      ~SolvingGuard() {
+        if (search != nullptr) {
+          search->stopSolving(ctx);
+        }
+      }
+
+    private:
+      QubitChoiceSearch* search;
+      z3::context& ctx;
+    };
+
+    /** @brief marks that a perfect choice has been found and interrupts all
+     * running solvers */
+    void setPerfect();
+
+  private:
+    std::atomic<bool> perfectFound{false};
+    std::mutex mutex;
+    std::unordered_set<z3::context*> running;
+  };
+
+  /** @brief best mapping found for a single qubit choice */
+  struct QubitChoiceMapping {
+    MappingResults results{};
+    std::vector<Swaps> swaps;
+  };
+
   // inputs
   std::vector<std::size_t> reducedLayerIndices;
   std::vector<Swaps> mappingSwaps;
+
+  /**
+   * @brief determines the best mapping of the circuit to the given qubit
+   * choice (trying multiple SWAP limits depending on `config.swapReduction`)
+   *
+   * @param choice the physical qubits to map to
+   * @param inputResults results of the mapping run to initialize the results
+   * of the choice with
+   * @param mapping the best mapping found (`mapping.results.timeout` is set if
+   * there is none)
+   * @param search state shared with all other choices of this mapping run
+   */
+  void mapQubitChoice(const QubitChoice& choice,
+                      const MappingResults& inputResults,
+                      QubitChoiceMapping& mapping, QubitChoiceSearch& search);
+
   void coreMappingRoutine(const QubitChoice& qubitChoice,
                           const CouplingMap& rcm, MappingResults& choiceResults,
                           std::vector<Swaps>& swaps, std::size_t limit,
-                          std::size_t timeout);
+                          std::size_t timeout,
+                          QubitChoiceSearch* search = nullptr);
 
 public:
   void map(const Configuration& settings) override;
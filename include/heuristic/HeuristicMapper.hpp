@@ -6,14 +6,19 @@
 #include "Architecture.hpp"
 #include "DataLogger.hpp"
 #include "Mapper.hpp"
+#include "ThreadPool.hpp"
 #include "configuration/Configuration.hpp"
 #include "heuristic/UniquePriorityQueue.hpp"
 #include "utils.hpp"
 
 #include <array>
+#include <atomic>
+#include <bitset>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <set>
@@ -27,6 +32,47 @@ public:
 
   static constexpr double EFFECTIVE_BRANCH_RATE_TOLERANCE = 1e-10;
 
+  /** index marking the end of a swap sequence in `swapHistory` */
+  static constexpr std::size_t NO_SWAP =
+      std::numeric_limits<std::size_t>::max();
+
+  /** index marking a node without entries in `lookaheadPenaltyHistory` */
+  static constexpr std::size_t NO_LOOKAHEAD_PENALTIES =
+      std::numeric_limits<std::size_t>::max();
+
+  /** marks that no search has been prepared for incremental cost updates */
+  static constexpr std::size_t NO_LAYER =
+      std::numeric_limits<std::size_t>::max();
+
+  /**
+   * largest (integral) cost for which heuristic costs are summed up
+   * incrementally, all sums of such costs are exact in double precision
+   */
+  static constexpr double MAX_INCREMENTAL_COST = 1099511627776.; // 2^40
+
+  /**
+   * bitmask over the 2Q-gates of a layer, where bit `i` corresponds to the
+   * `i`-th entry (in iteration order) of the layer's `TwoQubitMultiplicity`
+   *
+   * since all layerings supported by the heuristic mapper only contain gates
+   * acting on disjoint qubit pairs, a layer never contains more than
+   * `MAX_DEVICE_QUBITS / 2` 2Q-gates
+   */
+  using TwoQubitGateMask = std::bitset<MAX_DEVICE_QUBITS>;
+
+  /**
+   * @brief entry in the swap history shared by all search nodes of a layer
+   *
+   * nodes only store the index of their last swap, all previous swaps are
+   * found by following `previous` back to `NO_SWAP`, so that nodes with a
+   * common ancestor share the swap sequence of that ancestor
+   */
+  struct SwapHistoryEntry {
+    Exchange swap;
+    /** index of the preceding swap in `swapHistory` (or `NO_SWAP`) */
+    std::size_t previous;
+  };
+
   /**
    * @brief map the circuit passed at initialization to the architecture
    *
@@ -35,16 +81,48 @@ public:
    */
   void map(const Configuration& configuration) override;
 
+  /**
+   * @brief lets subsequent mapping runs stop as soon as the elementary gates
+   * added during routing (swaps, direction reverses and teleportations) exceed
+   * the given bound, which may be lowered concurrently (e.g., by other runs
+   * of a portfolio)
+   *
+   * The bound is checked after each layer. A stopped run leaves the mapped
+   * circuit incomplete and `results.timeout` set.
+   *
+   * @param bound the bound to check against or `nullptr` to always map the
+   * whole circuit
+   */
+  void setRoutingGatesBound(const std::atomic<std::size_t>* bound) {
+    routingGatesBound = bound;
+  }
+
+  /** @brief true if the last mapping run exceeded the routing gates bound */
+  [[nodiscard]] bool stoppedAtRoutingGatesBound() const {
+    return routingGatesBoundExceeded;
+  }
+
+  /**
+   * @brief number of elementary gates added during routing in the last mapping
+   * run (before any post-mapping optimizations)
+   */
+  [[nodiscard]] std::size_t getRoutingGates() const { return routingGates; }
+
   /**
    * @brief struct representing one node in the A* search containing info about
    * swaps, mappings and costs
    */
   struct Node {
     /** gates (pair of logical qubits) currently mapped next to each other */
-    std::set<Edge> validMappedTwoQubitGates;
-    /** swaps used so far to get from the initial mapping of the current layer
-     * to the current mapping in this node */
-    std::vector<Exchange> swaps;
+    TwoQubitGateMask validMappedTwoQubitGates;
+    /** index of the last swap in `HeuristicMapper::swapHistory` used so far to
+     * get from the initial mapping of the current layer to the current mapping
+     * in this node (`NO_SWAP` if no swaps have been used yet) */
+    std::size_t lastSwap = NO_SWAP;
+    /** index of the first lookahead penalty (one per lookahead layer) of this
+     * node in `HeuristicMapper::lookaheadPenaltyHistory` (or
+     * `NO_LOOKAHEAD_PENALTIES` if they are not recorded) */
+    std::size_t lookaheadPenalties = NO_LOOKAHEAD_PENALTIES;
     /**
      * containing the logical qubit currently mapped to each physical qubit.
      * `qubits[physical_qubit] = logical_qubit`
@@ -99,14 +177,14 @@ public:
     Node(std::size_t nodeId, std::size_t parentId,
          const std::array<std::int16_t, MAX_DEVICE_QUBITS>& q,
          const std::array<std::int16_t, MAX_DEVICE_QUBITS>& loc,
-         const std::vector<Exchange>& sw = {},
-         const std::set<Edge>& valid2QGates = {},
+         const std::size_t lastSwapIndex = NO_SWAP,
+         const TwoQubitGateMask& valid2QGates = {},
          const double initCostFixed = 0,
          const double initCostFixedReversals = 0,
          const std::size_t searchDepth = 0,
          const std::size_t initSharedSwaps = 0)
-        : validMappedTwoQubitGates(valid2QGates), swaps(sw), qubits(q),
-          locations(loc), costFixed(initCostFixed),
+        : validMappedTwoQubitGates(valid2QGates), lastSwap(lastSwapIndex),
+          qubits(q), locations(loc), costFixed(initCostFixed),
           costFixedReversals(initCostFixedReversals),
           sharedSwaps(initSharedSwaps), depth(searchDepth), parent(parentId),
           id(nodeId) {}
@@ -125,7 +203,8 @@ public:
       return costFixed + costFixedReversals + lookaheadPenalty;
     }
 
-    std::ostream& print(std::ostream& out) const {
+    std::ostream& print(std::ostream& out,
+                        const std::vector<Exchange>& swaps) const {
       out << "{\n";
       out << "\t\"valid_mapping\": " << validMapping << ",\n";
       out << "\t\"cost\": {\n";
@@ -142,9 +221,79 @@ public:
     }
   };
 
+  /**
+   * @brief hash of the layout (i.e. `qubits`) of a search node
+   *
+   * together with `NodeLayoutEqual` used to identify search nodes with the
+   * same mapping in `HeuristicMapper::nodes`
+   */
+  struct NodeLayoutHash {
+    std::size_t operator()(const Node& node) const noexcept {
+      std::size_t hash = 0;
+      for (const auto q : node.qubits) {
+        hash ^= static_cast<std::uint16_t>(q) + 0x9e3779b97f4a7c15ULL +
+                (hash << 6) + (hash >> 2);
+      }
+      return hash;
+    }
+  };
+
+  /** @brief true if both search nodes represent the same mapping */
+  struct NodeLayoutEqual {
+    bool operator()(const Node& x, const Node& y) const noexcept {
+      return x.qubits == y.qubits;
+    }
+  };
+
 protected:
-  UniquePriorityQueue<Node> nodes{};
+  UniquePriorityQueue<Node, std::greater<Node>, NodeLayoutHash,
+                      NodeLayoutEqual>
+      nodes{};
+  /** swaps of all nodes generated in the current layer */
+  std::vector<SwapHistoryEntry> swapHistory{};
+
+  /**
+   * @brief 2Q-gates of a circuit layer (in iteration order of its
+   * `TwoQubitMultiplicity`) indexed by the logical qubits they act on
+   */
+  struct LayerGateIndex {
+    std::size_t layer = 0;
+    std::vector<std::pair<Edge, std::pair<std::uint16_t, std::uint16_t>>>
+        gates;
+    /** `gatesOfQubit[q]` are the indices in `gates` of all gates acting on
+     * the logical qubit `q` */
+    std::vector<std::vector<std::size_t>> gatesOfQubit;
+    /** indices in `gates` of all gates of which exactly one logical qubit is
+     * not mapped to any physical qubit */
+    std::vector<std::size_t> partiallyMappedGates;
+  };
+
+  /**
+   * if true, the heuristic cost and lookahead penalty of a node created by a
+   * swap are derived from its parent by only reevaluating the gates acting on
+   * the swapped qubits (wherever this yields exactly the same costs as the
+   * full evaluation)
+   */
+  bool incrementalCostUpdates = true;
+  /** layer for which `searchGateIndices` is set up (or `NO_LAYER`) */
+  std::size_t incrementalSearchLayer = NO_LAYER;
+  /** gate index of the current layer followed by those of its lookahead
+   * layers */
+  std::vector<LayerGateIndex> searchGateIndices{};
+  /** lookahead penalties (per lookahead layer) of all nodes generated in the
+   * current layer */
+  std::vector<double> lookaheadPenaltyHistory{};
+  /** true if all distances are integers up to `MAX_INCREMENTAL_COST`, i.e.,
+   * sum-based costs do not depend on the order of summation */
+  bool exactIncrementalSums = false;
   std::unique_ptr<DataLogger> dataLogger;
+  /** workers evaluating the successors of a node in parallel (only present if
+   * `Configuration::nThreadsExpansion` > 1) */
+  std::unique_ptr<ThreadPool> expansionPool;
+  /** see `setRoutingGatesBound` */
+  const std::atomic<std::size_t>* routingGatesBound = nullptr;
+  bool routingGatesBoundExceeded = false;
+  std::size_t routingGates = 0;
   std::size_t nextNodeId = 0;
   bool principallyAdmissibleHeur = true;
   bool tightHeur = true;
@@ -214,11 +363,35 @@ protected:
    * assumed to be empty (or at least containing only nodes compliant with the
    * current layer in their fields `costHeur` and `validMapping`)
    *
+   * the swaps of the returned node can be retrieved via `getSwaps` until the
+   * next call to `aStarMap`
+   *
    * @param layer index of the current circuit layer
    * @param reverse if true, the circuit is mapped from the end to the beginning
    */
   virtual Node aStarMap(std::size_t layer, bool reverse);
 
+  /**
+   * @brief appends a swap to the swap history
+   *
+   * @param previous index of the last swap of the node the new swap is applied
+   * to (or `NO_SWAP`)
+   * @param swap the swap to append
+   * @return index of the new swap in `swapHistory`
+   */
+  std::size_t appendSwap(const std::size_t previous, const Exchange& swap) {
+    swapHistory.push_back({swap, previous});
+    return swapHistory.size() - 1;
+  }
+
+  /**
+   * @brief reconstructs the full sequence of swaps (in order of application)
+   * leading from the root of the current search to the given node
+   *
+   * @param node search node for which to collect the swaps
+   */
+  [[nodiscard]] std::vector<Exchange> getSwaps(const Node& node) const;
+
   /**
    * @brief Get all qubits that are acted on by a relevant gate in the given
    * layer
@@ -234,7 +407,8 @@ protected:
 
   /**
    * @brief expand the given node by calling `expand_node_add_one_swap` for all
-   * possible swaps, which creates new search nodes and adds them to
+   * possible swaps (or `expandNodeAddSwapsInParallel` if parallel expansion is
+   * enabled), which creates new search nodes and adds them to
    * `HeuristicMapper::nodes`
    *
    * @param node current search node
@@ -252,6 +426,55 @@ protected:
    */
   void expandNodeAddOneSwap(const Edge& swap, Node& node, std::size_t layer);
 
+  /**
+   * @brief creates new nodes with a swap on each of the given edges, evaluates
+   * their costs using `expansionPool` and adds them to
+   * `HeuristicMapper::nodes` in the given order
+   *
+   * The search and its result are exactly the same as when calling
+   * `expandNodeAddOneSwap` for each edge in the given order.
+   *
+   * @param swaps edges on which to perform a swap
+   * @param node current search node
+   * @param layer index of current circuit layer
+   */
+  void expandNodeAddSwapsInParallel(const std::vector<Edge>& swaps,
+                                    const Node& node, std::size_t layer);
+
+  /**
+   * @brief creates a child of the given node (with a new id), to which a swap
+   * still has to be applied
+   */
+  Node createSuccessor(const Node& node) {
+    return {nextNodeId++,
+            node.id,
+            node.qubits,
+            node.locations,
+            node.lastSwap,
+            node.validMappedTwoQubitGates,
+            node.costFixed,
+            node.costFixedReversals,
+            node.depth + 1,
+            node.sharedSwaps};
+  }
+
+  /**
+   * @brief adds a fully evaluated node to `HeuristicMapper::nodes` (and the
+   * data log)
+   *
+   * @param node new search node
+   * @param layer index of current circuit layer
+   */
+  void addSuccessor(const Node& node, std::size_t layer);
+
+  /**
+   * @brief writes a search node to the data log
+   *
+   * @param node search node
+   * @param layer index of current circuit layer
+   */
+  void logSearchNode(const Node& node, std::size_t layer);
+
   /**
    * @brief applies an in-place swap of 2 virtual qubits in the given node and
    * recalculates all costs accordingly
@@ -259,8 +482,23 @@ protected:
    * @param swap physical edge on which to perform a swap
    * @param layer index of current circuit layer
    * @param node search node in which to apply the swap
+   * @param parent search node from which `node` was copied before applying the
+   * swap (if given, heuristic and lookahead costs are updated incrementally
+   * where possible)
+   */
+  void applySWAP(const Edge& swap, std::size_t layer, Node& node,
+                 const Node* parent = nullptr);
+
+  /**
+   * @brief same as `applySWAP`, but expects the swap to be already appended to
+   * `HeuristicMapper::swapHistory` (and `node.lastSwap` to point to it)
+   *
+   * Apart from filling slots reserved by `reserveLookaheadPenalties`, this
+   * only modifies the given node, i.e., it may be called for several nodes
+   * concurrently.
    */
-  void applySWAP(const Edge& swap, std::size_t layer, Node& node);
+  void applyRecordedSWAP(const Edge& swap, std::size_t layer, Node& node,
+                         const Node* parent = nullptr);
 
   /**
    * @brief applies an in-place teleportation of 2 virtual qubits in the given
@@ -328,6 +566,59 @@ protected:
    */
   void updateHeuristicCost(std::size_t layer, Node& node);
 
+  /**
+   * @brief sets up `searchGateIndices` for the A* search on the given layer
+   * and clears `lookaheadPenaltyHistory`
+   *
+   * @param layer index of current circuit layer
+   */
+  void prepareIncrementalCostUpdates(std::size_t layer);
+
+  /**
+   * @brief reserves the entries for the lookahead penalties of a node in
+   * `lookaheadPenaltyHistory` (if they are recorded for the given layer) and
+   * sets `Node::lookaheadPenalties` accordingly
+   *
+   * @param layer index of current circuit layer
+   * @param node search node without reserved entries
+   */
+  void reserveLookaheadPenalties(std::size_t layer, Node& node);
+
+  /**
+   * @brief derives `Node::costHeur`, `Node::validMapping` and
+   * `Node::lookaheadPenalty` of a node from its parent after a swap of the
+   * logical qubits `q1` and `q2`, falling back to the full calculation
+   * wherever the incremental result could differ from it
+   *
+   * @param layer index of current circuit layer
+   * @param parent search node before the swap
+   * @param q1 logical qubit (or `DEFAULT_POSITION`) on the first physical
+   * qubit of the swap before the swap
+   * @param q2 logical qubit (or `DEFAULT_POSITION`) on the second physical
+   * qubit of the swap before the swap
+   * @param node search node after the swap
+   */
+  void updateCostsIncrementally(std::size_t layer, const Node& parent,
+                                std::int16_t q1, std::int16_t q2, Node& node);
+
+  /**
+   * @brief cost of a single 2Q-gate in the heuristics
+   * `Heuristic::GateCountMaxDistance` (maximum over all gates) and
+   * `Heuristic::GateCountSumDistance` (sum over all gates)
+   *
+   * @param gate logical qubit pair
+   * @param multiplicity number of gates in both directions
+   * @param validlyMapped true if the qubit pair is mapped next to each other
+   * @param node search node for which to calculate the cost
+   *
+   * @return cost of the gate
+   */
+  [[nodiscard]] double
+  heuristicGateCountGateCost(const Edge& gate,
+                             const std::pair<std::uint16_t, std::uint16_t>&
+                                 multiplicity,
+                             bool validlyMapped, const Node& node) const;
+
   /**
    * @brief calculates the heuristic using `Heuristic::GateCountMaxDistance`
    *
@@ -418,6 +709,23 @@ protected:
    */
   double lookaheadGateCountSumDistance(std::size_t layer, Node& node);
 
+  /**
+   * @brief penalty of a single 2Q-gate in the lookahead heuristics
+   * `LookaheadHeuristic::GateCountMaxDistance` (maximum over all gates) and
+   * `LookaheadHeuristic::GateCountSumDistance` (sum over all gates)
+   *
+   * @param gate logical qubit pair
+   * @param multiplicity number of gates in both directions
+   * @param node search node for which to calculate the penalty
+   *
+   * @return lookahead penalty of the gate
+   */
+  [[nodiscard]] double
+  lookaheadGateCountGateCost(const Edge& gate,
+                             const std::pair<std::uint16_t, std::uint16_t>&
+                                 multiplicity,
+                             const Node& node) const;
+
   static double computeEffectiveBranchingRate(std::size_t nodesProcessed,
                                               const std::size_t solutionDepth) {
     // N = (b*)^d + (b*)^(d-1) + ... + (b*)^2 + b* + 1
@@ -484,9 +792,10 @@ inline bool operator>(const HeuristicMapper::Node& x,
     return xheur > yheur;
   }
 
-  if (x.validMappedTwoQubitGates.size() != y.validMappedTwoQubitGates.size()) {
-    return x.validMappedTwoQubitGates.size() <
-           y.validMappedTwoQubitGates.size();
+  const auto xvalid = x.validMappedTwoQubitGates.count();
+  const auto yvalid = y.validMappedTwoQubitGates.count();
+  if (xvalid != yvalid) {
+    return xvalid < yvalid;
   }
 
   return x < y;
@@ -0,0 +1,48 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "Mapper.hpp"
+#include "configuration/Configuration.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#pragma once
+
+/**
+ * @brief runs the heuristic mapper with several configurations concurrently
+ * and keeps the best result
+ *
+ * Each configuration is run on private copies of the circuit and the
+ * architecture. The result adding the fewest elementary gates during routing
+ * wins (ties are broken by the number of gates in the mapped circuit and then
+ * by the order of the configurations). All runs share the routing gates of
+ * the best finished run as a bound, so that runs which can no longer win are
+ * stopped early. The winner does not depend on the number of threads used.
+ */
+class PortfolioMapper : public Mapper {
+public:
+  using Mapper::Mapper; // import constructors from parent class
+
+  /** passes of iterative bidirectional routing in the default portfolio */
+  static constexpr std::size_t DEFAULT_PORTFOLIO_BIDIRECTIONAL_PASSES = 3;
+
+  /**
+   * @brief map the circuit passed at initialization to the architecture
+   *
+   * @param configuration `configuration.portfolio` lists the configurations
+   * to run (see `defaultPortfolio` if it is empty) and
+   * `configuration.nThreadsPortfolio` the number of threads to use
+   */
+  void map(const Configuration& configuration) override;
+
+  /**
+   * @brief variations of the given configuration in its initial layout and
+   * iterative bidirectional routing settings (without data logging, since all
+   * runs would log to the same path)
+   */
+  [[nodiscard]] static std::vector<Configuration>
+  defaultPortfolio(const Configuration& configuration);
+};
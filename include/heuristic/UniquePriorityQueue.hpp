@@ -4,12 +4,12 @@
 //
 
 #include <algorithm>
-#include <array>
 #include <cassert>
+#include <cstddef>
 #include <functional>
 #include <iostream>
-#include <queue>
-#include <set>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #pragma once
@@ -24,112 +24,166 @@ template <class T> struct DoNothing {
   }
 };
 
-template <class T, class Container = std::vector<T>,
-          class Compare = std::less<typename Container::value_type>>
-class OwnPriorityQueue : public std::priority_queue<T, Container, Compare> {
-public:
-  Container& getContainer() { return this->c; }
-};
-
 /**
- * Priority queue with unique (according to FuncCompare) elements of type T
- * where the sorting is based on CostCompare. If NDEBUG is *not* defined, there
- * are some assertions that help catching errors in the provided comparison
- * functions.
+ * Priority queue with unique (according to Hash and KeyEqual) elements of type
+ * T where the sorting is based on CostCompare. If NDEBUG is *not* defined,
+ * there are some assertions that help catching errors in the provided
+ * comparison functions.
+ *
+ * Internally, the queue is an indexed d-ary heap: each element is stored
+ * exactly once in a slot of `elements`, the heap only moves slot indices and
+ * a hash index over the slots allows to find an equivalent element in O(1).
+ * Replacing an element by a cheaper equivalent one is thereby a decrease-key
+ * operation in O(log n) instead of a rebuild of the whole queue.
  */
 template <class T, class CostCompare = std::greater<T>,
-          class FuncCompare = std::less<T>,
-          class CleanObsoleteElement = DoNothing<T>>
+          class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>,
+          class CleanObsoleteElement = DoNothing<T>, std::size_t Arity = 4>
 class UniquePriorityQueue {
+  static_assert(Arity >= 2, "heap arity must be at least 2");
+
 public:
-  using size_type =
-      typename OwnPriorityQueue<T, std::vector<T>, CostCompare>::size_type;
+  using size_type = std::size_t;
+
+  UniquePriorityQueue() = default;
+  // the hash index refers to `elements` of its own object and thus cannot be
+  // copied or moved along with the elements
+  UniquePriorityQueue(const UniquePriorityQueue& other)
+      : elements(other.elements), heap(other.heap), position(other.position),
+        freeSlots(other.freeSlots) {
+    rebuildIndex();
+  }
+  UniquePriorityQueue(UniquePriorityQueue&& other)
+      : elements(std::move(other.elements)), heap(std::move(other.heap)),
+        position(std::move(other.position)),
+        freeSlots(std::move(other.freeSlots)) {
+    rebuildIndex();
+    other.clear();
+  }
+  UniquePriorityQueue& operator=(const UniquePriorityQueue& other) {
+    if (this != &other) {
+      elements = other.elements;
+      heap = other.heap;
+      position = other.position;
+      freeSlots = other.freeSlots;
+      rebuildIndex();
+    }
+    return *this;
+  }
+  UniquePriorityQueue& operator=(UniquePriorityQueue&& other) {
+    if (this != &other) {
+      elements = std::move(other.elements);
+      heap = std::move(other.heap);
+      position = std::move(other.position);
+      freeSlots = std::move(other.freeSlots);
+      rebuildIndex();
+      other.clear();
+    }
+    return *this;
+  }
+  ~UniquePriorityQueue() = default;
 
   /**
    * Return true if the element was inserted into the queue.
-   * This happens if equivalent element is present or if the new element has a
-   * lower cost associated to it. False is returned if no insertion into the
+   * This happens if no equivalent element is present or if the new element has
+   * a lower cost associated to it. False is returned if no insertion into the
    * queue took place.
    */
   bool push(const T& v) {
-    const auto& insertionPair = membership.insert(v);
-    if (insertionPair.second) {
-      queue.push(v);
-    } else if (CostCompare()(*(insertionPair.first), v)) {
-      CleanObsoleteElement()(*(insertionPair.first));
-      membership.erase(insertionPair.first);
-
-      [[maybe_unused]] const auto inserted = membership.insert(v);
-      assert(inserted.second);
-
-      queue = OwnPriorityQueue<T, std::vector<T>, CostCompare>();
-      for (const auto& element : membership) {
-        queue.push(element);
-      }
-      assert(queue.size() == membership.size());
+    const auto slot = acquireSlot(v);
+    const auto [it, inserted] = index.insert(slot);
+    if (inserted) {
+      position[slot] = heap.size();
+      heap.emplace_back(slot);
+      siftUp(heap.size() - 1);
+      assert(heap.size() == index.size());
+      return true;
+    }
 
+    // an equivalent element is already present
+    releaseSlot(slot);
+    const auto existing = *it;
+    if (CostCompare()(elements[existing], v)) {
+      CleanObsoleteElement()(elements[existing]);
+      // the new element is equivalent, hence its hash (and thereby its place
+      // in the index) stays the same
+      elements[existing] = v;
+      siftUp(position[existing]);
+      assert(heap.size() == index.size());
       return true;
-    } else {
-      CleanObsoleteElement()(v);
     }
-    assert(queue.size() == membership.size());
-    return insertionPair.second;
+    CleanObsoleteElement()(v);
+    assert(heap.size() == index.size());
+    return false;
   }
 
   void pop() {
-    assert(!queue.empty() && queue.size() == membership.size());
+    assert(!heap.empty() && heap.size() == index.size());
 
-    const auto& topElement = queue.top();
-    [[maybe_unused]] const auto numberErased = membership.erase(topElement);
+    const auto topSlot = heap.front();
+    [[maybe_unused]] const auto numberErased = index.erase(topSlot);
     assert(numberErased == 1);
 
-    queue.pop();
-    assert(queue.size() == membership.size());
+    heap.front() = heap.back();
+    position[heap.front()] = 0;
+    heap.pop_back();
+    if (!heap.empty()) {
+      siftDown(0);
+    }
+    releaseSlot(topSlot);
+    assert(heap.size() == index.size());
   }
 
   const T& top() const {
-    assert(!queue.empty());
-    return queue.top();
+    assert(!heap.empty());
+    return elements[heap.front()];
   }
 
   [[nodiscard]] bool empty() const {
-    assert(queue.size() == membership.size());
-    return queue.empty();
+    assert(heap.size() == index.size());
+    return heap.empty();
   }
 
-  size_type size() const { return queue.size(); }
-
-  std::vector<T>& getContainer() { return queue.get_container(); }
+  [[nodiscard]] size_type size() const { return heap.size(); }
 
   void deleteQueue() {
-    std::vector<T>& v = getContainer();
-    for (typename std::vector<T>::const_iterator it = v.begin(); it != v.end();
-         it++) {
-      CleanObsoleteElement()(*it);
+    for (const auto slot : heap) {
+      CleanObsoleteElement()(elements[slot]);
     }
-    queue = OwnPriorityQueue<T, std::vector<T>, CostCompare>();
-    membership = std::set<T, FuncCompare>();
+    clear();
+  }
+
+  /**
+   * Remove all elements from the queue without passing them to
+   * CleanObsoleteElement. The allocated storage is kept for reuse.
+   */
+  void clear() {
+    index.clear();
+    heap.clear();
+    elements.clear();
+    position.clear();
+    freeSlots.clear();
   }
 
   // clears the queue until a certain length is reached
   void update() {
-    std::array<T, MAX_QUEUE_SIZE> tempQueue;
-    unsigned int length =
-        std::min(static_cast<int>(queue.size() * QUEUE_COPY_LENGTH_PERCENTAGE),
-                 MAX_QUEUE_COPY_LENGTH);
+    const auto length = static_cast<size_type>(
+        std::min(static_cast<int>(static_cast<double>(heap.size()) *
+                                  QUEUE_COPY_LENGTH_PERCENTAGE),
+                 MAX_QUEUE_COPY_LENGTH));
 
-    for (unsigned int i = 0; i < length; i++) {
-      tempQueue[i] = queue.top();
-      queue.pop();
-
-      lastNodeCopied = i;
+    std::vector<T> best{};
+    best.reserve(length);
+    for (size_type i = 0; i < length; ++i) {
+      best.emplace_back(top());
+      pop();
     }
     deleteQueue();
-    for (unsigned int i = 0; i < length; i++) {
-      queue.push(tempQueue[i]);
+    for (const auto& element : best) {
+      push(element);
     }
 
-    std::cout << "RESULTING SIZE: " << queue.size() << std::endl;
+    std::cout << "RESULTING SIZE: " << heap.size() << std::endl;
   }
 
   void restart(T& n) {
@@ -138,7 +192,99 @@ public:
   }
 
 private:
-  OwnPriorityQueue<T, std::vector<T>, CostCompare> queue;
-  std::set<T, FuncCompare> membership;
-  unsigned int lastNodeCopied = 0;
+  struct SlotHash {
+    const std::vector<T>* elements = nullptr;
+    std::size_t operator()(const size_type slot) const {
+      return Hash()((*elements)[slot]);
+    }
+  };
+  struct SlotEqual {
+    const std::vector<T>* elements = nullptr;
+    bool operator()(const size_type lhs, const size_type rhs) const {
+      return KeyEqual()((*elements)[lhs], (*elements)[rhs]);
+    }
+  };
+
+  /** all elements, indexed by slot; slots in `freeSlots` are unused */
+  std::vector<T> elements{};
+  /** d-ary heap of slots */
+  std::vector<size_type> heap{};
+  /** `position[slot]` is the index of `slot` in `heap` */
+  std::vector<size_type> position{};
+  std::vector<size_type> freeSlots{};
+  std::unordered_set<size_type, SlotHash, SlotEqual> index{
+      0, SlotHash{&elements}, SlotEqual{&elements}};
+
+  void rebuildIndex() {
+    index = std::unordered_set<size_type, SlotHash, SlotEqual>(
+        heap.size(), SlotHash{&elements}, SlotEqual{&elements});
+    index.insert(heap.begin(), heap.end());
+  }
+
+  size_type acquireSlot(const T& v) {
+    if (freeSlots.empty()) {
+      elements.emplace_back(v);
+      position.emplace_back(0);
+      return elements.size() - 1;
+    }
+    const auto slot = freeSlots.back();
+    freeSlots.pop_back();
+    elements[slot] = v;
+    return slot;
+  }
+
+  void releaseSlot(const size_type slot) {
+    if (slot + 1 == elements.size()) {
+      elements.pop_back();
+      position.pop_back();
+    } else {
+      freeSlots.emplace_back(slot);
+    }
+  }
+
+  /** true if the element in `lhs` has to be placed below the one in `rhs` */
+  [[nodiscard]] bool isWorse(const size_type lhs, const size_type rhs) const {
+    return CostCompare()(elements[lhs], elements[rhs]);
+  }
+
+  void siftUp(size_type pos) {
+    const auto slot = heap[pos];
+    while (pos > 0) {
+      const auto parent = (pos - 1) / Arity;
+      if (!isWorse(heap[parent], slot)) {
+        break;
+      }
+      heap[pos] = heap[parent];
+      position[heap[pos]] = pos;
+      pos = parent;
+    }
+    heap[pos] = slot;
+    position[slot] = pos;
+  }
+
+  void siftDown(size_type pos) {
+    const auto slot = heap[pos];
+    const auto n = heap.size();
+    while (true) {
+      const auto firstChild = pos * Arity + 1;
+      if (firstChild >= n) {
+        break;
+      }
+      const auto lastChild = std::min(firstChild + Arity, n);
+      auto best = firstChild;
+      for (auto child = firstChild + 1; child < lastChild; ++child) {
+        if (isWorse(heap[best], heap[child])) {
+          best = child;
+        }
+      }
+      if (!isWorse(slot, heap[best])) {
+        break;
+      }
+      heap[pos] = heap[best];
+      position[heap[pos]] = pos;
+      pos = best;
+    }
+    heap[pos] = slot;
+    position[slot] = pos;
+  }
 };
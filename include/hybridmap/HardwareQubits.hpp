@@ -10,11 +10,12 @@
 #include "hybridmap/NeutralAtomArchitecture.hpp"
 #include "hybridmap/NeutralAtomDefinitions.hpp"
 #include "hybridmap/NeutralAtomUtils.hpp"
-#include "ir/Permutation.hpp"
+#include "ir/operations/Control.hpp"
 #include "ir/operations/Operation.hpp"
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <numeric>
 #include <random>
@@ -35,11 +36,19 @@ namespace na {
  */
 class HardwareQubits {
 protected:
+  static constexpr HwQubit NO_QUBIT = std::numeric_limits<HwQubit>::max();
+
   const NeutralAtomArchitecture* arch;
-  qc::Permutation hwToCoordIdx;
+  // the coordinate of each hardware qubit and the hardware qubit at each
+  // coordinate (or NO_QUBIT if it is free)
+  std::vector<CoordIndex> hwToCoordIdx;
+  std::vector<HwQubit> coordIdxToHw;
   SymmetricMatrix<SwapDistance> swapDistances;
+  // whether the known swap distances are shortest paths between the nearby
+  // qubits (and not estimates of the architecture)
+  bool swapDistancesExact = true;
   std::map<HwQubit, HwQubits> nearbyQubits;
-  qc::Permutation initialHwPos;
+  std::vector<CoordIndex> initialHwPos;
 
   /**
    * @brief Initializes the swap distances between the hardware qubits for the
@@ -73,24 +82,49 @@ protected:
    */
   void computeSwapDistance(HwQubit q1, HwQubit q2);
 
+  /**
+   * @brief Computes the number of nearby-qubit hops from a hardware qubit to
+   * all other hardware qubits.
+   * @param q The hardware qubit to start the breadth-first search from.
+   * @return The hops per hardware qubit (maximum value if unreachable).
+   */
+  [[nodiscard]] std::vector<SwapDistance> computeHops(HwQubit q) const;
+
   /**
    * @brief Resets the swap distances between the hardware qubits.
-   * @details Used after each shuttling operation to reset the swap distances.
    */
   void resetSwapDistances();
 
+  /**
+   * @brief Resets the swap distances that might have changed by moving a
+   * hardware qubit.
+   * @details A known swap distance remains valid if a shortest path avoiding
+   * the moved qubit existed before the move and there is no shorter path via
+   * the moved qubit after the move, as only the edges of the moved qubit
+   * changed.
+   * @param movedQubit The hardware qubit that was moved.
+   * @param hopsBefore The hops from the moved qubit before the move.
+   */
+  void resetSwapDistances(HwQubit movedQubit,
+                          const std::vector<SwapDistance>& hopsBefore);
+
 public:
   // Constructors
   HardwareQubits(const NeutralAtomArchitecture& architecture,
                  InitialCoordinateMapping initialCoordinateMapping,
                  uint32_t seed)
-      : arch(&architecture), swapDistances(architecture.getNqubits()) {
+      : arch(&architecture),
+        coordIdxToHw(architecture.getNpositions(), NO_QUBIT),
+        swapDistances(architecture.getNqubits()) {
     switch (initialCoordinateMapping) {
     case Trivial:
       for (uint32_t i = 0; i < architecture.getNqubits(); ++i) {
-        hwToCoordIdx.emplace(i, i);
+        hwToCoordIdx.emplace_back(i);
       }
       initTrivialSwapDistances();
+      // the swap distances of the architecture do not consider free
+      // coordinates, hence, they are only kept until the first move
+      swapDistancesExact = false;
       break;
     case Random:
       std::vector<CoordIndex> indices(architecture.getNpositions());
@@ -101,11 +135,14 @@ public:
       std::mt19937 g(seed);
       std::shuffle(indices.begin(), indices.end(), g);
       for (uint32_t i = 0; i < architecture.getNqubits(); ++i) {
-        hwToCoordIdx.emplace(i, indices[i]);
+        hwToCoordIdx.emplace_back(indices[i]);
       }
 
       swapDistances = SymmetricMatrix(architecture.getNqubits(), -1);
     }
+    for (uint32_t i = 0; i < hwToCoordIdx.size(); ++i) {
+      coordIdxToHw[hwToCoordIdx[i]] = i;
+    }
     initNearbyQubits();
     initialHwPos = hwToCoordIdx;
   }
@@ -118,9 +155,7 @@ public:
    * @return Boolean indicating if the hardware qubit is mapped to a coordinate.
    */
   [[nodiscard]] bool isMapped(CoordIndex idx) const {
-    return !std::none_of(
-        hwToCoordIdx.begin(), hwToCoordIdx.end(),
-        [idx](const auto& pair) { return pair.second == idx; });
+    return idx < coordIdxToHw.size() && coordIdxToHw[idx] != NO_QUBIT;
   }
   /**
    * @brief Updates mapping after moving a hardware qubit to a coordinate.
@@ -136,9 +171,17 @@ public:
    * @param op The operation.
    */
   void mapToCoordIdx(qc::Operation* op) const {
-    op->setTargets(hwToCoordIdx.apply(op->getTargets()));
+    auto targets = op->getTargets();
+    for (auto& target : targets) {
+      target = getCoordIndex(target);
+    }
+    op->setTargets(targets);
     if (op->isControlled()) {
-      op->setControls(hwToCoordIdx.apply(op->getControls()));
+      qc::Controls controls;
+      for (const auto& control : op->getControls()) {
+        controls.emplace(getCoordIndex(control.qubit), control.type);
+      }
+      op->setControls(controls);
     }
   }
 
@@ -171,10 +214,8 @@ public:
    * @return The hardware qubit at the coordinate.
    */
   [[nodiscard]] HwQubit getHwQubit(CoordIndex coordIndex) const {
-    for (auto const& [hwQubit, index] : hwToCoordIdx) {
-      if (index == coordIndex) {
-        return hwQubit;
-      }
+    if (isMapped(coordIndex)) {
+      return coordIdxToHw[coordIndex];
     }
     throw std::runtime_error("There is no qubit at this coordinate " +
                              std::to_string(coordIndex));
@@ -283,8 +324,8 @@ public:
 
   [[nodiscard]] std::map<HwQubit, HwQubit> getInitHwPos() const {
     std::map<HwQubit, HwQubit> initialHwPosMap;
-    for (auto const& pair : initialHwPos) {
-      initialHwPosMap[pair.first] = pair.second;
+    for (uint32_t i = 0; i < initialHwPos.size(); ++i) {
+      initialHwPosMap[i] = initialHwPos[i];
     }
     return initialHwPosMap;
   }
@@ -24,6 +24,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -90,6 +91,10 @@ protected:
   std::deque<std::set<HwQubit>> lastBlockedQubits;
   // The last moves that have been executed
   std::deque<AtomMove> lastMoves;
+  // Cached decisions of swapGateBetter with the hardware qubits of the gate
+  // they were computed for, cleared whenever an atom is moved
+  std::unordered_map<const qc::Operation*, std::pair<HwQubits, bool>>
+      swapGateBetterCache;
   // Precomputed decay weights
   std::vector<qc::fp> decayWeights;
   // Counter variables
@@ -171,6 +176,14 @@ protected:
    * operations for
    * @return True if a swap gate is better, false if a move operation is better
    */
+  bool estimateSwapGateBetter(const qc::Operation* opPointer);
+  /**
+   * @brief Returns the decision of estimateSwapGateBetter, which is only
+   * recomputed if the gate qubits have been swapped or an atom has been moved
+   * since the last call.
+   * @param opPointer The gate to decide for
+   * @return True if a swap gate is better, false if a move operation is better
+   */
   bool swapGateBetter(const qc::Operation* opPointer);
 
   // Methods for swap gates mapping
@@ -447,6 +460,14 @@ public:
     return ss.str();
   }
 
+  /**
+   * @brief Returns the mapped circuit without converting it to OpenQASM.
+   * @return The mapped quantum circuit with abstract SWAP gates and MOVE
+   */
+  [[nodiscard]] const qc::QuantumComputation& getMappedQcObject() const {
+    return this->mappedQc;
+  }
+
   /**
    * @brief Saves the mapped quantum circuit to a file.
    * @param filename The name of the file to save the mapped quantum circuit to
@@ -467,6 +488,15 @@ public:
     return ss.str();
   }
 
+  /**
+   * @brief Returns the mapped circuit with AOD operations without converting
+   * it to OpenQASM.
+   * @return The mapped quantum circuit with native AOD operations
+   */
+  [[nodiscard]] const qc::QuantumComputation& getMappedQcAODObject() const {
+    return this->mappedQcAOD;
+  }
+
   /**
    * @brief Saves the mapped quantum circuit with AOD operations to a file.
    * @param filename The name of the file to save the mapped quantum circuit
@@ -8,14 +8,15 @@
 #include "Definitions.hpp"
 #include "hybridmap/NeutralAtomDefinitions.hpp"
 #include "hybridmap/NeutralAtomUtils.hpp"
-#include "ir/Permutation.hpp"
+#include "ir/operations/Control.hpp"
 #include "ir/operations/Operation.hpp"
 
-#include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace na {
 
@@ -25,8 +26,14 @@ namespace na {
  */
 class Mapping {
 protected:
-  // std::map<qc::Qubit, HwQubit>
-  qc::Permutation circToHw;
+  static constexpr HwQubit NO_HW_QUBIT = std::numeric_limits<HwQubit>::max();
+  static constexpr qc::Qubit NO_CIRC_QUBIT =
+      std::numeric_limits<qc::Qubit>::max();
+
+  // the hardware qubit of each circuit qubit and vice versa (or NO_HW_QUBIT
+  // and NO_CIRC_QUBIT if unassigned)
+  std::vector<HwQubit> circToHw;
+  std::vector<qc::Qubit> hwToCirc;
 
 public:
   Mapping() = default;
@@ -34,7 +41,7 @@ public:
     switch (initialMapping) {
     case Identity:
       for (size_t i = 0; i < nQubits; ++i) {
-        circToHw.emplace(i, i);
+        setCircuitQubit(static_cast<qc::Qubit>(i), static_cast<HwQubit>(i));
       }
       break;
     default:
@@ -47,16 +54,35 @@ public:
    * @param hwQubit The hardware qubit to be assigned
    */
   void setCircuitQubit(qc::Qubit qubit, HwQubit hwQubit) {
+    if (qubit >= circToHw.size()) {
+      circToHw.resize(qubit + 1, NO_HW_QUBIT);
+    }
+    if (hwQubit >= hwToCirc.size()) {
+      hwToCirc.resize(hwQubit + 1, NO_CIRC_QUBIT);
+    }
+    // the previous hardware qubit is only released if it still belongs to this
+    // circuit qubit (swaps reassign both qubits one after the other)
+    if (const auto prevHwQubit = circToHw[qubit];
+        prevHwQubit != NO_HW_QUBIT && hwToCirc[prevHwQubit] == qubit) {
+      hwToCirc[prevHwQubit] = NO_CIRC_QUBIT;
+    }
     circToHw[qubit] = hwQubit;
+    hwToCirc[hwQubit] = qubit;
   }
 
   /**
    * @brief Returns the hardware qubit assigned to the given circuit qubit.
+   * @details Throws an exception if the circuit qubit is not assigned to any
+   * hardware qubit.
    * @param qubit The circuit qubit to be queried
    * @return The hardware qubit assigned to the given circuit qubit
    */
   [[nodiscard]] HwQubit getHwQubit(qc::Qubit qubit) const {
-    return circToHw.at(qubit);
+    if (qubit < circToHw.size() && circToHw[qubit] != NO_HW_QUBIT) {
+      return circToHw[qubit];
+    }
+    throw std::runtime_error("Circuit qubit: " + std::to_string(qubit) +
+                             " not found in mapping");
   }
 
   /**
@@ -81,10 +107,8 @@ public:
    * @return The circuit qubit assigned to the given hardware qubit
    */
   [[nodiscard]] qc::Qubit getCircQubit(HwQubit qubit) const {
-    for (const auto& [circQubit, hwQubit] : circToHw) {
-      if (hwQubit == qubit) {
-        return circQubit;
-      }
+    if (isMapped(qubit)) {
+      return hwToCirc[qubit];
     }
     throw std::runtime_error("Hardware qubit: " + std::to_string(qubit) +
                              " not found in mapping");
@@ -98,9 +122,7 @@ public:
    * false otherwise
    */
   [[nodiscard]] bool isMapped(HwQubit qubit) const {
-    return std::any_of(
-        circToHw.begin(), circToHw.end(),
-        [qubit](const auto& pair) { return pair.second == qubit; });
+    return qubit < hwToCirc.size() && hwToCirc[qubit] != NO_CIRC_QUBIT;
   }
 
   /**
@@ -109,9 +131,17 @@ public:
    * @param op The operation to be converted
    */
   void mapToHwQubits(qc::Operation* op) const {
-    op->setTargets(circToHw.apply(op->getTargets()));
+    auto targets = op->getTargets();
+    for (auto& target : targets) {
+      target = getHwQubit(target);
+    }
+    op->setTargets(targets);
     if (op->isControlled()) {
-      op->setControls(circToHw.apply(op->getControls()));
+      qc::Controls controls;
+      for (const auto& control : op->getControls()) {
+        controls.emplace(getHwQubit(control.qubit), control.type);
+      }
+      op->setControls(controls);
     }
   }
 
@@ -428,7 +428,7 @@ public:
    * @param idx The index of the coordinate
    * @return The precomputed nearby coordinates for the coordinate index
    */
-  [[nodiscard]] std::set<CoordIndex>
+  [[nodiscard]] const std::set<CoordIndex>&
   getNearbyCoordinates(CoordIndex idx) const {
     return nearbyCoordinates[idx];
   }
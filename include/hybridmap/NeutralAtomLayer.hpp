@@ -29,6 +29,8 @@ protected:
   GateList gates;
   GateList mappedSingleQubitGates;
   std::vector<GateList> candidates;
+  // the iterator offset the layer has been initialized or updated with
+  std::vector<uint32_t> layerOffset;
 
   /**
    * @brief Updates the gates for the given qubits
@@ -84,6 +86,14 @@ public:
    * @param The iterator offset to start from
    */
   void initLayerOffset(const std::vector<uint32_t>& iteratorOffset = {});
+  /**
+   * @brief Moves the layer to the given iterator offset by only updating the
+   * qubits whose offset changed since the last initialization or update.
+   * @details The resulting layer is the same as the one obtained by
+   * initLayerOffset with the same offset, including the order of the gates.
+   * @param iteratorOffset The iterator offset to move to
+   */
+  void updateLayerOffset(const std::vector<uint32_t>& iteratorOffset);
   /**
    * @brief Removes the provided gates from the current layer and update the
    * the layer depending on the qubits of the gates.
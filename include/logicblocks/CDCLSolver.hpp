@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Logic.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cnflogic {
+using namespace logicbase;
+
+/**
+ * @brief small incremental CDCL SAT solver
+ *
+ * Implements the usual ingredients (two watched literals with blocking
+ * literals, first-UIP clause learning with recursive minimization,
+ * activity-based branching with phase saving, Luby restarts and removal of
+ * inactive learnt clauses, keeping those spanning at most two decision
+ * levels). Literals are given in DIMACS notation,
+ * i.e., variable `v > 0` as `v` and its negation as `-v`. Clauses may be added
+ * between calls of `solve`, which keep everything learned before.
+ */
+class CDCLSolver {
+public:
+  // makes sure that the variables `1, ..., n` exist
+  void reserveVariables(std::size_t n);
+  [[nodiscard]] std::size_t getVariableCount() const { return assigns.size(); }
+
+  // returns false if the clauses are unsatisfiable at the top level
+  bool addClause(const std::vector<int>& clause);
+
+  /**
+   * @brief solves the clauses under the given assumptions (literals that only
+   * hold for this call)
+   * @return `NDEF` if the conflict limit or the timeout was hit before the
+   * problem was decided
+   */
+  Result solve(const std::vector<int>& assumptions = {});
+
+  // limits the number of conflicts of each call of `solve` (0 = unlimited)
+  void setConflictLimit(const std::size_t limit) { conflictLimit = limit; }
+  // limits the run time of each call of `solve` (0 = unlimited)
+  void setTimeout(const std::chrono::milliseconds t) { timeout = t; }
+
+  // the model found by the last successful call of `solve`, indexed by
+  // variable (index 0 is unused)
+  [[nodiscard]] const std::vector<bool>& getModel() const { return model; }
+
+  [[nodiscard]] std::size_t getConflicts() const { return conflicts; }
+
+private:
+  using Lit = std::uint32_t;
+  using ClauseRef = std::uint32_t;
+  static constexpr ClauseRef NO_REASON = std::numeric_limits<ClauseRef>::max();
+  static constexpr std::size_t NOT_IN_HEAP =
+      std::numeric_limits<std::size_t>::max();
+  static constexpr std::int8_t UNASSIGNED = -1;
+
+  struct Clause {
+    std::vector<Lit> lits;
+    double activity = 0.;
+    // number of decision levels of the literals when the clause was learnt
+    std::size_t lbd = 0U;
+    bool learnt = false;
+    bool deleted = false;
+  };
+  // a clause watching a literal together with another of its literals, which
+  // satisfies the clause without looking at it if true
+  struct Watcher {
+    ClauseRef ref;
+    Lit blocker;
+  };
+
+  std::vector<Clause> clauses;
+  std::vector<ClauseRef> freeClauses;
+  std::vector<ClauseRef> learnts;
+  // clauses watching a literal, i.e., having it at position 0 or 1
+  std::vector<std::vector<Watcher>> watches;
+
+  std::vector<std::int8_t> assigns;
+  std::vector<bool> polarity;
+  std::vector<std::size_t> levels;
+  std::vector<ClauseRef> reasons;
+  std::vector<Lit> trail;
+  std::vector<std::size_t> trailLimits;
+  std::size_t propagated = 0U;
+
+  std::vector<double> activity;
+  double variableIncrement = 1.;
+  double clauseIncrement = 1.;
+  // binary max-heap of variables ordered by activity
+  std::vector<std::size_t> heap;
+  std::vector<std::size_t> heapIndex;
+
+  std::vector<bool> seen;
+  std::vector<Lit> analyzeStack;
+  std::vector<Lit> analyzeToClear;
+  std::vector<std::size_t> levelStamps;
+  std::size_t levelStamp = 0U;
+  std::vector<bool> model;
+  std::size_t conflicts = 0U;
+  std::size_t conflictLimit = 0U;
+  std::chrono::milliseconds timeout{0};
+  // budget of the current call of `solve`
+  std::size_t conflictBudget = 0U;
+  std::chrono::steady_clock::time_point deadline;
+  std::size_t nextTimeCheck = 0U;
+  bool budgetHit = false;
+  double maxLearnts = 0.;
+  bool ok = true;
+
+  [[nodiscard]] static Lit toLit(int literal);
+  [[nodiscard]] static std::size_t var(const Lit l) { return l >> 1U; }
+  [[nodiscard]] static Lit neg(const Lit l) { return l ^ 1U; }
+  // 1 if true, 0 if false, -1 if unassigned
+  [[nodiscard]] std::int8_t value(Lit l) const;
+  [[nodiscard]] std::size_t decisionLevel() const {
+    return trailLimits.size();
+  }
+
+  void enqueue(Lit l, ClauseRef reason);
+  ClauseRef propagate();
+  void analyze(ClauseRef conflict, std::vector<Lit>& learnt,
+               std::size_t& backtrackLevel);
+  [[nodiscard]] bool redundant(Lit p, std::uint64_t abstractLevels);
+  [[nodiscard]] std::uint64_t abstractLevel(const std::size_t v) const {
+    return std::uint64_t{1} << (levels[v] & 63U);
+  }
+  [[nodiscard]] std::size_t computeLBD(const std::vector<Lit>& lits);
+  void cancelUntil(std::size_t level);
+  ClauseRef attachClause(std::vector<Lit> lits, bool learnt);
+  void reduceLearnts();
+  [[nodiscard]] bool locked(ClauseRef ref) const;
+  Result search(std::size_t maxConflicts, const std::vector<Lit>& assumptions);
+  [[nodiscard]] bool budgetExhausted();
+
+  void bumpVariable(std::size_t v);
+  void bumpClause(Clause& c);
+  void heapInsert(std::size_t v);
+  std::size_t heapPop();
+  void heapUp(std::size_t i);
+  void heapDown(std::size_t i);
+  [[nodiscard]] bool inHeap(const std::size_t v) const {
+    return heapIndex[v] != NOT_IN_HEAP;
+  }
+};
+} // namespace cnflogic
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CDCLSolver.hpp"
+#include "Logic.hpp"
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cnflogic {
+using namespace logicbase;
+
+/**
+ * @brief logic block that encodes terms directly into clauses
+ *
+ * Boolean terms are Tseitin-encoded and bitvectors are bit-blasted into a
+ * clause buffer in DIMACS notation, without building expressions of another
+ * solver first. Sums of Boolean terms compared to constants (as used to limit
+ * gate counts) are encoded with totalizers, which are shared between all
+ * comparisons of the same sum. Other arithmetic is not supported.
+ *
+ * The clauses are solved by the built-in `CDCLSolver` or, if a solver command
+ * is given, by an external solver reading DIMACS (e.g., `kissat -q`). The
+ * command is called with the path of a DIMACS file as its last argument and
+ * has to report its result in the format of the SAT competition.
+ */
+class CNFLogicBlock : public LogicBlock {
+public:
+  explicit CNFLogicBlock(bool convert = true, std::string command = "")
+      : LogicBlock(convert), solverCommand(std::move(command)) {
+    initialize();
+  }
+  CNFLogicBlock(const CNFLogicBlock&) = delete;
+  CNFLogicBlock(CNFLogicBlock&&) = delete;
+  CNFLogicBlock& operator=(const CNFLogicBlock&) = delete;
+  CNFLogicBlock& operator=(CNFLogicBlock&&) = delete;
+  ~CNFLogicBlock() override;
+
+  void assertFormula(const LogicTerm& a) override;
+  void produceInstance() override;
+  Result solve() override;
+  Result solve(const LogicVector& assumptions) override;
+  // the instance in DIMACS format
+  std::string dumpInternalSolver() override;
+
+  void dumpDIMACS(std::ostream& os,
+                  const std::vector<int>& assumptions = {}) const;
+
+  /**
+   * @brief limits each call of `solve` to the given number of conflicts
+   * (0 = unlimited), after which it returns `NDEF`
+   * @throws std::invalid_argument if an external solver is used
+   */
+  void setConflictLimit(std::size_t limit);
+  /**
+   * @brief limits each call of `solve` to the given time (0 = unlimited),
+   * after which it returns `NDEF`
+   * @throws std::invalid_argument if an external solver is used
+   */
+  void setTimeout(std::chrono::milliseconds timeout);
+
+  [[nodiscard]] std::size_t getVariableCount() const { return nVariables; }
+  [[nodiscard]] std::size_t getClauseCount() const { return nClauses; }
+
+  // the literal encoding a Boolean term
+  int literal(const LogicTerm& a);
+  // the literals encoding the bits of a bitvector (least significant first)
+  std::vector<int> bits(const LogicTerm& a);
+
+  // value of a (non-bitvector) term under an assignment of the variables
+  [[nodiscard]] std::int64_t
+  evaluateNumber(const LogicTerm& a, const std::vector<bool>& assignment);
+  // bits of a bitvector under an assignment of the variables
+  [[nodiscard]] std::vector<bool>
+  evaluateBits(const LogicTerm& a, const std::vector<bool>& assignment);
+
+protected:
+  void internalReset() override;
+
+private:
+  static constexpr int TRUE_LITERAL = 1;
+
+  std::string solverCommand;
+  std::size_t conflictLimit = 0U;
+  std::chrono::milliseconds timeout{0};
+  std::size_t nVariables = 0U;
+  std::size_t nClauses = 0U;
+  // all clauses, each terminated by 0
+  std::vector<int> clauseBuffer;
+  // part of the buffer already passed to the built-in solver
+  std::size_t passedLiterals = 0U;
+  CDCLSolver solver;
+
+  // literals of the terms encoded so far by their id
+  std::unordered_map<std::uint64_t, std::vector<int>> encoded;
+  // totalizer outputs (`i`-th literal holds iff at least `i + 1` inputs hold)
+  // by the sorted input literals
+  std::map<std::vector<int>, std::vector<int>> counters;
+
+  // starts over with the constant true as the only variable
+  void initialize();
+  int newVariable() { return static_cast<int>(++nVariables); }
+  void addClause(const std::vector<int>& clause);
+  void assertTerm(const LogicTerm& a);
+
+  // gates with constant propagation
+  int andLiteral(std::vector<int> inputs);
+  int orLiteral(std::vector<int> inputs);
+  int xorLiteral(int a, int b);
+  int iteLiteral(int c, int t, int e);
+  int equalBits(std::vector<int> a, std::vector<int> b);
+
+  std::vector<int> encode(const LogicTerm& a);
+  std::vector<int> encodeBitwise(const LogicTerm& a);
+  int encodeComparison(const LogicTerm& a);
+  void collectSum(const LogicTerm& a, bool negative, std::vector<int>& inputs,
+                  std::int64_t& offset);
+  const std::vector<int>& counter(std::vector<int> inputs);
+  std::vector<int> totalize(const std::vector<int>& inputs, std::size_t begin,
+                            std::size_t end);
+
+  Result solveInternal(const std::vector<int>& assumptions);
+  Result solveExternal(const std::vector<int>& assumptions);
+  void setModel(std::vector<bool> assignment);
+  [[nodiscard]] static bool value(int lit, const std::vector<bool>& assignment);
+};
+} // namespace cnflogic
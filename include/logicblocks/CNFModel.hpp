@@ -0,0 +1,30 @@
+#pragma once
+
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+#include "Model.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cnflogic {
+
+using namespace logicbase;
+
+class CNFModel : public Model {
+protected:
+  // value of each variable of the clauses (index 0 is unused)
+  std::vector<bool> assignment;
+
+public:
+  explicit CNFModel(std::vector<bool> values)
+      : Model(Result::SAT), assignment(std::move(values)) {}
+  int getIntValue(const LogicTerm& a, LogicBlock* lb) override;
+  bool getBoolValue(const LogicTerm& a, LogicBlock* lb) override;
+  double getRealValue(const LogicTerm& a, LogicBlock* lb) override;
+  uint64_t getBitvectorValue(const LogicTerm& a, LogicBlock* lb) override;
+  std::vector<uint64_t> getBitvectorWords(const LogicTerm& a,
+                                          LogicBlock* lb) override;
+};
+} // namespace cnflogic
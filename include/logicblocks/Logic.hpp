@@ -265,6 +265,7 @@ inline CType getResultCType(OpType op) {
 }
 
 class LogicTerm;
+class TermTable;
 
 using LogicVector = std::vector<LogicTerm>;
 using LogicMatrix = std::vector<LogicVector>;
@@ -276,6 +277,8 @@ public:
   virtual ~Logic() = default;
   virtual uint64_t getNextId() = 0;
   virtual uint64_t getId() = 0;
+  // table for sharing structurally identical terms, if supported
+  virtual TermTable* getTermTable() { return nullptr; }
 };
 
 } // namespace logicbase
@@ -19,12 +19,14 @@ protected:
   bool convertWhenAssert;
   virtual void internalReset() = 0;
   uint64_t gid = 0U;
+  TermTable termTable;
 
 public:
   explicit LogicBlock(bool convert = false) : convertWhenAssert(convert) {}
 
   uint64_t getNextId() override { return gid++; };
   uint64_t getId() override { return gid; };
+  TermTable* getTermTable() override { return &termTable; }
 
   Model* getModel() { return model; }
 
@@ -35,6 +37,14 @@ public:
 
   virtual void produceInstance() = 0;
   virtual Result solve() = 0;
+  /**
+   * @brief solves the instance under the given assumptions (Boolean terms
+   * that only hold for this call)
+   *
+   * Formulas asserted before are kept by the solver, so that repeated calls
+   * with different assumptions profit from everything learned before.
+   */
+  virtual Result solve(const LogicVector& assumptions) = 0;
   virtual void reset();
 
   virtual std::string dumpInternalSolver() { return ""; }
@@ -2,45 +2,59 @@
 
 #include "Logic.hpp"
 
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace logicbase {
+/**
+ * @brief handle to a node of a term DAG
+ *
+ * Nodes are immutable and shared between all copies of a term, so copying a
+ * term (e.g., when combining it with others) is cheap. Composite terms of a
+ * logic block are hash-consed in the block's `TermTable`, i.e., structurally
+ * identical terms share one node and id, and thus the same conversion to the
+ * underlying solver.
+ */
 class LogicTerm {
-private:
-  Logic* lb = nullptr;
-  uint64_t id = 0;
-  uint64_t depth = 0U;
-  std::string name;
+public:
+  struct Node;
 
-  OpType opType = OpType::Variable;
-  bool value = false;
-  int iValue = 0;
-  double fValue = 0.;
-  uint64_t bvValue = 0U;
-  uint16_t bvSize = 0;
-  std::vector<LogicTerm> nodes;
-  CType cType = CType::BOOL;
+private:
+  std::shared_ptr<const Node> node;
 
+  // ids of terms without an associated logic block, which may be created
+  // concurrently by solvers running in different threads
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-  static inline uint64_t gid = 1;
+  static inline std::atomic<uint64_t> gid{1};
+
+  // creates a new node for this term and returns it for initialization
+  Node& init();
+
+  friend class TermTable;
 
 public:
-  explicit LogicTerm(bool v) : opType(OpType::Constant), value(v) {}
+  explicit LogicTerm(bool v);
+
+  explicit LogicTerm(int32_t v);
 
-  explicit LogicTerm(int32_t v)
-      : opType(OpType::Constant), iValue(v), cType(CType::INT) {}
+  explicit LogicTerm(double v);
 
-  explicit LogicTerm(double v)
-      : opType(OpType::Constant), fValue(v), cType(CType::REAL) {}
+  LogicTerm(uint64_t v, uint16_t bvs);
 
-  LogicTerm(uint64_t v, uint16_t bvs)
-      : opType(OpType::Constant), bvValue(v), bvSize(bvs),
-        cType(CType::BITVECTOR) {}
+  /**
+   * @brief bitvector constant of arbitrary width
+   * @param words the value in 64-bit words, least significant word first;
+   * missing words are zero and bits beyond `bvs` are ignored
+   * @param bvs the width of the bitvector
+   */
+  LogicTerm(const std::vector<uint64_t>& words, uint16_t bvs);
 
   explicit LogicTerm(Logic* logic = nullptr);
   explicit LogicTerm(std::string n, Logic* logic = nullptr);
@@ -122,18 +136,20 @@ public:
 
   [[nodiscard]] bool isConst() const;
 
-  [[nodiscard]] uint64_t getID() const { return id; }
-  [[nodiscard]] const std::vector<LogicTerm>& getNodes() const { return nodes; }
-  [[nodiscard]] OpType getOpType() const { return opType; }
-  [[nodiscard]] CType getCType() const { return cType; }
-  [[nodiscard]] const std::string& getName() const { return name; }
-  [[nodiscard]] Logic* getLogic() const { return lb; }
-  [[nodiscard]] uint64_t getDepth() const { return depth; }
+  [[nodiscard]] uint64_t getID() const;
+  [[nodiscard]] const std::vector<LogicTerm>& getNodes() const;
+  [[nodiscard]] OpType getOpType() const;
+  [[nodiscard]] CType getCType() const;
+  [[nodiscard]] const std::string& getName() const;
+  [[nodiscard]] Logic* getLogic() const;
+  [[nodiscard]] uint64_t getDepth() const;
 
   [[nodiscard]] bool getBoolValue() const;
   [[nodiscard]] int getIntValue() const;
   [[nodiscard]] double getFloatValue() const;
   [[nodiscard]] uint64_t getBitVectorValue() const;
+  // the value in ceil(size / 64) words, least significant word first
+  [[nodiscard]] std::vector<uint64_t> getBitVectorWords() const;
   [[nodiscard]] uint16_t getBitVectorSize() const;
 
   [[nodiscard]] bool deepEquals(const LogicTerm& other) const;
@@ -180,6 +196,62 @@ public:
   static void reset() { gid = 0; }
 };
 
+struct LogicTerm::Node {
+  Logic* lb = nullptr;
+  uint64_t id = 0;
+  uint64_t depth = 0U;
+  std::string name;
+
+  OpType opType = OpType::Variable;
+  bool value = false;
+  int iValue = 0;
+  double fValue = 0.;
+  uint64_t bvValue = 0U;
+  uint16_t bvSize = 0;
+  // all words of bitvector constants wider than 64 bits (least significant
+  // word first), `bvValue` holds the first one
+  std::vector<uint64_t> bvWords;
+  std::vector<LogicTerm> nodes;
+  CType cType = CType::BOOL;
+};
+
+inline uint64_t LogicTerm::getID() const { return node->id; }
+inline const std::vector<LogicTerm>& LogicTerm::getNodes() const {
+  return node->nodes;
+}
+inline OpType LogicTerm::getOpType() const { return node->opType; }
+inline CType LogicTerm::getCType() const { return node->cType; }
+inline const std::string& LogicTerm::getName() const { return node->name; }
+inline Logic* LogicTerm::getLogic() const { return node->lb; }
+inline uint64_t LogicTerm::getDepth() const { return node->depth; }
+
+/**
+ * @brief composite terms of a logic block by their structure
+ *
+ * Only weak references are kept, so terms no longer used anywhere are freed
+ * as before. Entries of freed terms are removed lazily.
+ */
+class TermTable {
+public:
+  // the node of an existing term with the given structure, if any
+  [[nodiscard]] std::shared_ptr<const LogicTerm::Node>
+  find(OpType op, const std::vector<LogicTerm>& nodes, CType type);
+  void insert(const std::shared_ptr<const LogicTerm::Node>& node);
+  void clear();
+  [[nodiscard]] std::size_t size() const { return entries.size(); }
+
+private:
+  static constexpr std::size_t MIN_SWEEP_SIZE = 1024U;
+
+  std::unordered_multimap<std::size_t, std::weak_ptr<const LogicTerm::Node>>
+      entries;
+  std::size_t sweepSize = MIN_SWEEP_SIZE;
+
+  [[nodiscard]] static std::size_t
+  hash(OpType op, const std::vector<LogicTerm>& nodes, CType type);
+  [[nodiscard]] static bool sameTerm(const LogicTerm& a, const LogicTerm& b);
+};
+
 struct TermHash {
   std::size_t operator()(const LogicTerm& t) const;
   bool operator()(const LogicTerm& t1, const LogicTerm& t2) const;
@@ -5,6 +5,7 @@
 #include "LogicTerm.hpp"
 
 #include <cstdint>
+#include <vector>
 
 namespace logicbase {
 class Model {
@@ -20,5 +21,9 @@ public:
   virtual bool getBoolValue(const LogicTerm& a, LogicBlock* lb) = 0;
   virtual double getRealValue(const LogicTerm& a, LogicBlock* lb) = 0;
   virtual uint64_t getBitvectorValue(const LogicTerm& a, LogicBlock* lb) = 0;
+  // value of a bitvector of arbitrary width in 64-bit words, least significant
+  // word first
+  virtual std::vector<uint64_t> getBitvectorWords(const LogicTerm& a,
+                                                  LogicBlock* lb) = 0;
 };
 } // namespace logicbase
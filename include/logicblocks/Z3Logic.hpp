@@ -78,6 +78,7 @@ public:
   void assertFormula(const LogicTerm& a) override;
   void produceInstance() override;
   Result solve() override;
+  Result solve(const LogicVector& assumptions) override;
   std::string dumpInternalSolver() override {
     std::stringstream ss;
     ss << (*solver);
@@ -109,6 +110,7 @@ public:
   void assertFormula(const LogicTerm& a) override;
   void produceInstance() override;
   Result solve() override;
+  Result solve(const LogicVector& assumptions) override;
 
   bool makeMinimize() override;
   bool makeMaximize() override;
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 #include <z3++.h>
 
 namespace z3logic {
@@ -25,5 +26,7 @@ public:
   bool getBoolValue(const LogicTerm& a, LogicBlock* lb) override;
   double getRealValue(const LogicTerm& a, LogicBlock* lb) override;
   uint64_t getBitvectorValue(const LogicTerm& a, LogicBlock* lb) override;
+  std::vector<uint64_t> getBitvectorWords(const LogicTerm& a,
+                                          LogicBlock* lb) override;
 };
 } // namespace z3logic
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "CNFLogic.hpp"
 #include "LogicBlock.hpp"
 #include "Z3Logic.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -104,4 +107,31 @@ getZ3LogicOptimizer(bool& success, bool convertWhenAssert,
   return std::make_unique<z3logic::Z3LogicOptimizer>(c, opt, convertWhenAssert);
 }
 
+/**
+ * @brief creates a logic block for the CNF backend
+ * @details Of the parameters, only `timeout` (in milliseconds) and
+ * `max_conflicts` are supported, and only by the built-in solver.
+ * @throws std::invalid_argument for parameters that cannot be honored
+ */
+inline std::unique_ptr<LogicBlock>
+getCNFLogicBlock(bool& success, bool convertWhenAssert,
+                 const std::string& solverCommand = "",
+                 const Params& params = Params()) {
+  auto lb = std::make_unique<cnflogic::CNFLogicBlock>(convertWhenAssert,
+                                                      solverCommand);
+  for (const auto& param : params.getParams()) {
+    if (param.type == ParamType::UINT && param.name == "timeout") {
+      lb->setTimeout(std::chrono::milliseconds(param.uivalue));
+    } else if (param.type == ParamType::UINT &&
+               param.name == "max_conflicts") {
+      lb->setConflictLimit(param.uivalue);
+    } else {
+      throw std::invalid_argument("Unsupported parameter " + param.name +
+                                  " for the CNF backend");
+    }
+  }
+  success = true;
+  return lb;
+}
+
 } // namespace logicutil
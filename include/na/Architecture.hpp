@@ -15,6 +15,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <istream>
+#include <limits>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -141,6 +142,20 @@ protected:
       0; // sufficient radius to avoid Rydberg interaction
   std::vector<Zone> initialZones; // the zones where the atoms are initially
 
+  // Spatial index of the sites, rebuilt whenever the sites change. Rows and
+  // columns are the distinct y- and x-coordinates of the sites, respectively,
+  // and sites within a row (column) are sorted by x (y) and then by index.
+  std::vector<Zone> siteZones; // the first zone containing each site
+  std::vector<Number> allRows;
+  std::vector<std::vector<Index>> rowSites;
+  std::vector<Number> allCols;
+  std::vector<std::vector<Index>> colSites;
+  // the sites, rows, columns, and sites per row of each zone
+  std::vector<std::vector<Index>> zoneSites;
+  std::vector<std::vector<Number>> zoneRows;
+  std::vector<std::vector<Number>> zoneCols;
+  std::vector<std::vector<std::vector<Index>>> zoneRowSites;
+
 public:
   Architecture() = default;
 
@@ -215,9 +230,7 @@ public:
     return (getPositionOfSite(j) - getPositionOfSite(i)).length();
   }
   [[nodiscard]] auto getZoneAt(const Point& p) const -> Zone;
-  [[nodiscard]] auto getZoneOfSite(const Index& i) const -> Zone {
-    return getZoneAt(getPositionOfSite(i));
-  }
+  [[nodiscard]] auto getZoneOfSite(const Index& i) const -> Zone;
   /// Checks whether the gate can be applied at all.
   [[nodiscard]] auto isAllowedLocally(const FullOpType& t) const -> bool;
   /// Checks whether the gate can be applied (locally) in this zone.
@@ -231,8 +244,8 @@ public:
   [[nodiscard]] auto isAllowedGlobally(const FullOpType& t,
                                        const Zone& zone) const -> bool;
   [[nodiscard]] auto getNrowsInZone(const Zone& z) const -> Index;
-  [[nodiscard]] auto
-  getSitesInRow(const Zone& z, const Index& row) const -> std::vector<Index>;
+  [[nodiscard]] auto getSitesInRow(const Zone& z, const Index& row) const
+      -> const std::vector<Index>&;
   [[nodiscard]] auto getNearestXLeft(const Number& x, const Zone& z,
                                      bool proper = true) const -> Number;
   [[nodiscard]] auto getNearestXRight(const Number& x, const Zone& z,
@@ -274,14 +287,40 @@ public:
   getNearestSiteDownRight(const Point& p, bool proper = false,
                           bool sameZone = false) const -> std::optional<Index>;
   [[nodiscard]] auto getSiteAt(const Point& p) const -> std::optional<Index>;
-  [[nodiscard]] auto getSitesInZone(const Zone& z) const -> std::vector<Index>;
+  [[nodiscard]] auto
+  getSitesInZone(const Zone& z) const -> const std::vector<Index>&;
   [[nodiscard]] auto
   withConfig(const Configuration& config) const -> Architecture;
   [[nodiscard]] auto getPositionOffsetBy(const Point& p, const Number& rows,
                                          const Number& cols) const -> Point;
 
 private:
-  [[nodiscard]] auto getRowsInZone(const Zone& z) const -> std::vector<Number>;
-  [[nodiscard]] auto getColsInZone(const Zone& z) const -> std::vector<Number>;
+  static constexpr Zone NO_ZONE = std::numeric_limits<Zone>::max();
+
+  /// Builds the spatial index of the sites used by the queries above.
+  auto buildSiteIndex() -> void;
+  [[nodiscard]] auto
+  getRowsInZone(const Zone& z) const -> const std::vector<Number>&;
+  [[nodiscard]] auto
+  getColsInZone(const Zone& z) const -> const std::vector<Number>&;
+  /**
+   * @brief Returns the nearest site in the row (if `horizontal`) or column of
+   * `p` that comes after (if `forward`) or before `p`.
+   */
+  [[nodiscard]] auto getNearestSiteInLine(const Point& p, bool horizontal,
+                                          bool forward, bool proper,
+                                          bool sameZone) const
+      -> std::optional<Index>;
+  /**
+   * @brief Returns the site closest to `p` in the quadrant to the right (if
+   * `right`) or left and below (if `down`) or above `p`.
+   * @details Rows are visited by increasing distance to `p` and the search
+   * stops as soon as a row (or site within a row) is farther away than the
+   * nearest site found so far. Ties are broken by the smaller index.
+   */
+  [[nodiscard]] auto getNearestSiteInQuadrant(const Point& p, bool right,
+                                              bool down, bool proper,
+                                              bool sameZone) const
+      -> std::optional<Index>;
 };
 } // namespace na
@@ -24,6 +24,50 @@ using Edge = std::pair<std::uint16_t, std::uint16_t>;
 using CouplingMap = std::set<Edge>;
 using QubitSubset = std::set<std::uint16_t>;
 
+/**
+ * @brief square matrix of doubles stored contiguously in row-major order
+ *
+ * used for the distance tables queried in the inner loops of the mappers,
+ * where the double indirection (and bounds checks) of `Matrix` is avoidable
+ */
+class DistanceTable {
+public:
+  DistanceTable() = default;
+  explicit DistanceTable(const std::size_t n, const double value = 0.)
+      : dim(n), values(n * n, value) {}
+  explicit DistanceTable(const Matrix& matrix);
+
+  /** @brief number of rows (and columns) */
+  [[nodiscard]] std::size_t size() const { return dim; }
+  [[nodiscard]] bool empty() const { return dim == 0; }
+  void clear() {
+    dim = 0;
+    values.clear();
+  }
+
+  [[nodiscard]] double operator()(const std::size_t from,
+                                  const std::size_t to) const {
+    return values[from * dim + to];
+  }
+  [[nodiscard]] double& operator()(const std::size_t from,
+                                   const std::size_t to) {
+    return values[from * dim + to];
+  }
+
+  [[nodiscard]] const double* row(const std::size_t from) const {
+    return values.data() + from * dim;
+  }
+  [[nodiscard]] double* row(const std::size_t from) {
+    return values.data() + from * dim;
+  }
+
+  [[nodiscard]] Matrix toMatrix() const;
+
+private:
+  std::size_t dim = 0;
+  std::vector<double> values{};
+};
+
 struct Exchange {
   Exchange(const std::uint16_t f, const std::uint16_t s, const qc::OpType type)
       : first(f), second(s),
@@ -50,6 +94,86 @@ public:
   }
 };
 
+/**
+ * @brief immutable adjacency structure of a coupling map
+ *
+ * The directed edges are stored in a dense bit matrix (row-major) for constant
+ * time edge queries. Additionally, the undirected neighborhood of each qubit is
+ * stored in compressed sparse row (CSR) format for cache-friendly iteration.
+ */
+class CouplingGraph {
+public:
+  /** @brief contiguous range of the neighbors of a qubit in increasing order */
+  class NeighborRange {
+  public:
+    NeighborRange(const std::uint16_t* first, const std::uint16_t* last)
+        : firstNeighbor(first), lastNeighbor(last) {}
+    [[nodiscard]] const std::uint16_t* begin() const { return firstNeighbor; }
+    [[nodiscard]] const std::uint16_t* end() const { return lastNeighbor; }
+    [[nodiscard]] std::size_t size() const {
+      return static_cast<std::size_t>(lastNeighbor - firstNeighbor);
+    }
+    [[nodiscard]] bool empty() const { return firstNeighbor == lastNeighbor; }
+
+  private:
+    const std::uint16_t* firstNeighbor;
+    const std::uint16_t* lastNeighbor;
+  };
+
+  CouplingGraph() = default;
+  /**
+   * @param nQubits number of qubits (increased if the coupling map contains
+   * larger qubit indices)
+   * @param couplingMap coupling map specifying all edges in the architecture
+   */
+  CouplingGraph(std::uint16_t nQubits, const CouplingMap& couplingMap);
+
+  [[nodiscard]] std::uint16_t getNqubits() const { return nqubits; }
+
+  /** @brief true if the directed edge `from -> to` exists */
+  [[nodiscard]] bool hasEdge(const std::uint16_t from,
+                             const std::uint16_t to) const {
+    if (from >= nqubits || to >= nqubits) {
+      return false;
+    }
+    const auto bit = static_cast<std::size_t>(from) * nqubits + to;
+    return ((adjacency[bit / 64] >> (bit % 64)) & 1U) != 0U;
+  }
+
+  /** @brief true if an edge between both qubits exists in either direction */
+  [[nodiscard]] bool isConnected(const std::uint16_t q1,
+                                 const std::uint16_t q2) const {
+    return hasEdge(q1, q2) || hasEdge(q2, q1);
+  }
+
+  /** @brief true if edges between both qubits exist in both directions */
+  [[nodiscard]] bool isBidirectional(const std::uint16_t q1,
+                                     const std::uint16_t q2) const {
+    return hasEdge(q1, q2) && hasEdge(q2, q1);
+  }
+
+  /**
+   * @brief all qubits connected to the given qubit by an edge in either
+   * direction
+   */
+  [[nodiscard]] NeighborRange neighbors(const std::uint16_t q) const {
+    if (q >= nqubits) {
+      return {nullptr, nullptr};
+    }
+    return {neighborList.data() + neighborOffsets[q],
+            neighborList.data() + neighborOffsets[q + 1U]};
+  }
+
+protected:
+  std::uint16_t nqubits = 0;
+  /** bit `from * nqubits + to` is set if the edge `from -> to` exists */
+  std::vector<std::uint64_t> adjacency{};
+  /** neighbors of qubit `q` are `neighborList[neighborOffsets[q]]` up to
+   * (excluding) `neighborList[neighborOffsets[q + 1]]` */
+  std::vector<std::size_t> neighborOffsets{};
+  std::vector<std::uint16_t> neighborList{};
+};
+
 class Dijkstra {
 public:
   struct Node {
@@ -77,6 +201,17 @@ public:
    */
   static void buildTable(const CouplingMap& couplingMap, Matrix& distanceTable,
                          const Matrix& edgeWeights);
+  /**
+   * @brief builds a distance table as above from the adjacency structure of
+   * the architecture
+   *
+   * @param couplingGraph adjacency structure of the architecture
+   * @param distanceTable target table
+   * @param edgeWeights matrix containing costs for swapping any two, connected
+   * qubits
+   */
+  static void buildTable(const CouplingGraph& couplingGraph,
+                         Matrix& distanceTable, const Matrix& edgeWeights);
   /**
    * @brief builds a 3d matrix containing the distance tables giving the minimal
    * distances between 2 qubit when upto k edges can be skipped.
@@ -99,6 +234,12 @@ public:
   static void buildEdgeSkipTable(const CouplingMap& couplingMap,
                                  std::vector<Matrix>& distanceTables,
                                  const Matrix& edgeWeights);
+  /**
+   * @brief builds the distance tables as above in flat storage
+   */
+  static void buildEdgeSkipTable(const CouplingMap& couplingMap,
+                                 std::vector<DistanceTable>& distanceTables,
+                                 const Matrix& edgeWeights);
   /**
    * @brief builds a distance table containing the minimal costs for moving
    * logical qubits from one physical qubit to another (along the cheapest path)
@@ -117,14 +258,18 @@ public:
                                        const CouplingMap& couplingMap,
                                        double reversalCost,
                                        Matrix& edgeSkipDistanceTable);
+  /**
+   * @brief builds the distance table as above in flat storage
+   */
+  static void buildSingleEdgeSkipTable(const DistanceTable& distanceTable,
+                                       const CouplingMap& couplingMap,
+                                       double reversalCost,
+                                       DistanceTable& edgeSkipDistanceTable);
 
 protected:
-  static void dijkstra(const CouplingMap& couplingMap, std::vector<Node>& nodes,
-                       std::uint16_t start, const Matrix& edgeWeights);
-
-  struct NodeComparator {
-    bool operator()(const Node* x, const Node* y) { return x->cost > y->cost; }
-  };
+  static void dijkstra(const CouplingGraph& couplingGraph,
+                       std::vector<Node>& nodes, std::uint16_t start,
+                       const Matrix& edgeWeights);
 };
 
 inline bool operator<(const Dijkstra::Node& x, const Dijkstra::Node& y) {
@@ -190,10 +335,6 @@ std::string printPi(std::vector<std::uint16_t>& pi);
 void dfs(std::uint16_t current, std::set<std::uint16_t>& visited,
          const CouplingMap& rcm);
 
-using filter_function = std::function<bool(const QubitSubset&)>;
-std::vector<QubitSubset> subsets(const QubitSubset& input, std::size_t size,
-                                 const filter_function& filter = nullptr);
-
 void parseLine(const std::string& line, char separator,
                const std::set<char>& escapeChars,
                const std::set<char>& ignoredChars,
@@ -9,14 +9,18 @@
 #include "utils.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <functional>
 #include <istream>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
-#include <queue>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -195,12 +199,23 @@ Architecture::Architecture(const std::uint16_t nQ, const CouplingMap& cm,
 }
 
 void Architecture::createDistanceTable() {
+  couplingGraph = CouplingGraph(nqubits, couplingMap);
+  if (swapDistanceCache != nullptr) {
+    // cached distances are only valid for the previous coupling map
+    swapDistanceCache = std::make_shared<SwapDistanceCache>();
+  }
+  teleportationDistanceCache.clear();
+  teleportationDistances = nullptr;
+  if (!currentTeleportations.empty()) {
+    teleportationDistances =
+        createTeleportationDistanceTable(currentTeleportations);
+  }
   isBidirectional = true;
   isUnidirectional = true;
   Matrix edgeWeights(nqubits, std::vector<double>(
                                   nqubits, std::numeric_limits<double>::max()));
   for (const auto& edge : couplingMap) {
-    if (couplingMap.find({edge.second, edge.first}) == couplingMap.end()) {
+    if (!couplingGraph.hasEdge(edge.second, edge.first)) {
       // unidirectional edge
       isBidirectional = false;
       edgeWeights.at(edge.second).at(edge.first) = COST_UNIDIRECTIONAL_SWAP;
@@ -213,16 +228,19 @@ void Architecture::createDistanceTable() {
   }
 
   Matrix simpleDistanceTable{};
-  Dijkstra::buildTable(couplingMap, simpleDistanceTable, edgeWeights);
-  Dijkstra::buildSingleEdgeSkipTable(simpleDistanceTable, couplingMap, 0.,
-                                     distanceTable);
+  Dijkstra::buildTable(couplingGraph, simpleDistanceTable, edgeWeights);
+  const DistanceTable simpleDistances(simpleDistanceTable);
+  Dijkstra::buildSingleEdgeSkipTable(simpleDistances, couplingMap, 0.,
+                                     distances);
   if (bidirectional()) {
-    distanceTableReversals = distanceTable;
+    distancesReversals = distances;
   } else {
-    Dijkstra::buildSingleEdgeSkipTable(simpleDistanceTable, couplingMap,
+    Dijkstra::buildSingleEdgeSkipTable(simpleDistances, couplingMap,
                                        COST_DIRECTION_REVERSE,
-                                       distanceTableReversals);
+                                       distancesReversals);
   }
+  distanceTable = distances.toMatrix();
+  distanceTableReversals = distancesReversals.toMatrix();
 }
 
 void Architecture::createFidelityTable() {
@@ -254,7 +272,7 @@ void Architecture::createFidelityTable() {
           1.0 - properties.getTwoQubitErrorRate(first, second);
       twoQubitFidelityCosts[first][second] =
           -std::log2(fidelityTable[first][second]);
-      if (couplingMap.find({second, first}) == couplingMap.end()) {
+      if (!couplingGraph.hasEdge(second, first)) {
         // CNOT reversal (unidirectional edge q1 -> q2):
         // CX(q2,q1) = H(q1) H(q2) CX(q1,q2) H(q1) H(q2)
         twoQubitFidelityCosts[second][first] =
@@ -284,192 +302,322 @@ void Architecture::createFidelityTable() {
     }
   }
 
-  fidelityDistanceTables.clear();
-  Dijkstra::buildEdgeSkipTable(couplingMap, fidelityDistanceTables,
+  Dijkstra::buildEdgeSkipTable(couplingMap, fidelityDistances,
                                swapFidelityCosts);
+  fidelityDistanceTables.clear();
+  fidelityDistanceTables.reserve(fidelityDistances.size());
+  for (const auto& table : fidelityDistances) {
+    fidelityDistanceTables.emplace_back(table.toMatrix());
+  }
 }
 
-std::uint64_t
-Architecture::minimumNumberOfSwaps(std::vector<std::uint16_t>& permutation,
-                                   std::int64_t limit) {
-  const bool tryToAbortEarly = (limit != -1);
+namespace {
+/** most qubits a permutation handled by `minimumNumberOfSwaps` may contain */
+constexpr std::size_t MAX_PERMUTATION_QUBITS = 16;
+/** most qubits for which all permutations are stored in the swap cache */
+constexpr std::size_t MAX_CACHED_PERMUTATION_QUBITS = 10;
+
+/**
+ * @brief permutation of at most `MAX_PERMUTATION_QUBITS` qubits, the index
+ * of the qubit at position `i` is stored in bits `[4i, 4i + 4)`
+ */
+using PackedPermutation = std::uint64_t;
+
+PackedPermutation
+swapPositions(const PackedPermutation permutation,
+              const std::pair<std::uint8_t, std::uint8_t>& positions) {
+  const auto shift1 = 4U * positions.first;
+  const auto shift2 = 4U * positions.second;
+  const auto diff = ((permutation >> shift1) ^ (permutation >> shift2)) & 0xFU;
+  return permutation ^ ((diff << shift1) | (diff << shift2));
+}
 
+/** @brief input of `minimumNumberOfSwaps` in terms of positions */
+struct PermutationProblem {
+  QubitSubsetMask qubits{};
+  /** true if the permutation is small enough to be cached and `qubits`
+   * represents all of its qubits */
+  bool cacheable = true;
+  std::size_t size = 0;
+  PackedPermutation identity = 0;
+  PackedPermutation goal = 0;
+  /** possible SWAPs and the positions they exchange */
+  std::vector<Edge> swaps{};
+  std::vector<std::pair<std::uint8_t, std::uint8_t>> positions{};
+};
+
+PermutationProblem
+createPermutationProblem(const std::vector<std::uint16_t>& permutation,
+                         const CouplingMap& couplingMap,
+                         const bool bidirectional) {
   // consolidate used qubits
-  QubitSubset qubits{};
-  for (const auto& q : permutation) {
-    qubits.insert(q);
+  const QubitSubset qubitSet(permutation.begin(), permutation.end());
+  if (qubitSet.size() != permutation.size()) {
+    throw std::runtime_error(
+        "Architecture::minimumNumberOfSwaps: permutation contains duplicates");
   }
-
-  // create map for goal permutation
-  std::unordered_map<std::uint16_t, std::uint16_t> goalPermutation{};
-  std::uint16_t count = 0U;
-  bool identity = true;
-  for (const auto q : qubits) {
-    goalPermutation.emplace(q, permutation.at(count));
-    if (q != permutation.at(count)) {
-      identity = false;
-    }
-    ++count;
+  if (permutation.size() > MAX_PERMUTATION_QUBITS) {
+    throw QMAPException("Architecture::minimumNumberOfSwaps: permutations of "
+                        "more than " +
+                        std::to_string(MAX_PERMUTATION_QUBITS) +
+                        " qubits are not supported");
   }
+  const std::vector<std::uint16_t> qubits(qubitSet.begin(), qubitSet.end());
+  const auto position = [&qubits](const std::uint16_t q) {
+    return static_cast<std::uint8_t>(
+        std::lower_bound(qubits.begin(), qubits.end(), q) - qubits.begin());
+  };
 
-  if (identity) {
-    return 0U;
+  PermutationProblem problem{};
+  problem.size = qubits.size();
+  problem.cacheable = qubits.size() <= MAX_CACHED_PERMUTATION_QUBITS;
+  for (std::size_t i = 0; i < qubits.size(); ++i) {
+    if (qubits[i] < MAX_DEVICE_QUBITS) {
+      problem.qubits.set(qubits[i]);
+    } else {
+      problem.cacheable = false;
+    }
+    problem.identity |= static_cast<PackedPermutation>(i) << (4U * i);
+    problem.goal |= static_cast<PackedPermutation>(position(permutation[i]))
+                    << (4U * i);
   }
 
   // create selection of swap possibilities
   std::set<Edge> possibleSwaps{};
   for (const auto& edge : couplingMap) {
     // only use SWAPs between qubits that are currently being considered
-    if (qubits.count(edge.first) == 0 || qubits.count(edge.second) == 0) {
+    if (qubitSet.count(edge.first) == 0 || qubitSet.count(edge.second) == 0) {
       continue;
     }
 
-    if (!bidirectional() ||
+    if (!bidirectional ||
         (possibleSwaps.count(edge) == 0 &&
          possibleSwaps.count({edge.second, edge.first}) == 0)) {
       possibleSwaps.emplace(edge);
     }
   }
+  for (const auto& swap : possibleSwaps) {
+    problem.swaps.emplace_back(swap);
+    problem.positions.emplace_back(position(swap.first),
+                                   position(swap.second));
+  }
+  return problem;
+}
 
-  Node start{};
-  // start with identity permutation
-  for (std::uint16_t i = 0U; i < nqubits; ++i) {
-    start.permutation.emplace(i, i);
+/**
+ * @brief shortest sequence of SWAPs (as indices into `problem.swaps`)
+ * transforming the identity into the goal permutation
+ *
+ * Breadth-first searches from both permutations alternately expand the
+ * smaller frontier by one level until they meet. The first permutation
+ * reached by both searches lies on a shortest sequence.
+ *
+ * @return std::nullopt if more than `limit` SWAPs are required
+ */
+std::optional<std::vector<std::size_t>>
+findSwapSequence(const PermutationProblem& problem, const std::uint64_t limit) {
+  if (problem.identity == problem.goal) {
+    return std::vector<std::size_t>{};
   }
 
-  auto priority = [](const Node& x, const Node& y) {
-    return x.nswaps > y.nswaps;
+  /** permutation a permutation was reached from and the SWAP applied */
+  struct Step {
+    PackedPermutation predecessor;
+    std::size_t swap;
+  };
+  std::array<std::unordered_map<PackedPermutation, Step>, 2> visited{};
+  std::array<std::vector<PackedPermutation>, 2> frontiers{};
+  std::array<std::uint64_t, 2> depths{};
+  const std::array<PackedPermutation, 2> roots{problem.identity, problem.goal};
+  for (std::size_t side = 0; side < 2; ++side) {
+    visited[side].emplace(roots[side], Step{roots[side], 0});
+    frontiers[side].emplace_back(roots[side]);
+  }
+
+  const auto sequenceThrough = [&](const PackedPermutation meeting) {
+    std::vector<std::size_t> sequence{};
+    for (auto p = meeting; p != problem.identity;) {
+      const auto& step = visited[0].at(p);
+      sequence.emplace_back(step.swap);
+      p = step.predecessor;
+    }
+    std::reverse(sequence.begin(), sequence.end());
+    for (auto p = meeting; p != problem.goal;) {
+      const auto& step = visited[1].at(p);
+      sequence.emplace_back(step.swap);
+      p = step.predecessor;
+    }
+    return sequence;
   };
-  std::priority_queue<Node, std::vector<Node>, decltype(priority)> queue(
-      priority);
-  queue.push(start);
-
-  while (!queue.empty()) {
-    const Node current = queue.top();
-    queue.pop();
-
-    // in case no solution has been found using less than `limit` swaps, search
-    // can be aborted
-    if (tryToAbortEarly &&
-        current.nswaps >= static_cast<std::uint64_t>(limit)) {
-      return static_cast<std::uint64_t>(limit + 1U);
-    }
-
-    for (const auto& swap : possibleSwaps) {
-      Node next = current;
-
-      // apply and insert swap
-      std::swap(next.permutation.at(swap.first),
-                next.permutation.at(swap.second));
-      next.nswaps++;
-      bool done = true;
-      for (const auto& assignment : goalPermutation) {
-        if (next.permutation.at(assignment.first) != assignment.second) {
-          done = false;
-          break;
-        }
-      }
 
-      if (done) {
-        return next.nswaps;
+  while (!frontiers[0].empty() && !frontiers[1].empty() &&
+         depths[0] + depths[1] < limit) {
+    const std::size_t side = frontiers[0].size() <= frontiers[1].size() ? 0 : 1;
+    auto& own = visited[side];
+    const auto& other = visited[1 - side];
+    std::vector<PackedPermutation> next{};
+    for (const auto p : frontiers[side]) {
+      for (std::size_t s = 0; s < problem.positions.size(); ++s) {
+        const auto successor = swapPositions(p, problem.positions[s]);
+        if (!own.emplace(successor, Step{p, s}).second) {
+          continue;
+        }
+        if (other.count(successor) != 0U) {
+          return sequenceThrough(successor);
+        }
+        next.emplace_back(successor);
       }
-      queue.push(next);
     }
+    frontiers[side] = std::move(next);
+    ++depths[side];
   }
-
-  return start.nswaps;
+  return std::nullopt;
 }
 
-void Architecture::minimumNumberOfSwaps(std::vector<std::uint16_t>& permutation,
-                                        std::vector<Edge>& swaps) {
-  // consolidate used qubits
-  QubitSubset qubits{};
-  for (const auto& q : permutation) {
-    qubits.insert(q);
+/** @brief SWAP distances of all permutations reachable from the identity */
+void computeSwapDistances(
+    const PermutationProblem& problem,
+    std::unordered_map<PackedPermutation, std::uint8_t>& distances) {
+  distances.emplace(problem.identity, 0U);
+  std::vector<PackedPermutation> frontier{problem.identity};
+  for (std::uint8_t depth = 1; !frontier.empty(); ++depth) {
+    std::vector<PackedPermutation> next{};
+    for (const auto p : frontier) {
+      for (const auto& positions : problem.positions) {
+        const auto successor = swapPositions(p, positions);
+        if (distances.emplace(successor, depth).second) {
+          next.emplace_back(successor);
+        }
+      }
+    }
+    frontier = std::move(next);
   }
+}
+} // namespace
 
-  if (qubits.size() != permutation.size()) {
-    throw std::runtime_error(
-        "Architecture::minimumNumberOfSwaps: permutation contains duplicates");
+void Architecture::setSwapDistanceCaching(const bool enable) {
+  if (!enable) {
+    swapDistanceCache.reset();
+  } else if (swapDistanceCache == nullptr) {
+    swapDistanceCache = std::make_shared<SwapDistanceCache>();
   }
+}
 
-  // create map for goal permutation
-  std::unordered_map<std::uint16_t, std::uint16_t> goalPermutation{};
-  std::uint16_t count = 0;
-  bool identity = true;
-  for (const auto q : qubits) {
-    goalPermutation.emplace(q, permutation.at(count));
-    if (q != permutation.at(count)) {
-      identity = false;
-    }
-    ++count;
+std::size_t Architecture::getSwapDistanceCacheSize() const {
+  const auto cache = swapDistanceCache;
+  if (cache == nullptr) {
+    return 0U;
   }
+  const std::lock_guard lock(cache->mutex);
+  return cache->tables.size();
+}
 
-  if (identity) {
-    return;
+std::shared_ptr<const Architecture::SwapDistanceTable>
+Architecture::getSwapDistanceTable(
+    const QubitSubsetMask& qubits,
+    const std::function<void(std::unordered_map<std::uint64_t, std::uint8_t>&)>&
+        compute) const {
+  // keep the cache alive even if caching is disabled concurrently
+  const auto cache = swapDistanceCache;
+  if (cache == nullptr) {
+    return nullptr;
   }
-
-  // create selection of swap possibilities
-  std::set<Edge> possibleSwaps{};
-  for (const auto& edge : couplingMap) {
-    // only use SWAPs between qubits that are currently being considered
-    if (qubits.count(edge.first) == 0 || qubits.count(edge.second) == 0) {
-      continue;
+  std::shared_ptr<SwapDistanceTable> table{};
+  {
+    const std::lock_guard lock(cache->mutex);
+    auto& entry = cache->tables[qubits];
+    if (entry == nullptr) {
+      entry = std::make_shared<SwapDistanceTable>();
     }
+    table = entry;
+  }
+  std::call_once(table->computed, [&] { compute(table->distances); });
+  return table;
+}
 
-    if (!bidirectional() ||
-        (possibleSwaps.count(edge) == 0 &&
-         possibleSwaps.count({edge.second, edge.first}) == 0)) {
-      possibleSwaps.emplace(edge);
+std::uint64_t
+Architecture::minimumNumberOfSwaps(std::vector<std::uint16_t>& permutation,
+                                   const std::int64_t limit) {
+  const auto problem =
+      createPermutationProblem(permutation, couplingMap, bidirectional());
+  const auto maxSwaps = limit == -1 ? std::numeric_limits<std::uint64_t>::max()
+                                    : static_cast<std::uint64_t>(limit);
+
+  std::optional<std::uint64_t> nswaps{};
+  const auto table =
+      problem.cacheable
+          ? getSwapDistanceTable(problem.qubits,
+                                 [&problem](auto& distances) {
+                                   computeSwapDistances(problem, distances);
+                                 })
+          : nullptr;
+  if (table != nullptr) {
+    if (const auto it = table->distances.find(problem.goal);
+        it != table->distances.end()) {
+      nswaps = it->second;
     }
+  } else if (const auto sequence = findSwapSequence(problem, maxSwaps);
+             sequence.has_value()) {
+    nswaps = sequence->size();
   }
 
-  swaps.clear();
-  Node start{};
-
-  // start with identity permutation
-  for (std::uint16_t i = 0U; i < nqubits; ++i) {
-    start.permutation.emplace(i, i);
+  // in case no solution has been found using at most `limit` swaps, more are
+  // required
+  if (limit != -1 && (!nswaps.has_value() || *nswaps > maxSwaps)) {
+    return maxSwaps + 1U;
   }
+  if (!nswaps.has_value()) {
+    throw QMAPException("Architecture::minimumNumberOfSwaps: permutation "
+                        "cannot be realized by SWAPs on the architecture");
+  }
+  return *nswaps;
+}
 
-  auto priority = [](const Node& x, const Node& y) {
-    return x.swaps.size() > y.swaps.size();
-  };
-  std::priority_queue<Node, std::vector<Node>, decltype(priority)> queue(
-      priority);
-  queue.push(start);
-
-  while (!queue.empty()) {
-    const Node current = queue.top();
-    queue.pop();
-
-    for (const auto& swap : possibleSwaps) {
-      Node next = current;
-      // continue if the same swap was applied earlier
-      if (!next.swaps.empty() && next.swaps.back() == swap) {
-        continue;
-      }
-
-      // apply and insert swap
-      std::swap(next.permutation.at(swap.first),
-                next.permutation.at(swap.second));
-      next.swaps.emplace_back(swap);
-      next.nswaps++;
-
-      bool done = true;
-      for (const auto& assignment : goalPermutation) {
-        if (next.permutation.at(assignment.first) != assignment.second) {
-          done = false;
-          break;
+void Architecture::minimumNumberOfSwaps(std::vector<std::uint16_t>& permutation,
+                                        std::vector<Edge>& swaps) {
+  const auto problem =
+      createPermutationProblem(permutation, couplingMap, bidirectional());
+
+  std::optional<std::vector<std::size_t>> sequence{};
+  const auto table =
+      problem.cacheable
+          ? getSwapDistanceTable(problem.qubits,
+                                 [&problem](auto& distances) {
+                                   computeSwapDistances(problem, distances);
+                                 })
+          : nullptr;
+  if (table != nullptr) {
+    const auto& distances = table->distances;
+    if (const auto it = distances.find(problem.goal); it != distances.end()) {
+      // descend from the goal to the identity along decreasing distances
+      sequence.emplace();
+      auto current = problem.goal;
+      for (auto distance = it->second; distance > 0U; --distance) {
+        for (std::size_t s = 0; s < problem.positions.size(); ++s) {
+          const auto predecessor =
+              swapPositions(current, problem.positions[s]);
+          const auto jt = distances.find(predecessor);
+          if (jt != distances.end() && jt->second + 1U == distance) {
+            sequence->emplace_back(s);
+            current = predecessor;
+            break;
+          }
         }
       }
-
-      if (done) {
-        swaps = next.swaps;
-        return;
-      }
-      queue.push(next);
+      std::reverse(sequence->begin(), sequence->end());
     }
+  } else {
+    sequence =
+        findSwapSequence(problem, std::numeric_limits<std::uint64_t>::max());
+  }
+
+  if (!sequence.has_value()) {
+    throw QMAPException("Architecture::minimumNumberOfSwaps: permutation "
+                        "cannot be realized by SWAPs on the architecture");
+  }
+  swaps.clear();
+  for (const auto s : *sequence) {
+    swaps.emplace_back(problem.swaps[s]);
   }
 }
 
@@ -482,74 +630,86 @@ Architecture::getCouplingLimit(const QubitSubset& qubitChoice) const {
   return findCouplingLimit(getCouplingMap(), getNqubits(), qubitChoice);
 }
 
-std::uint64_t Architecture::bfs(const std::uint16_t start,
-                                const std::uint16_t goal,
-                                const std::set<Edge>& teleportations) const {
-  std::queue<std::vector<int>> queue;
-  std::vector<int> v;
-  v.push_back(start);
-  queue.push(v);
-  std::vector<std::vector<int>> solutions;
-
-  std::uint64_t length = 0U;
-  std::set<int> successors;
-  while (!queue.empty()) {
-    v = queue.front();
-    queue.pop();
-    const int current = v[v.size() - 1];
-    if (current == goal) {
-      length = v.size();
-      solutions.push_back(v);
-      break;
-    }
-    successors.clear();
-    for (const auto& edge : getCouplingMap()) {
-      if (edge.first == current && !contains(v, edge.second)) {
-        successors.insert(edge.second);
-      }
-      if (edge.second == current && !contains(v, edge.first)) {
-        successors.insert(edge.first);
-      }
-    }
-    for (const auto& edge : teleportations) {
-      if (edge.first == current && !contains(v, edge.second)) {
-        successors.insert(edge.second);
-      }
-      if (edge.second == current && !contains(v, edge.first)) {
-        successors.insert(edge.first); // was v2 but this is probably wrong
-      }
-    }
+void Architecture::setCurrentTeleportations(
+    const CouplingMap& teleportations) {
+  // tables of this many edge sets are kept before starting over
+  constexpr std::size_t maxCachedTeleportations = 64U;
+  if (teleportations == currentTeleportations) {
+    return;
+  }
+  currentTeleportations = teleportations;
+  if (teleportations.empty()) {
+    teleportationDistances = nullptr;
+    return;
+  }
+  if (const auto it = teleportationDistanceCache.find(teleportations);
+      it != teleportationDistanceCache.end()) {
+    teleportationDistances = it->second;
+    return;
+  }
+  if (teleportationDistanceCache.size() >= maxCachedTeleportations) {
+    teleportationDistanceCache.clear();
+  }
+  teleportationDistances = createTeleportationDistanceTable(teleportations);
+  teleportationDistanceCache.emplace(teleportations, teleportationDistances);
+}
 
-    for (const auto successor : successors) {
-      auto v2 = v;
-      v2.push_back(successor);
-      queue.push(v2);
-    }
+std::shared_ptr<const DistanceTable>
+Architecture::createTeleportationDistanceTable(
+    const CouplingMap& teleportations) const {
+  // undirected neighbors in the coupling map extended by the teleportations
+  std::vector<std::vector<std::uint16_t>> neighbors(nqubits);
+  for (std::uint16_t q = 0; q < nqubits; ++q) {
+    const auto range = couplingGraph.neighbors(q);
+    neighbors[q].assign(range.begin(), range.end());
   }
-  while (!queue.empty() && queue.front().size() == length) {
-    if (queue.front()[queue.front().size() - 1] == goal) {
-      solutions.push_back(queue.front());
-    }
-    queue.pop();
+  for (const auto& [q1, q2] : teleportations) {
+    neighbors.at(q1).emplace_back(q2);
+    neighbors.at(q2).emplace_back(q1);
   }
 
-  // TODO: different weight if this contains a teleportation
-  for (const auto& s : solutions) {
-    for (std::size_t j = 0; j < s.size() - 1; j++) {
-      const Edge e{s[j], s[j + 1]};
-      if (getCouplingMap().find(e) != getCouplingMap().end()) {
-        return (length - 2) * 7;
+  auto table = std::make_shared<DistanceTable>(nqubits);
+  // number of qubits on the shortest paths from the start (0 if unreachable)
+  std::vector<std::uint64_t> length(nqubits);
+  // true if one of the shortest paths uses an edge of the coupling map in its
+  // direction
+  std::vector<bool> directed(nqubits);
+  std::vector<std::uint16_t> queue{};
+  queue.reserve(nqubits);
+  for (std::uint16_t start = 0; start < nqubits; ++start) {
+    std::fill(length.begin(), length.end(), 0U);
+    std::fill(directed.begin(), directed.end(), false);
+    queue.clear();
+    length[start] = 1U;
+    queue.emplace_back(start);
+    // all predecessors of a qubit on shortest paths are dequeued before it
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+      const auto current = queue[i];
+      for (const auto successor : neighbors[current]) {
+        if (length[successor] == 0U) {
+          length[successor] = length[current] + 1U;
+          queue.emplace_back(successor);
+        }
+        if (length[successor] == length[current] + 1U &&
+            (directed[current] || couplingGraph.hasEdge(current, successor))) {
+          directed[successor] = true;
+        }
       }
     }
-  }
 
-  if (length == 2 &&
-      getCouplingMap().find(Edge{start, goal}) == getCouplingMap().end() &&
-      getCouplingMap().find(Edge{goal, start}) == getCouplingMap().end()) {
-    return 7;
+    // TODO: different weight if this contains a teleportation
+    for (std::uint16_t goal = 0; goal < nqubits; ++goal) {
+      std::uint64_t distance = (length[goal] - 2U) * 7U + 4U;
+      if (directed[goal]) {
+        distance = (length[goal] - 2U) * 7U;
+      } else if (length[goal] == 2U &&
+                 !isEdgeConnected({start, goal}, false)) {
+        distance = 7U;
+      }
+      (*table)(start, goal) = static_cast<double>(distance);
+    }
   }
-
-  return (length - 2) * 7 + 4;
+  return table;
 }
 
 std::size_t Architecture::findCouplingLimit(const CouplingMap& cm,
@@ -640,6 +800,70 @@ void Architecture::findCouplingLimit(
   visited[node] = false;
 }
 
+namespace {
+/** @brief orders subsets by the value of their bitmasks */
+bool isSmallerSubsetMask(const QubitSubsetMask& lhs,
+                         const QubitSubsetMask& rhs) {
+  for (auto q = MAX_DEVICE_QUBITS; q > 0; --q) {
+    if (lhs.test(q - 1U) != rhs.test(q - 1U)) {
+      return rhs.test(q - 1U);
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief state of the ESU enumeration of connected subsets starting from a
+ * single root qubit
+ */
+struct ConnectedSubsetEnumeration {
+  const CouplingGraph& graph;
+  const std::function<bool(const QubitSubsetMask&)>& callback;
+  std::size_t subsetSize;
+  /** smallest qubit of all subsets enumerated from this state */
+  std::uint16_t root = 0;
+  QubitSubsetMask subset{};
+  /** qubits in `subset` or adjacent to any of them */
+  QubitSubsetMask neighborhood{};
+
+  /**
+   * @brief enumerates all connected subsets containing `subset` that can be
+   * reached by adding qubits from `extension` (and their exclusive neighbors)
+   *
+   * @return false if the enumeration was stopped by the callback
+   */
+  bool extend(std::vector<std::uint16_t> extension, const std::size_t size) {
+    if (size == subsetSize) {
+      return callback(subset);
+    }
+    while (!extension.empty()) {
+      const auto q = extension.back();
+      extension.pop_back();
+
+      // only neighbors exclusive to `q` extend the subset further, all others
+      // are already contained in `extension` or have been dealt with before
+      auto nextExtension = extension;
+      const auto previousNeighborhood = neighborhood;
+      for (const auto neighbor : graph.neighbors(q)) {
+        if (neighbor > root && !neighborhood.test(neighbor)) {
+          nextExtension.emplace_back(neighbor);
+        }
+        neighborhood.set(neighbor);
+      }
+
+      subset.set(q);
+      const bool proceed = extend(std::move(nextExtension), size + 1);
+      subset.reset(q);
+      neighborhood = previousNeighborhood;
+      if (!proceed) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+} // namespace
+
 void Architecture::getHighestFidelityCouplingMap(
     std::uint16_t subsetSize, CouplingMap& reducedMap) const {
   if (!isArchitectureAvailable()) {
@@ -653,38 +877,96 @@ void Architecture::getHighestFidelityCouplingMap(
   }
 
   double bestFidelity = std::numeric_limits<double>::lowest();
-  auto allConnectedSubsets = getAllConnectedSubsets(subsetSize);
-
-  for (const auto& qubitChoice : allConnectedSubsets) {
+  QubitSubsetMask bestSubset{};
+  forEachConnectedSubset(subsetSize, [&](const QubitSubsetMask& subset) {
+    const auto qubitChoice = toQubitSubset(subset);
     CouplingMap map{};
     getReducedCouplingMap(qubitChoice, map);
     const auto currentFidelity =
         getAverageArchitectureFidelity(map, qubitChoice, properties);
-    if (currentFidelity > bestFidelity) {
+    // among equally good subsets, the one with the smallest bitmask is chosen
+    // (independent of the enumeration order)
+    if (currentFidelity > bestFidelity ||
+        (currentFidelity == bestFidelity &&
+         isSmallerSubsetMask(subset, bestSubset))) {
       reducedMap = map;
       bestFidelity = currentFidelity;
+      bestSubset = subset;
     }
-  }
+    return true;
+  });
 }
 std::vector<QubitSubset>
 Architecture::getAllConnectedSubsets(std::uint16_t subsetSize) const {
+  std::vector<QubitSubsetMask> masks{};
+  forEachConnectedSubset(subsetSize, [&masks](const QubitSubsetMask& subset) {
+    masks.emplace_back(subset);
+    return true;
+  });
+  std::sort(masks.begin(), masks.end(), isSmallerSubsetMask);
+
   std::vector<QubitSubset> result{};
+  result.reserve(masks.size());
+  for (const auto& mask : masks) {
+    result.emplace_back(toQubitSubset(mask));
+  }
+  return result;
+}
+
+bool Architecture::forEachConnectedSubset(
+    const std::uint16_t subsetSize,
+    const std::function<bool(const QubitSubsetMask&)>& callback) const {
   if (!isArchitectureAvailable() || nqubits == subsetSize) {
-    result.emplace_back(getQubitSet());
-  } else if (nqubits < subsetSize) {
+    QubitSubsetMask all{};
+    for (std::uint16_t q = 0; q < nqubits; ++q) {
+      all.set(q);
+    }
+    return callback(all);
+  }
+  if (nqubits < subsetSize) {
     throw QMAPException("Architecture too small!");
-  } else {
-    auto filter = [&](const QubitSubset& subset) {
-      CouplingMap cm = {};
-      Architecture::getReducedCouplingMap(subset, cm);
-      return isConnected(subset, cm);
-    };
-    for (const auto& subset : subsets(getQubitSet(), subsetSize, filter)) {
-      result.emplace_back(subset);
+  }
+  if (subsetSize == 0) {
+    throw QMAPException("Size of qubit subsets must be greater than 0!");
+  }
+  if (nqubits > MAX_DEVICE_QUBITS ||
+      couplingGraph.getNqubits() > MAX_DEVICE_QUBITS) {
+    throw QMAPException("Enumerating qubit subsets is only supported for up "
+                        "to " +
+                        std::to_string(MAX_DEVICE_QUBITS) + " qubits!");
+  }
+
+  ConnectedSubsetEnumeration enumeration{couplingGraph, callback, subsetSize};
+  for (std::uint16_t root = 0; root < nqubits; ++root) {
+    enumeration.root = root;
+    enumeration.subset.reset();
+    enumeration.subset.set(root);
+    enumeration.neighborhood.reset();
+    enumeration.neighborhood.set(root);
+    std::vector<std::uint16_t> extension{};
+    for (const auto neighbor : couplingGraph.neighbors(root)) {
+      enumeration.neighborhood.set(neighbor);
+      if (neighbor > root) {
+        extension.emplace_back(neighbor);
+      }
+    }
+    if (!enumeration.extend(std::move(extension), 1U)) {
+      return false;
     }
   }
-  return result;
+  return true;
 }
+
+QubitSubset Architecture::toQubitSubset(const QubitSubsetMask& mask) {
+  QubitSubset subset{};
+  for (std::uint16_t q = 0; q < MAX_DEVICE_QUBITS; ++q) {
+    if (mask.test(q)) {
+      subset.emplace_hint(subset.end(), q);
+    }
+  }
+  return subset;
+}
+
 void Architecture::getReducedCouplingMaps(
     std::uint16_t subsetSize, std::vector<CouplingMap>& couplingMaps) const {
   couplingMaps.clear();
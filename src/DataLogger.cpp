@@ -12,19 +12,38 @@
 #include "utils.hpp"
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
+namespace {
+constexpr std::array<char, 8> NODES_MAGIC = {'Q', 'M', 'A', 'P',
+                                             'N', 'O', 'D', 'E'};
+constexpr std::array<char, 8> SWAPS_MAGIC = {'Q', 'M', 'A', 'P',
+                                             'S', 'W', 'A', 'P'};
+
+template <class T>
+void writeValue(char* destination, const std::size_t position, const T value) {
+  std::memcpy(destination + position, &value, sizeof(T));
+}
+} // namespace
+
+DataLogger::~DataLogger() { stopWriter(); }
+
 void DataLogger::initLog() {
   if (dataLoggingPath.back() != '/') {
     dataLoggingPath += '/';
@@ -81,18 +100,58 @@ void DataLogger::openNewLayer(std::size_t layerIndex) {
     return;
   }
 
+  if (format == DataLoggingFormat::Binary) {
+    // the files are created by the writer thread
+    for (std::size_t i = finalizedLayers.size(); i <= layerIndex; ++i) {
+      finalizedLayers.emplace_back(false);
+      loggedSwaps.emplace_back(0U);
+      loggedLayers.emplace_back(i);
+    }
+    removeOldLayers();
+    return;
+  }
   for (std::size_t i = searchNodesLogFiles.size(); i <= layerIndex; ++i) {
-    searchNodesLogFiles.emplace_back(dataLoggingPath + "nodes_layer_" +
-                                     std::to_string(i) + ".csv");
+    searchNodesLogFiles.emplace_back(nodesFileName(i));
     if (!searchNodesLogFiles.at(i).good()) {
       deactivated = true;
       std::cerr << "[data-logging] Error opening file: " << dataLoggingPath
                 << "layer_" << i << ".json" << '\n';
       return;
     }
+    loggedLayers.emplace_back(i);
   }
+  removeOldLayers();
 };
 
+void DataLogger::removeOldLayers() {
+  if (keptLayers == 0) {
+    return;
+  }
+  while (loggedLayers.size() > keptLayers) {
+    const auto layer = loggedLayers.front();
+    loggedLayers.pop_front();
+    // the layer description is of no use without the search nodes
+    std::error_code ec;
+    std::filesystem::remove(
+        dataLoggingPath + "layer_" + std::to_string(layer) + ".json", ec);
+    if (format == DataLoggingFormat::Binary) {
+      flushBlocks();
+      auto block = std::make_unique<LogBlock>();
+      block->kind = LogBlock::Kind::RemoveLayer;
+      block->layer = layer;
+      pushBlock(std::move(block));
+      continue;
+    }
+    searchNodesLogFiles.at(layer).close();
+    std::filesystem::remove(nodesFileName(layer), ec);
+  }
+}
+
+std::string DataLogger::nodesFileName(const std::size_t layer) const {
+  return dataLoggingPath + "nodes_layer_" + std::to_string(layer) +
+         (format == DataLoggingFormat::Binary ? ".bin" : ".csv");
+}
+
 void DataLogger::logFinalizeLayer(
     std::size_t layerIndex, const qc::CompoundOperation& ops,
     const std::vector<std::uint16_t>& singleQubitMultiplicity,
@@ -108,12 +167,26 @@ void DataLogger::logFinalizeLayer(
     return;
   }
 
-  if (!searchNodesLogFiles.at(layerIndex).is_open()) {
-    std::cerr << "[data-logging] Error: layer " << layerIndex
-              << " has already been finalized" << '\n';
-    return;
+  if (format == DataLoggingFormat::Binary) {
+    if (finalizedLayers.at(layerIndex)) {
+      std::cerr << "[data-logging] Error: layer " << layerIndex
+                << " has already been finalized" << '\n';
+      return;
+    }
+    finalizedLayers.at(layerIndex) = true;
+    flushBlocks();
+    auto block = std::make_unique<LogBlock>();
+    block->kind = LogBlock::Kind::CloseLayer;
+    block->layer = layerIndex;
+    pushBlock(std::move(block));
+  } else {
+    if (!searchNodesLogFiles.at(layerIndex).is_open()) {
+      std::cerr << "[data-logging] Error: layer " << layerIndex
+                << " has already been finalized" << '\n';
+      return;
+    }
+    searchNodesLogFiles.at(layerIndex).close();
   }
-  searchNodesLogFiles.at(layerIndex).close();
 
   auto of = std::ofstream(dataLoggingPath + "layer_" +
                           std::to_string(layerIndex) + ".json");
@@ -174,27 +247,45 @@ void DataLogger::splitLayer() {
     return;
   }
 
-  const std::size_t layerIndex = searchNodesLogFiles.size() - 1;
-  if (searchNodesLogFiles.at(layerIndex).is_open()) {
+  const auto binary = format == DataLoggingFormat::Binary;
+  const std::size_t layerIndex =
+      (binary ? finalizedLayers.size() : searchNodesLogFiles.size()) - 1;
+  if (binary ? !finalizedLayers.at(layerIndex)
+             : searchNodesLogFiles.at(layerIndex).is_open()) {
     std::cerr << "[data-logging] Error: layer " << layerIndex
               << " has not been finalized before splitting" << '\n';
     return;
   }
-  searchNodesLogFiles.pop_back();
+  if (binary) {
+    finalizedLayers.pop_back();
+    loggedSwaps.pop_back();
+    // the files have to be closed before renaming them
+    waitForWriter();
+  } else {
+    searchNodesLogFiles.pop_back();
+  }
+  if (!loggedLayers.empty() && loggedLayers.back() == layerIndex) {
+    loggedLayers.pop_back();
+  }
+  const std::string extension = binary ? ".bin" : ".csv";
+  const auto layerName = "layer_" + std::to_string(layerIndex);
   std::size_t splitIndex = 0;
-  while (std::filesystem::exists(dataLoggingPath + "nodes_layer_" +
-                                 std::to_string(layerIndex) + ".presplit-" +
-                                 std::to_string(splitIndex) + ".csv")) {
+  while (std::filesystem::exists(dataLoggingPath + "nodes_" + layerName +
+                                 ".presplit-" + std::to_string(splitIndex) +
+                                 extension)) {
     ++splitIndex;
   }
+  const auto presplit = ".presplit-" + std::to_string(splitIndex);
   std::filesystem::rename(
-      dataLoggingPath + "nodes_layer_" + std::to_string(layerIndex) + ".csv",
-      dataLoggingPath + "nodes_layer_" + std::to_string(layerIndex) +
-          ".presplit-" + std::to_string(splitIndex) + ".csv");
-  std::filesystem::rename(
-      dataLoggingPath + "layer_" + std::to_string(layerIndex) + ".json",
-      dataLoggingPath + "layer_" + std::to_string(layerIndex) + ".presplit-" +
-          std::to_string(splitIndex) + ".json");
+      dataLoggingPath + "nodes_" + layerName + extension,
+      dataLoggingPath + "nodes_" + layerName + presplit + extension);
+  if (binary) {
+    std::filesystem::rename(
+        dataLoggingPath + "swaps_" + layerName + extension,
+        dataLoggingPath + "swaps_" + layerName + presplit + extension);
+  }
+  std::filesystem::rename(dataLoggingPath + layerName + ".json",
+                          dataLoggingPath + layerName + presplit + ".json");
 }
 
 void DataLogger::logSearchNode(
@@ -206,6 +297,12 @@ void DataLogger::logSearchNode(
     return;
   }
 
+  if (format == DataLoggingFormat::Binary) {
+    logSearchNodeBinary(layerIndex, nodeId, parentId, costFixed, costHeur,
+                        lookaheadPenalty, qubits, validMapping, swaps, depth);
+    return;
+  }
+
   if (layerIndex >= searchNodesLogFiles.size()) {
     openNewLayer(layerIndex);
   }
@@ -270,7 +367,205 @@ void DataLogger::logMappingResult(MappingResults& result) {
   of.close();
 };
 
+void DataLogger::logSearchNodeBinary(
+    const std::size_t layerIndex, const std::size_t nodeId,
+    const std::size_t parentId, const double costFixed, const double costHeur,
+    const double lookaheadPenalty,
+    const std::array<std::int16_t, MAX_DEVICE_QUBITS>& qubits,
+    const bool validMapping, const std::vector<Exchange>& swaps,
+    const std::size_t depth) {
+  if (writerFailed.load(std::memory_order_relaxed)) {
+    deactivated = true;
+    return;
+  }
+  if (layerIndex >= finalizedLayers.size()) {
+    openNewLayer(layerIndex);
+  }
+  if (finalizedLayers.at(layerIndex)) {
+    deactivated = true;
+    std::cerr << "[data-logging] Error: layer " << layerIndex
+              << " has already been finalized" << '\n';
+    return;
+  }
+  if (layerIndex != currentLayer) {
+    flushBlocks();
+    currentLayer = layerIndex;
+  }
+  for (auto* block : {&nodeBlock, &swapBlock}) {
+    if (*block == nullptr) {
+      *block = std::make_unique<LogBlock>();
+      (*block)->kind = block == &nodeBlock ? LogBlock::Kind::Nodes
+                                           : LogBlock::Kind::Swaps;
+      (*block)->layer = layerIndex;
+      (*block)->data.reserve(BLOCK_SIZE + nodeRecordSize);
+    }
+  }
+
+  auto& nodeData = nodeBlock->data;
+  const auto nodeOffset = nodeData.size();
+  nodeData.resize(nodeOffset + nodeRecordSize);
+  auto* record = nodeData.data() + nodeOffset;
+  writeValue(record, 0, static_cast<std::uint64_t>(nodeId));
+  writeValue(record, 8, static_cast<std::uint64_t>(parentId));
+  writeValue(record, 16, costFixed);
+  writeValue(record, 24, costHeur);
+  writeValue(record, 32, lookaheadPenalty);
+  writeValue(record, 40, static_cast<std::uint64_t>(depth));
+  writeValue(record, 48, loggedSwaps.at(layerIndex));
+  writeValue(record, 56, static_cast<std::uint32_t>(swaps.size()));
+  writeValue(record, 60, static_cast<std::uint8_t>(validMapping));
+  std::memcpy(record + BINARY_NODE_HEADER_SIZE, qubits.data(),
+              sizeof(std::int16_t) * nqubits);
+
+  auto& swapData = swapBlock->data;
+  const auto swapOffset = swapData.size();
+  swapData.resize(swapOffset + BINARY_SWAP_SIZE * swaps.size());
+  for (std::size_t i = 0; i < swaps.size(); ++i) {
+    auto* swapRecord = swapData.data() + swapOffset + BINARY_SWAP_SIZE * i;
+    writeValue(swapRecord, 0, swaps[i].first);
+    writeValue(swapRecord, 2, swaps[i].second);
+    writeValue(swapRecord, 4, swaps[i].middleAncilla);
+    writeValue(swapRecord, 6, static_cast<std::uint8_t>(swaps[i].op));
+  }
+  loggedSwaps.at(layerIndex) += swaps.size();
+
+  if (nodeData.size() >= BLOCK_SIZE) {
+    pushBlock(std::move(nodeBlock));
+  }
+  if (swapData.size() >= BLOCK_SIZE) {
+    pushBlock(std::move(swapBlock));
+  }
+}
+
+void DataLogger::pushBlock(std::unique_ptr<LogBlock> block) {
+  const auto tail = ringTail.load(std::memory_order_relaxed);
+  while (tail - ringHead.load(std::memory_order_acquire) >= RING_SIZE) {
+    std::this_thread::yield();
+  }
+  ring.at(tail % RING_SIZE) = std::move(block);
+  ringTail.store(tail + 1, std::memory_order_release);
+}
+
+void DataLogger::flushBlocks() {
+  if (nodeBlock != nullptr && !nodeBlock->data.empty()) {
+    pushBlock(std::move(nodeBlock));
+  }
+  if (swapBlock != nullptr && !swapBlock->data.empty()) {
+    pushBlock(std::move(swapBlock));
+  }
+}
+
+void DataLogger::waitForWriter() const {
+  const auto tail = ringTail.load(std::memory_order_relaxed);
+  while (ringHead.load(std::memory_order_acquire) != tail) {
+    std::this_thread::yield();
+  }
+}
+
+void DataLogger::stopWriter() {
+  if (!writer.joinable()) {
+    return;
+  }
+  flushBlocks();
+  writerStopped.store(true, std::memory_order_release);
+  writer.join();
+}
+
+void DataLogger::writeBlocks() {
+  std::map<std::size_t, std::ofstream> nodeFiles;
+  std::map<std::size_t, std::ofstream> swapFiles;
+  const auto openFile = [this](std::map<std::size_t, std::ofstream>& files,
+                               const std::size_t layer,
+                               const std::string& name,
+                               const std::array<char, 8>& magic,
+                               const std::size_t recordSize) -> auto& {
+    auto it = files.find(layer);
+    if (it != files.end()) {
+      return it->second;
+    }
+    it = files
+             .emplace(layer, std::ofstream(dataLoggingPath + name + "_layer_" +
+                                               std::to_string(layer) + ".bin",
+                                           std::ios::binary | std::ios::trunc))
+             .first;
+    if (!it->second.good()) {
+      writerFailed.store(true, std::memory_order_relaxed);
+      std::cerr << "[data-logging] Error opening file: " << dataLoggingPath
+                << name << "_layer_" << layer << ".bin" << '\n';
+      return it->second;
+    }
+    std::array<char, BINARY_HEADER_SIZE> header{};
+    std::memcpy(header.data(), magic.data(), magic.size());
+    writeValue(header.data(), 8, BINARY_FORMAT_VERSION);
+    writeValue(header.data(), 12, static_cast<std::uint32_t>(nqubits));
+    writeValue(header.data(), 16, static_cast<std::uint32_t>(recordSize));
+    it->second.write(header.data(), header.size());
+    return it->second;
+  };
+
+  while (true) {
+    const auto head = ringHead.load(std::memory_order_relaxed);
+    if (head == ringTail.load(std::memory_order_acquire)) {
+      // all blocks pushed before stopping are visible after seeing the flag
+      if (writerStopped.load(std::memory_order_acquire) &&
+          head == ringTail.load(std::memory_order_acquire)) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      continue;
+    }
+    const auto block = std::move(ring.at(head % RING_SIZE));
+    const auto layer = block->layer;
+    switch (block->kind) {
+    case LogBlock::Kind::Nodes:
+    case LogBlock::Kind::Swaps: {
+      auto& of =
+          block->kind == LogBlock::Kind::Nodes
+              ? openFile(nodeFiles, layer, "nodes", NODES_MAGIC, nodeRecordSize)
+              : openFile(swapFiles, layer, "swaps", SWAPS_MAGIC,
+                         BINARY_SWAP_SIZE);
+      of.write(block->data.data(),
+               static_cast<std::streamsize>(block->data.size()));
+      break;
+    }
+    case LogBlock::Kind::CloseLayer:
+      // layers without any nodes get files without records
+      openFile(nodeFiles, layer, "nodes", NODES_MAGIC, nodeRecordSize);
+      openFile(swapFiles, layer, "swaps", SWAPS_MAGIC, BINARY_SWAP_SIZE);
+      nodeFiles.erase(layer);
+      swapFiles.erase(layer);
+      break;
+    case LogBlock::Kind::RemoveLayer: {
+      nodeFiles.erase(layer);
+      swapFiles.erase(layer);
+      std::error_code ec;
+      std::filesystem::remove(nodesFileName(layer), ec);
+      std::filesystem::remove(dataLoggingPath + "swaps_layer_" +
+                                  std::to_string(layer) + ".bin",
+                              ec);
+      break;
+    }
+    }
+    ringHead.store(head + 1, std::memory_order_release);
+  }
+}
+
 void DataLogger::close() {
+  if (format == DataLoggingFormat::Binary) {
+    for (std::size_t i = 0; i < finalizedLayers.size(); ++i) {
+      if (!finalizedLayers.at(i)) {
+        std::cerr << "[data-logging] Error: layer " << i
+                  << " was not finalized" << '\n';
+        finalizedLayers.at(i) = true;
+        flushBlocks();
+        auto block = std::make_unique<LogBlock>();
+        block->kind = LogBlock::Kind::CloseLayer;
+        block->layer = i;
+        pushBlock(std::move(block));
+      }
+    }
+    stopWriter();
+  }
   for (std::size_t i = 0; i < searchNodesLogFiles.size(); ++i) {
     if (searchNodesLogFiles.at(i).is_open()) {
       std::cerr << "[data-logging] Error: layer " << i << " was not finalized"
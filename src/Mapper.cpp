@@ -547,10 +547,7 @@ void Mapper::countGates(decltype(qcMapped.cbegin()) it,
         if (architecture->isFidelityAvailable()) {
           info.totalLogFidelity += architecture->getSwapFidelityCost(q1, q2);
         }
-        if (architecture->getCouplingMap().find({q1, q2}) !=
-                architecture->getCouplingMap().end() &&
-            architecture->getCouplingMap().find({q2, q1}) !=
-                architecture->getCouplingMap().end()) {
+        if (architecture->isEdgeBidirectional({q1, q2})) {
           // bidirectional edge
           info.gates += GATES_OF_BIDIRECTIONAL_SWAP;
           info.cnots += GATES_OF_BIDIRECTIONAL_SWAP;
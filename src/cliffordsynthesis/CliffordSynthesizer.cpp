@@ -5,6 +5,7 @@
 
 #include "cliffordsynthesis/CliffordSynthesizer.hpp"
 
+#include "ThreadPool.hpp"
 #include "cliffordsynthesis/Configuration.hpp"
 #include "cliffordsynthesis/Tableau.hpp"
 #include "cliffordsynthesis/TargetMetric.hpp"
@@ -18,8 +19,8 @@
 #include <cmath>
 #include <cstddef>
 #include <fstream>
-#include <future>
 #include <memory>
+#include <numeric>
 #include <plog/Appenders/ConsoleAppender.h>
 #include <plog/Formatters/TxtFormatter.h>
 #include <plog/Init.h>
@@ -28,6 +29,7 @@
 #include <plog/Severity.h>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -45,6 +47,10 @@ void CliffordSynthesizer::synthesize(const Configuration& config) {
 
   PLOG_INFO << "Optimization target: " << toString(configuration.target);
 
+  if (configuration.useCNFBackend && configuration.useMaxSAT) {
+    throw std::invalid_argument("The CNF backend cannot be used with MaxSAT.");
+  }
+
   const auto start = std::chrono::high_resolution_clock::now();
 
   // create the general configuration for the SAT encoder
@@ -57,6 +63,8 @@ void CliffordSynthesizer::synthesize(const Configuration& config) {
   encoderConfig.useMaxSAT = configuration.useMaxSAT;
   encoderConfig.useSymmetryBreaking = configuration.useSymmetryBreaking;
   encoderConfig.solverParameters = configuration.solverParameters;
+  encoderConfig.useCNFBackend = configuration.useCNFBackend;
+  encoderConfig.cnfSolverCommand = configuration.cnfSolverCommand;
   encoderConfig.useMultiGateEncoding =
       requiresMultiGateEncoding(encoderConfig.targetMetric);
 
@@ -398,10 +406,32 @@ void CliffordSynthesizer::runMaxSAT(const EncoderConfig& config) {
   updateResults(configuration, r, results);
 }
 
+void CliffordSynthesizer::startIncrementalSolving(const EncoderConfig& config) {
+  incrementalEncoder.reset();
+  // Upon entering a search, the configuration holds the largest limits that
+  // are tried, so that all calls of the search can be answered by a single
+  // formulation. An unbounded linear search has no such limit.
+  if (!configuration.incrementalSolving || config.useMaxSAT ||
+      config.timestepLimit == 0U) {
+    return;
+  }
+  PLOG_INFO << "Preparing incremental solving with timestep limit "
+            << config.timestepLimit;
+  incrementalEncoder = std::make_shared<encoding::SATEncoder>(config);
+  incrementalEncoder->prepareIncrementalRuns();
+}
+
 Results CliffordSynthesizer::callSolver(const EncoderConfig& config) {
   ++solverCalls;
-  auto encoder = encoding::SATEncoder(config);
-  const auto res = encoder.run();
+  Results res{};
+  if (incrementalEncoder &&
+      config.timestepLimit <= incrementalEncoder->getTimestepLimit()) {
+    res = incrementalEncoder->runIncremental(
+        config.timestepLimit, config.gateLimit, config.twoQubitGateLimit);
+  } else {
+    auto encoder = encoding::SATEncoder(config);
+    res = encoder.run();
+  }
   if (configuration.dumpIntermediateResults && res.sat()) {
     const auto filename = configuration.intermediateResultsPath +
                           "intermediate_" + std::to_string(solverCalls) +
@@ -502,45 +532,71 @@ void CliffordSynthesizer::depthHeuristicSynthesis() {
   qc::QuantumComputation optCircuit{initialCircuit->getNqubits()};
   const std::vector<std::size_t>& layers = getLayers(*initialCircuit);
 
-  std::vector<std::future<std::shared_ptr<qc::QuantumComputation>>> subCircuits;
+  std::vector<Results::HeuristicBlockInfo> blocks{};
   for (std::size_t i = 0; i < layers.size() - 1; i += configuration.splitSize) {
-    std::size_t const startIdx = layers[i];
-    std::size_t endIdx = 0;
-
+    auto& block = blocks.emplace_back();
+    block.begin = layers[i];
     if (i + configuration.splitSize >= layers.size()) {
-      endIdx = layers.back();
+      block.end = layers.back();
     } else {
-      endIdx = layers[i + configuration.splitSize];
+      block.end = layers[i + configuration.splitSize];
     }
-
-    // launch threads
-    subCircuits.emplace_back(
-        std::async(std::launch::async | std::launch::deferred,
-                   [this, startIdx, endIdx, &optimalConfig]() {
-                     return cs::CliffordSynthesizer::synthesizeSubcircuit(
-                         initialCircuit, startIdx, endIdx, optimalConfig);
-                   }));
   }
 
-  for (auto& subCircuit : subCircuits) {
-    const auto& circ = subCircuit.get();
-    for (auto& it : *circ) {
+  // Start with the longest blocks, since they are expected to take the longest
+  // to synthesize and would otherwise delay the end of the synthesis.
+  std::vector<std::size_t> order(blocks.size());
+  std::iota(order.begin(), order.end(), 0U);
+  std::stable_sort(order.begin(), order.end(),
+                   [&blocks](const std::size_t a, const std::size_t b) {
+                     return blocks[a].end - blocks[a].begin >
+                            blocks[b].end - blocks[b].begin;
+                   });
+
+  // each block runs its own solver instances, so the number of threads also
+  // bounds the memory used at any time
+  std::size_t nThreads = configuration.nThreadsHeuristic;
+  if (nThreads == 0U) {
+    nThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+  }
+  ThreadPool pool(std::min(nThreads, blocks.size()));
+
+  std::vector<std::shared_ptr<qc::QuantumComputation>> subCircuits(
+      blocks.size());
+  pool.parallelFor(blocks.size(), [&](const std::size_t i) {
+    const auto block = order[i];
+    subCircuits[block] =
+        synthesizeSubcircuit(initialCircuit, blocks[block], optimalConfig);
+  });
+
+  std::size_t totalSolverCalls = 0U;
+  for (std::size_t i = 0; i < blocks.size(); ++i) {
+    for (auto& it : *subCircuits[i]) {
       optCircuit.emplace_back(std::move(it));
     }
+    totalSolverCalls += blocks[i].solverCalls;
   }
   results.setDepth(optCircuit.getDepth());
+  results.setSolverCalls(totalSolverCalls);
+  results.setHeuristicBlocks(std::move(blocks));
 
-  results.setResultCircuit(optCircuit);
+  results.setResultCircuit(std::move(optCircuit));
 }
 std::shared_ptr<qc::QuantumComputation>
 CliffordSynthesizer::synthesizeSubcircuit(
-    const std::shared_ptr<qc::QuantumComputation>& qc, std::size_t begin,
-    std::size_t end, const Configuration& config) {
-  const Tableau subTargetTableau{*qc, begin, end, true};
+    const std::shared_ptr<qc::QuantumComputation>& qc,
+    Results::HeuristicBlockInfo& block, const Configuration& config) {
+  const auto start = std::chrono::steady_clock::now();
+  const Tableau subTargetTableau{*qc, block.begin, block.end, true};
   CliffordSynthesizer synth(subTargetTableau);
   synth.synthesize(config);
 
   synth.initResultCircuitFromResults();
+  const std::chrono::duration<double> diff =
+      std::chrono::steady_clock::now() - start;
+  block.runtime = diff.count();
+  block.solverCalls = synth.solverCalls;
+  block.depth = synth.resultCircuit->getDepth();
   return synth.resultCircuit;
 }
 
@@ -550,15 +606,17 @@ void CliffordSynthesizer::removeRedundantGates() {
   initResultCircuitFromResults();
   qc::QuantumComputation reducedResult(resultCircuit->getNqubits());
 
-  for (auto& gate : *resultCircuit) {
+  // the result circuit is shared with copies of the results, hence the gates
+  // are copied instead of moved out of it
+  for (const auto& gate : *resultCircuit) {
     curr.applyGate(gate.get());
     if (prev != curr) {
       prev.applyGate(gate.get());
-      reducedResult.emplace_back(std::move(gate));
+      reducedResult.emplace_back(gate->clone());
     }
   }
 
-  results.setResultCircuit(reducedResult);
   results.setSingleQubitGates(reducedResult.getNsingleQubitOps());
+  results.setResultCircuit(std::move(reducedResult));
 }
 } // namespace cs
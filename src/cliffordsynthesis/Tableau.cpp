@@ -16,6 +16,7 @@
 #include <cctype>
 #include <cstddef>
 #include <fstream>
+#include <initializer_list>
 #include <istream>
 #include <optional>
 #include <ostream>
@@ -51,7 +52,7 @@ void Tableau::import(const std::string& filename) {
 }
 
 void Tableau::import(std::istream& is) {
-  tableau.clear();
+  TableauType rows{};
 
   std::string line;
   std::vector<std::string> data{};
@@ -61,17 +62,72 @@ void Tableau::import(std::istream& is) {
     if (line.find('|', 0) == std::string::npos) {
       delimiter = ';';
     }
-    tableau.emplace_back();
     ::parseLine(line, delimiter, {'\"'}, {'\\', '\r', '\n', '\t'}, data);
+    RowType row{};
     for (const auto& datum : data) {
       if (datum.empty()) {
         continue;
       }
-      tableau.back().emplace_back(static_cast<EntryType>(std::stoul(datum)));
+      row.emplace_back(static_cast<EntryType>(std::stoul(datum)));
+    }
+    if (!row.empty()) {
+      rows.emplace_back(std::move(row));
+    }
+  }
+  setRows(rows);
+  nQubits = nColumns / 2U;
+}
+
+void Tableau::resize(const std::size_t rows, const std::size_t columns) {
+  nRows = rows;
+  nColumns = columns;
+  nWords = (rows + WORD_BITS - 1U) / WORD_BITS;
+  bits.assign(nWords * nColumns, 0U);
+}
+
+void Tableau::setRows(const TableauType& rows) {
+  if (rows.empty()) {
+    resize(0U, 0U);
+    return;
+  }
+  for (const auto& row : rows) {
+    if (row.size() != rows.front().size()) {
+      const auto* const msg = "Tableau: Tableau is not rectangular";
+      PLOG_FATAL << msg;
+      throw std::runtime_error(msg);
+    }
+  }
+  resize(rows.size(), rows.front().size());
+  for (std::size_t i = 0U; i < nRows; ++i) {
+    for (std::size_t j = 0U; j < nColumns; ++j) {
+      setEntry(i, j, rows[i][j] != 0U);
     }
   }
 }
 
+void Tableau::populateTableauFrom(const std::vector<std::uint64_t>& words,
+                                  const std::size_t nQ,
+                                  const std::size_t column) {
+  assert(column < nColumns);
+  assert(nQ <= getTableauSize());
+  auto* const col = columnWords(column);
+  for (std::size_t w = 0U; w * WORD_BITS < nQ; ++w) {
+    const auto n = std::min(nQ - (w * WORD_BITS), WORD_BITS);
+    const auto mask = n == WORD_BITS ? ~WordType{0} : (WordType{1} << n) - 1U;
+    const auto value = w < words.size() ? words[w] : WordType{0};
+    col[w] = (col[w] & ~mask) | (value & mask);
+  }
+}
+
+Tableau::TableauType Tableau::getTableau() const {
+  TableauType rows{};
+  rows.reserve(nRows);
+  for (std::size_t i = 0U; i < nRows; ++i) {
+    rows.emplace_back((*this)[i]);
+  }
+  return rows;
+}
+
 void Tableau::applyGate(const qc::Operation* const gate) {
   if (gate->getNcontrols() > 1U) {
     const auto* const msg =
@@ -164,42 +220,17 @@ void Tableau::applyGate(const qc::Operation* const gate) {
 void Tableau::createDiagonalTableau(const std::size_t nQ,
                                     const bool includeDestabilizers) {
   nQubits = nQ;
-  tableau.clear();
-  if (includeDestabilizers) {
-    tableau.resize(2U * nQubits);
-  } else {
-    tableau.resize(nQubits);
-  }
+  resize(includeDestabilizers ? 2U * nQubits : nQubits, (2U * nQubits) + 1U);
   for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-    tableau[i].resize((2U * nQubits) + 1U);
-    if (includeDestabilizers) {
-      for (std::size_t j = 0; j < (2U * nQubits); ++j) {
-        tableau[i][j] = 0;
-        if (i == j) {
-          tableau[i][j] = 1;
-        }
-      }
-    } else {
-      for (std::size_t j = nQubits; j < (2U * nQubits); ++j) {
-        tableau[i][j] = 0;
-        if (i == (j - nQubits)) {
-          tableau[i][j] = 1;
-        }
-      }
-    }
+    setEntry(i, includeDestabilizers ? i : i + nQubits, true);
   }
 }
 
 std::string Tableau::toString() const {
   std::stringstream ss;
-  for (const auto& row : tableau) {
-    if (row.size() != tableau.back().size()) {
-      const auto* const msg = "Tableau::toString: Tableau is not rectangular";
-      PLOG_FATAL << msg;
-      throw std::runtime_error(msg);
-    }
-    for (const auto& s : row) {
-      ss << std::to_string(s) << ';';
+  for (std::size_t i = 0U; i < nRows; ++i) {
+    for (std::size_t j = 0U; j < nColumns; ++j) {
+      ss << std::to_string(entry(i, j)) << ';';
     }
     ss << "\n";
   }
@@ -226,28 +257,36 @@ void Tableau::fromString(const std::string& str) {
 
 void Tableau::applyH(const std::size_t target) {
   assert(target < nQubits);
-  for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-    tableau[i][2U * nQubits] ^= static_cast<EntryType>(
-        tableau[i][target] & tableau[i][target + nQubits]);
-    std::swap(tableau[i][target], tableau[i][target + nQubits]);
+  auto* const x = columnWords(target);
+  auto* const z = columnWords(target + nQubits);
+  auto* const r = columnWords(2U * nQubits);
+  for (std::size_t w = 0U; w < nWords; ++w) {
+    r[w] ^= x[w] & z[w];
+    std::swap(x[w], z[w]);
   }
 }
 
 void Tableau::applyS(const std::size_t target) {
   assert(target < nQubits);
-  for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-    tableau[i][2U * nQubits] ^= static_cast<EntryType>(
-        tableau[i][target] & tableau[i][target + nQubits]);
-    tableau[i][target + nQubits] ^= tableau[i][target];
+  const auto* const x = columnWords(target);
+  auto* const z = columnWords(target + nQubits);
+  auto* const r = columnWords(2U * nQubits);
+  for (std::size_t w = 0U; w < nWords; ++w) {
+    r[w] ^= x[w] & z[w];
+    z[w] ^= x[w];
   }
 }
 
 // Sdag = S * S * S
 void Tableau::applySdag(const std::size_t target) {
   assert(target < nQubits);
-  applyS(target);
-  applyS(target);
-  applyS(target);
+  const auto* const x = columnWords(target);
+  auto* const z = columnWords(target + nQubits);
+  auto* const r = columnWords(2U * nQubits);
+  for (std::size_t w = 0U; w < nWords; ++w) {
+    r[w] ^= x[w] & ~z[w];
+    z[w] ^= x[w];
+  }
 }
 
 // Sx = Sdag * H * Sdag
@@ -269,37 +308,47 @@ void Tableau::applySxdag(const std::size_t target) {
 // X = H * Z * H
 void Tableau::applyX(const std::size_t target) {
   assert(target < nQubits);
-  applyH(target);
-  applyZ(target);
-  applyH(target);
+  const auto* const z = columnWords(target + nQubits);
+  auto* const r = columnWords(2U * nQubits);
+  for (std::size_t w = 0U; w < nWords; ++w) {
+    r[w] ^= z[w];
+  }
 }
 
 // Y = X * Z
 void Tableau::applyY(const std::size_t target) {
   assert(target < nQubits);
-  applyX(target);
-  applyZ(target);
+  const auto* const x = columnWords(target);
+  const auto* const z = columnWords(target + nQubits);
+  auto* const r = columnWords(2U * nQubits);
+  for (std::size_t w = 0U; w < nWords; ++w) {
+    r[w] ^= x[w] ^ z[w];
+  }
 }
 
 // Z = S * S
 void Tableau::applyZ(const std::size_t target) {
   assert(target < nQubits);
-  applyS(target);
-  applyS(target);
+  const auto* const x = columnWords(target);
+  auto* const r = columnWords(2U * nQubits);
+  for (std::size_t w = 0U; w < nWords; ++w) {
+    r[w] ^= x[w];
+  }
 }
 
 void Tableau::applyCX(const std::size_t control, const std::size_t target) {
   assert(control < nQubits);
   assert(target < nQubits);
   assert(control != target);
-  for (auto i = 0U; i < getTableauSize(); ++i) {
-    const auto xa = tableau[i][control];
-    const auto za = tableau[i][control + nQubits];
-    const auto xb = tableau[i][target];
-    const auto zb = tableau[i][target + nQubits];
-    tableau[i][2 * nQubits] ^= (xa & zb) & ((xb ^ za) ^ 1);
-    tableau[i][control + nQubits] = za ^ zb;
-    tableau[i][target] = xb ^ xa;
+  const auto* const xa = columnWords(control);
+  auto* const za = columnWords(control + nQubits);
+  auto* const xb = columnWords(target);
+  const auto* const zb = columnWords(target + nQubits);
+  auto* const r = columnWords(2U * nQubits);
+  for (std::size_t w = 0U; w < nWords; ++w) {
+    r[w] ^= (xa[w] & zb[w]) & ~(xb[w] ^ za[w]);
+    za[w] ^= zb[w];
+    xb[w] ^= xa[w];
   }
 }
 
@@ -321,13 +370,16 @@ void Tableau::applyCZ(const std::size_t control, const std::size_t target) {
   applyH(target);
 }
 
+// SWAP = CX(q1, q2) * CX(q2, q1) * CX(q1, q2), which only exchanges the
+// columns of both qubits
 void Tableau::applySwap(const std::size_t q1, const std::size_t q2) {
   assert(q1 < nQubits);
   assert(q2 < nQubits);
   assert(q1 != q2);
-  applyCX(q1, q2);
-  applyCX(q2, q1);
-  applyCX(q1, q2);
+  for (const auto offset : {std::size_t{0U}, nQubits}) {
+    auto* const first = columnWords(q1 + offset);
+    std::swap_ranges(first, first + nWords, columnWords(q2 + offset));
+  }
 }
 
 void Tableau::applyISwap(const std::size_t q1, const std::size_t q2) {
@@ -457,6 +509,7 @@ void Tableau::loadStabilizerDestabilizerString(const std::string& string) {
     }
   }
 
+  auto rows = getTableau();
   std::optional<std::size_t> stabLength;
   const auto& checkStabLength = [&](const RowType& row) {
     if (!stabLength.has_value()) {
@@ -474,18 +527,26 @@ void Tableau::loadStabilizerDestabilizerString(const std::string& string) {
     stab = stabilizers.substr(0, pos);
     const auto& row = parseStabilizer(stab);
     checkStabLength(row);
-    tableau.push_back(row);
+    rows.push_back(row);
     stabilizers = stabilizers.substr(pos + 1);
   }
   const auto& row =
       parseStabilizer(stabilizers); // parse stabilizer past last comma
   checkStabLength(row);
-  tableau.push_back(row);
+  rows.push_back(row);
+  setRows(rows);
+  nQubits = nColumns / 2U;
 }
 bool Tableau::isIdentityTableau() const {
-  for (std::size_t i = 0U; i < getTableauSize(); ++i) {
-    for (std::size_t j = 0U; j < tableau[i].size(); ++j) {
-      if ((j == i && tableau[i][j] == 0U) || (j != i && tableau[i][j] == 1U)) {
+  for (std::size_t j = 0U; j < nColumns; ++j) {
+    const auto* const col = columnWords(j);
+    for (std::size_t w = 0U; w < nWords; ++w) {
+      // the only entry in column j is expected in row j
+      WordType expected = 0U;
+      if (j < nRows && j / WORD_BITS == w) {
+        expected = WordType{1} << (j % WORD_BITS);
+      }
+      if (col[w] != expected) {
         return false;
       }
     }
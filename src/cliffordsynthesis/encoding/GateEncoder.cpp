@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <plog/Log.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace cs::encoding {
@@ -186,7 +187,7 @@ void GateEncoder::extractCircuitFromModel(Results& res, Model& model) {
   res.setSingleQubitGates(nSingleQubitGates);
   res.setTwoQubitGates(nTwoQubitGates);
   res.setDepth(qc.getDepth());
-  res.setResultCircuit(qc);
+  res.setResultCircuit(std::move(qc));
 }
 
 void GateEncoder::extractSingleQubitGatesFromModel(
@@ -229,6 +230,28 @@ void GateEncoder::extractTwoQubitGatesFromModel(const std::size_t pos,
   }
 }
 
+LogicTerm GateEncoder::createNoGateAtTimestep(const std::size_t pos) const {
+  auto noGate = LogicTerm(true);
+  const auto& singleQubitGates = vars.gS[pos];
+  for (std::size_t q = 0U; q < N; ++q) {
+    for (const auto gate : SINGLE_QUBIT_GATES) {
+      if (gate == qc::OpType::None) {
+        continue;
+      }
+      noGate = noGate && !singleQubitGates[gateToIndex(gate)][q];
+    }
+  }
+  const auto& twoQubitGates = vars.gC[pos];
+  for (std::size_t ctrl = 0U; ctrl < N; ++ctrl) {
+    for (std::size_t trgt = 0U; trgt < N; ++trgt) {
+      if (ctrl != trgt) {
+        noGate = noGate && !twoQubitGates[ctrl][trgt];
+      }
+    }
+  }
+  return noGate;
+}
+
 void GateEncoder::encodeSymmetryBreakingConstraints() {
   PLOG_DEBUG << "Encoding symmetry breaking constraints.";
   for (std::size_t t = 0U; t < T; ++t) {
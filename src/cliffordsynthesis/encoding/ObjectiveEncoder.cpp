@@ -14,6 +14,7 @@
 #include <functional>
 #include <plog/Log.h>
 #include <stdexcept>
+#include <string>
 
 namespace cs::encoding {
 
@@ -31,6 +32,21 @@ ObjectiveEncoder::collectGateCount(const bool includeSingleQubitGates) const {
   return cost;
 }
 
+LogicTerm ObjectiveEncoder::createGateCountLimitVariable(
+    const std::size_t maxGateCount, const bool includeSingleQubitGates) const {
+  PLOG_DEBUG << "Creating variable limiting the gate count to at most "
+             << maxGateCount << (includeSingleQubitGates ? "" : " two-qubit")
+             << " gate(s)";
+  const std::string name = (includeSingleQubitGates ? "gate_limit_"
+                                                    : "two_qubit_gate_limit_") +
+                           std::to_string(maxGateCount);
+  const auto limit = lb->makeVariable(name);
+  const auto cost = collectGateCount(includeSingleQubitGates);
+  lb->assertFormula(LogicTerm::implies(
+      limit, cost <= LogicTerm(static_cast<int>(maxGateCount))));
+  return limit;
+}
+
 void ObjectiveEncoder::optimizeGateCount(
     const bool includeSingleQubitGates) const {
   PLOG_DEBUG << "Optimizing " << (includeSingleQubitGates ? "" : "two-qubit ")
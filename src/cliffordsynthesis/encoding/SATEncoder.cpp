@@ -17,7 +17,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <optional>
 #include <plog/Log.h>
 #include <stdexcept>
 #include <string>
@@ -48,7 +50,11 @@ void SATEncoder::initializeSolver() {
   }
 
   if (config.useMaxSAT) {
+    // the CNF backend cannot optimize, so MaxSAT calls always go to Z3
     lb = logicutil::getZ3LogicOptimizer(success, true, params);
+  } else if (config.useCNFBackend) {
+    lb = logicutil::getCNFLogicBlock(success, true, config.cnfSolverCommand,
+                                     params);
   } else {
     lb = logicutil::getZ3LogicBlock(success, true, params);
   }
@@ -125,6 +131,20 @@ Result SATEncoder::solve() const {
   return result;
 }
 
+Result SATEncoder::solve(const LogicVector& assumptions) const {
+  PLOG_INFO << "Solving the SAT instance under " << assumptions.size()
+            << " assumption(s).";
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  const auto result = lb->solve(assumptions);
+  const auto end = std::chrono::high_resolution_clock::now();
+  const auto runtime =
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+          .count();
+  PLOG_INFO << "Instance solved in " << runtime << " ms.";
+  return result;
+}
+
 void SATEncoder::extractResultsFromModel(Results& res) const {
   auto* const model = lb->getModel();
   tableauEncoder->extractTableauFromModel(res, T, *model);
@@ -158,4 +178,88 @@ Results SATEncoder::run() {
   return res;
 }
 
+void SATEncoder::prepareIncrementalRuns() {
+  if (config.useMaxSAT) {
+    throw std::invalid_argument(
+        "Incremental runs are not supported with MaxSAT.");
+  }
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  // the gate limits are imposed per run instead
+  config.gateLimit = std::nullopt;
+  config.twoQubitGateLimit = std::nullopt;
+  createFormulation();
+
+  // Gates may only be left out at the end, since the tableau must not change
+  // after the last gate. Restricting the remaining timesteps is compatible
+  // with the symmetry breaking constraints, which only ever forbid gates in
+  // the next timestep.
+  idleTimesteps.clear();
+  idleTimesteps.reserve(T);
+  for (std::size_t t = 0U; t < T; ++t) {
+    const auto idle = lb->makeVariable("idle_" + std::to_string(t));
+    lb->assertFormula(
+        LogicTerm::implies(idle, gateEncoder->createNoGateAtTimestep(t)));
+    idleTimesteps.emplace_back(idle);
+  }
+  gateLimits.clear();
+  twoQubitGateLimits.clear();
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  pendingRuntime += std::chrono::duration<double>(end - start).count();
+}
+
+Results
+SATEncoder::runIncremental(const std::size_t timesteps,
+                           const std::optional<std::size_t> gateLimit,
+                           const std::optional<std::size_t> twoQubitGateLimit) {
+  if (!objectiveEncoder || timesteps > T) {
+    throw std::invalid_argument(
+        "Incremental runs require a formulation with at least " +
+        std::to_string(timesteps) + " timesteps.");
+  }
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  LogicVector assumptions(idleTimesteps.begin() +
+                              static_cast<std::ptrdiff_t>(timesteps),
+                          idleTimesteps.end());
+  if (gateLimit.has_value()) {
+    auto it = gateLimits.find(*gateLimit);
+    if (it == gateLimits.end()) {
+      it = gateLimits
+               .emplace(*gateLimit,
+                        objectiveEncoder->createGateCountLimitVariable(
+                            *gateLimit))
+               .first;
+    }
+    assumptions.emplace_back(it->second);
+  }
+  if (twoQubitGateLimit.has_value()) {
+    auto it = twoQubitGateLimits.find(*twoQubitGateLimit);
+    if (it == twoQubitGateLimits.end()) {
+      it = twoQubitGateLimits
+               .emplace(*twoQubitGateLimit,
+                        objectiveEncoder->createGateCountLimitVariable(
+                            *twoQubitGateLimit, false))
+               .first;
+    }
+    assumptions.emplace_back(it->second);
+  }
+  const auto solverResult = solve(assumptions);
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  const auto runtime = std::chrono::duration<double>(end - start);
+
+  Results res{};
+  res.setRuntime(runtime.count() + pendingRuntime);
+  pendingRuntime = 0.;
+  res.setSolverResult(solverResult);
+
+  if (solverResult == Result::SAT) {
+    extractResultsFromModel(res);
+  }
+
+  return res;
+}
+
 } // namespace cs::encoding
@@ -57,14 +57,14 @@ void TableauEncoder::assertTableau(const Tableau& tableau,
   PLOG_DEBUG << "Asserting tableau at time step " << t;
   PLOG_VERBOSE << "Tableau:\n" << tableau;
   for (auto a = 0U; a < N; ++a) {
-    const auto targetX = tableau.getBVFrom(a);
+    const auto targetX = tableau.getBVWordsFrom(a);
     lb->assertFormula(vars.x[t][a] == LogicTerm(targetX, n));
 
-    const auto targetZ = tableau.getBVFrom(a + N);
+    const auto targetZ = tableau.getBVWordsFrom(a + N);
     lb->assertFormula(vars.z[t][a] == LogicTerm(targetZ, n));
   }
 
-  const auto targetR = tableau.getBVFrom(2U * N);
+  const auto targetR = tableau.getBVWordsFrom(2U * N);
   lb->assertFormula(vars.r[t] == LogicTerm(targetR, n));
 }
 
@@ -73,15 +73,15 @@ void TableauEncoder::extractTableauFromModel(Results& results,
                                              Model& model) const {
   Tableau tableau(N, S > N);
   for (std::size_t i = 0; i < N; ++i) {
-    const auto bvx = model.getBitvectorValue(vars.x[t][i], lb.get());
+    const auto bvx = model.getBitvectorWords(vars.x[t][i], lb.get());
     tableau.populateTableauFrom(bvx, S, i);
-    const auto bvz = model.getBitvectorValue(vars.z[t][i], lb.get());
+    const auto bvz = model.getBitvectorWords(vars.z[t][i], lb.get());
     tableau.populateTableauFrom(bvz, S, i + N);
   }
-  const auto bvr = model.getBitvectorValue(vars.r[t], lb.get());
+  const auto bvr = model.getBitvectorWords(vars.r[t], lb.get());
   tableau.populateTableauFrom(bvr, S, 2 * N);
 
-  results.setResultTableau(tableau);
+  results.setResultTableau(std::move(tableau));
 }
 
 LogicTerm
@@ -39,6 +39,7 @@ nlohmann::basic_json<> Configuration::json() const {
     heuristicPropertiesJson["tight"] = isTight(heuristic);
     heuristicPropertiesJson["fidelity_aware"] = isFidelityAware(heuristic);
     heuristicJson["initial_layout"] = ::toString(initialLayout);
+    heuristicJson["n_threads_expansion"] = nThreadsExpansion;
     if (lookaheadHeuristic != LookaheadHeuristic::None) {
       auto& lookaheadSettings = heuristicJson["lookahead"];
       lookaheadSettings["heuristic"] = ::toString(lookaheadHeuristic);
@@ -58,6 +59,16 @@ nlohmann::basic_json<> Configuration::json() const {
     }
   }
 
+  if (method == Method::Portfolio) {
+    auto& portfolioJson = config["settings"];
+    portfolioJson["n_threads_portfolio"] = nThreadsPortfolio;
+    auto& configurations = portfolioJson["portfolio"];
+    configurations = nlohmann::basic_json<>::array();
+    for (const auto& configuration : portfolio) {
+      configurations.emplace_back(configuration.json());
+    }
+  }
+
   if (method == Method::Exact) {
     auto& exact = config["settings"];
     exact["timeout"] = timeout;
@@ -67,6 +78,10 @@ nlohmann::basic_json<> Configuration::json() const {
     }
     exact["include_WCNF"] = includeWCNF;
     exact["use_subsets"] = useSubsets;
+    if (useSubsets) {
+      exact["n_threads_subsets"] = nThreadsSubsets;
+    }
+    exact["cache_swap_distances"] = cacheSwapDistances;
     if (enableSwapLimits) {
       auto& limits = exact["limits"];
       limits["swap_reduction"] = ::toString(swapReduction);
@@ -7,6 +7,8 @@
 
 #include "Architecture.hpp"
 #include "Definitions.hpp"
+#include "MappingResults.hpp"
+#include "ThreadPool.hpp"
 #include "Logic.hpp"
 #include "LogicTerm.hpp"
 #include "configuration/CommanderGrouping.hpp"
@@ -17,6 +19,7 @@
 #include "logicblocks/Encodings.hpp"
 #include "logicblocks/LogicBlock.hpp"
 #include "logicblocks/Model.hpp"
+#include "logicblocks/Z3Logic.hpp"
 #include "logicblocks/util_logicblock.hpp"
 #include "utils.hpp"
 
@@ -29,6 +32,7 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -36,6 +40,7 @@
 #include <unordered_set>
 #include <utility>
 #include <vector>
+#include <z3++.h>
 
 void ExactMapper::map(const Configuration& settings) {
   results.config = settings;
@@ -104,135 +109,64 @@ void ExactMapper::map(const Configuration& settings) {
 
     architecture->setCouplingMap(reducedCouplingMap);
   }
+  if (config.cacheSwapDistances) {
+    architecture->setSwapDistanceCaching(true);
+  }
 
-  // 2b) If configured to use subsets, collect all k (=m over n) possibilities
-  // to pick n qubits from m device qubits. Otherwise, consider all qubits.
+  // 2b) If configured to use subsets, consider all connected subsets of n
+  // qubits out of the m device qubits. Otherwise, consider all qubits.
   std::vector<std::uint16_t> qubitRange =
       Architecture::getQubitList(architecture->getCouplingMap());
 
-  std::vector<QubitChoice> allPossibleQubitChoices{};
-  if (config.useSubsets) {
-    allPossibleQubitChoices = architecture->getAllConnectedSubsets(
-        static_cast<std::uint16_t>(qc.getNqubits()));
-  } else {
-    allPossibleQubitChoices.emplace_back(qubitRange.begin(), qubitRange.end());
-  }
-
-  // 3) determine exact mapping for this qubit choice
-  std::vector<Swaps> swaps(reducedLayerIndices.size(), Swaps{});
-  mappingSwaps.reserve(reducedLayerIndices.size());
-  std::size_t runs = 1;
-  for (auto& choice : allPossibleQubitChoices) {
-    std::size_t limit = 0U;
-    std::size_t maxLimit = 0U;
-    const std::size_t upperLimit = config.swapLimit;
-    if (config.useSubsets) {
-      maxLimit = architecture->getCouplingLimit(choice) - 1U;
-    } else {
-      maxLimit = architecture->getCouplingLimit() - 1U;
-    }
-    if (config.swapReduction == SwapReduction::CouplingLimit) {
-      if (!architecture->bidirectional()) {
-        // on a directed architecture, one more SWAP might be needed overall
-        // due to the directionality of the edges and direction reversal not
-        // being possible for every gate.
-        maxLimit += 1U;
+  // 3) determine exact mapping for each qubit choice (concurrently if
+  // configured so). The qubit choices are solved in batches while they are
+  // still being enumerated, which stops as soon as a perfect result is found.
+  const MappingResults inputResults = results;
+  QubitChoiceSearch search{};
+  ThreadPool pool(config.useSubsets ? config.nThreadsSubsets : 1U);
+  const auto batchSize = pool.size() * QUBIT_CHOICES_PER_THREAD;
+  std::vector<QubitChoice> batch{};
+  std::vector<QubitChoiceMapping> choiceMappings{};
+  const auto solveBatch = [&]() {
+    choiceMappings.clear();
+    choiceMappings.resize(batch.size());
+    pool.parallelFor(batch.size(), [&](const std::size_t i) {
+      // stop if a perfect result has been found
+      if (search.perfect()) {
+        return;
+      }
+      mapQubitChoice(batch[i], inputResults, choiceMappings[i], search);
+    });
+    batch.clear();
+
+    // 7) Pick the optimum (the first one in case of ties)
+    for (auto& mapping : choiceMappings) {
+      if (!mapping.results.timeout &&
+          mapping.results.output.gates < results.output.gates) {
+        results = mapping.results;
+        mappingSwaps = std::move(mapping.swaps);
+      }
+      if (!results.timeout && results.output.swaps == 0U &&
+          results.output.directionReverse == 0U) {
+        return false;
       }
-      limit = maxLimit;
-    } else if (config.swapReduction == SwapReduction::Increasing) {
-      limit = 0U;
-    } else { // CustomLimit
-      limit = upperLimit;
     }
+    return true;
+  };
 
-    std::size_t timeout = 0U;
-    do {
-      if (config.swapReduction == SwapReduction::Increasing) {
-        timeout += static_cast<std::size_t>(
-            static_cast<double>(settings.timeout) *
-            (static_cast<double>(limit) * 0.5) /
-            static_cast<double>(maxLimit < upperLimit ? upperLimit : maxLimit));
-        if (timeout <= 10000U) {
-          timeout = 10000U;
-        }
-        if (settings.verbose) {
-          std::cout << "Timeout: " << timeout
-                    << "  Max-Timeout: " << settings.timeout << '\n';
-        }
-      } else {
-        timeout = settings.timeout;
-      }
-
-      // reset swaps
-      for (auto& layer : swaps) {
-        layer.clear();
-      }
-
-      MappingResults choiceResults{};
-      choiceResults.copyInput(results);
-      choiceResults.config.swapLimit = limit;
-      choiceResults.output.swaps = 0U;
-      choiceResults.output.directionReverse = 0U;
-      choiceResults.output.gates = std::numeric_limits<std::size_t>::max();
-
-      // 4) reduce coupling map
-      CouplingMap reducedCouplingMap = {};
-      architecture->getReducedCouplingMap(choice, reducedCouplingMap);
-
-      if (reducedCouplingMap.empty()) {
-        break;
-      }
-
-      if (config.verbose) {
-        std::cout << "-------- qubit choice: ";
-        for (const auto q : choice) {
-          std::cout << q << " ";
-        }
-        std::cout << "---------- ";
-        if (config.swapReduction != SwapReduction::None) {
-          std::cout << "SWAP limit: " << limit;
-        }
-        std::cout << "\n";
-      }
-
-      // 6) call actual mapping routine
-      coreMappingRoutine(choice, reducedCouplingMap, choiceResults, swaps,
-                         limit, timeout);
-
-      if (config.verbose) {
-        if (!choiceResults.timeout) {
-          std::cout << "Costs: " << choiceResults.output.swaps << " SWAP(s)";
-          if (!architecture->bidirectional()) {
-            std::cout << ", " << choiceResults.output.directionReverse
-                      << " direction reverses";
-          }
-          std::cout << "\n";
-        } else {
-          std::cout << "Did not yield a result\n";
-        }
-      }
-
-      // 7) Check if new optimum found
-      if (!choiceResults.timeout &&
-          choiceResults.output.gates < results.output.gates) {
-        results = choiceResults;
-        mappingSwaps = swaps;
-      }
-      if (limit == 0) {
-        limit = 1;
-      } else {
-        limit += runs;
-        runs++;
-      }
-    } while (config.swapReduction == SwapReduction::Increasing &&
-             (limit <= upperLimit || config.swapLimit == 0) &&
-             limit < architecture->getCouplingLimit());
-
-    // stop if a perfect result has been found
-    if (!results.timeout && results.output.swaps == 0U &&
-        results.output.directionReverse == 0U) {
-      break;
+  if (config.useSubsets) {
+    const bool exhausted = architecture->forEachConnectedSubset(
+        static_cast<std::uint16_t>(qc.getNqubits()),
+        [&](const QubitSubsetMask& subset) {
+          batch.emplace_back(Architecture::toQubitSubset(subset));
+          return batch.size() < batchSize || solveBatch();
+        });
+    if (exhausted) {
+      solveBatch();
     }
+  } else {
+    batch.emplace_back(qubitRange.begin(), qubitRange.end());
+    solveBatch();
   }
 
   // return in case no result has been found
@@ -310,11 +244,9 @@ void ExactMapper::map(const Configuration& settings) {
         const Edge cnot = {locations.at(static_cast<std::size_t>(gate.control)),
                            locations.at(gate.target)};
 
-        if (architecture->getCouplingMap().find(cnot) ==
-            architecture->getCouplingMap().end()) {
+        if (!architecture->isEdgeConnected(cnot)) {
           const Edge reverse = {cnot.second, cnot.first};
-          if (architecture->getCouplingMap().find(reverse) ==
-              architecture->getCouplingMap().end()) {
+          if (!architecture->isEdgeConnected(reverse)) {
             throw QMAPException(
                 "Invalid CNOT: " + std::to_string(reverse.first) + "-" +
                 std::to_string(reverse.second));
@@ -398,11 +330,178 @@ void ExactMapper::map(const Configuration& settings) {
   results.time = diff.count();
 }
 
+bool ExactMapper::QubitChoiceSearch::startSolving(z3::context& ctx) {
+  const std::lock_guard lock(mutex);
+  if (perfectFound) {
+    return false;
+  }
+  running.insert(&ctx);
+  return true;
+}
+
+void ExactMapper::QubitChoiceSearch::stopSolving(z3::context& ctx) {
+  const std::lock_guard lock(mutex);
+  running.erase(&ctx);
+}
+
+void ExactMapper::QubitChoiceSearch::setPerfect() {
+  const std::lock_guard lock(mutex);
+  perfectFound = true;
+  for (auto* const ctx : running) {
+    ctx->interrupt();
+  }
+}
+
+void ExactMapper::mapQubitChoice(const QubitChoice& choice,
+                                 const MappingResults& inputResults,
+                                 QubitChoiceMapping& mapping,
+                                 QubitChoiceSearch& search) {
+  const auto& config = results.config;
+  const auto gatesPerSwap = architecture->bidirectional()
+                                ? GATES_OF_BIDIRECTIONAL_SWAP
+                                : GATES_OF_UNIDIRECTIONAL_SWAP;
+
+  mapping.results.copyInput(inputResults);
+  mapping.results.timeout = true;
+  mapping.results.output.gates = std::numeric_limits<std::size_t>::max();
+
+  std::vector<Swaps> swaps(reducedLayerIndices.size(), Swaps{});
+  std::size_t runs = 1;
+  std::size_t limit = 0U;
+  std::size_t maxLimit = 0U;
+  const std::size_t upperLimit = config.swapLimit;
+  if (config.useSubsets) {
+    maxLimit = architecture->getCouplingLimit(choice) - 1U;
+  } else {
+    maxLimit = architecture->getCouplingLimit() - 1U;
+  }
+  if (config.swapReduction == SwapReduction::CouplingLimit) {
+    if (!architecture->bidirectional()) {
+      // on a directed architecture, one more SWAP might be needed overall
+      // due to the directionality of the edges and direction reversal not
+      // being possible for every gate.
+      maxLimit += 1U;
+    }
+    limit = maxLimit;
+  } else if (config.swapReduction == SwapReduction::Increasing) {
+    limit = 0U;
+  } else { // CustomLimit
+    limit = upperLimit;
+  }
+
+  std::size_t timeout = 0U;
+  do {
+    if (config.swapReduction == SwapReduction::Increasing) {
+      timeout += static_cast<std::size_t>(
+          static_cast<double>(config.timeout) *
+          (static_cast<double>(limit) * 0.5) /
+          static_cast<double>(maxLimit < upperLimit ? upperLimit : maxLimit));
+      if (timeout <= 10000U) {
+        timeout = 10000U;
+      }
+      if (config.verbose) {
+        std::cout << "Timeout: " << timeout
+                  << "  Max-Timeout: " << config.timeout << '\n';
+      }
+    } else {
+      timeout = config.timeout;
+    }
+
+    // no layer of a mapping at least as good as the best one found so far for
+    // any other choice may need more SWAPs than this
+    auto effectiveLimit = limit;
+    if (config.swapReduction != SwapReduction::Increasing) {
+      effectiveLimit = std::min<std::size_t>(
+          effectiveLimit, search.bestRoutingGates.load() / gatesPerSwap);
+    }
+
+    // reset swaps
+    for (auto& layer : swaps) {
+      layer.clear();
+    }
+
+    MappingResults choiceResults{};
+    choiceResults.copyInput(inputResults);
+    choiceResults.config.swapLimit = effectiveLimit;
+    choiceResults.output.swaps = 0U;
+    choiceResults.output.directionReverse = 0U;
+    choiceResults.output.gates = std::numeric_limits<std::size_t>::max();
+
+    // 4) reduce coupling map
+    CouplingMap reducedCouplingMap = {};
+    architecture->getReducedCouplingMap(choice, reducedCouplingMap);
+
+    if (reducedCouplingMap.empty()) {
+      break;
+    }
+
+    if (config.verbose) {
+      std::stringstream ss{};
+      ss << "-------- qubit choice: ";
+      for (const auto q : choice) {
+        ss << q << " ";
+      }
+      ss << "---------- ";
+      if (config.swapReduction != SwapReduction::None) {
+        ss << "SWAP limit: " << effectiveLimit;
+      }
+      std::cout << ss.str() << "\n";
+    }
+
+    // 6) call actual mapping routine
+    coreMappingRoutine(choice, reducedCouplingMap, choiceResults, swaps,
+                       effectiveLimit, timeout, &search);
+
+    if (config.verbose) {
+      if (!choiceResults.timeout) {
+        std::stringstream ss{};
+        ss << "Costs: " << choiceResults.output.swaps << " SWAP(s)";
+        if (!architecture->bidirectional()) {
+          ss << ", " << choiceResults.output.directionReverse
+             << " direction reverses";
+        }
+        std::cout << ss.str() << "\n";
+      } else {
+        std::cout << "Did not yield a result\n";
+      }
+    }
+
+    // Check if new optimum found for this choice
+    if (!choiceResults.timeout &&
+        choiceResults.output.gates < mapping.results.output.gates) {
+      mapping.results = choiceResults;
+      mapping.swaps = swaps;
+
+      const auto routingGates =
+          (choiceResults.output.swaps * gatesPerSwap) +
+          (choiceResults.output.directionReverse * GATES_OF_DIRECTION_REVERSE);
+      auto best = search.bestRoutingGates.load();
+      while (routingGates < best &&
+             !search.bestRoutingGates.compare_exchange_weak(best,
+                                                            routingGates)) {
+        // `best` has been updated to the current value, try again
+      }
+      if (routingGates == 0U) {
+        search.setPerfect();
+      }
+    }
+    if (limit == 0) {
+      limit = 1;
+    } else {
+      limit += runs;
+      runs++;
+    }
+  } while (config.swapReduction == SwapReduction::Increasing &&
+           (limit <= upperLimit || config.swapLimit == 0) &&
+           limit < architecture->getCouplingLimit());
+}
+
 void ExactMapper::coreMappingRoutine(
     const std::set<std::uint16_t>& qubitChoice, const CouplingMap& rcm,
     MappingResults& choiceResults,
     std::vector<std::vector<std::pair<std::uint16_t, std::uint16_t>>>& swaps,
-    const std::size_t limit, const std::size_t timeout) {
+    const std::size_t limit, const std::size_t timeout,
+    QubitChoiceSearch* search) {
   const auto& config = results.config;
   using namespace logicbase;
   // LogicBlock
@@ -770,10 +869,28 @@ number of variables: (|L|-1) * m!
   /// 	Solving							//
   //////////////////////////////////////////
   lb->produceInstance();
-  const auto res = lb->solve();
+  auto& ctx = dynamic_cast<z3logic::Z3LogicOptimizer&>(*lb).getContext();
+  if (search != nullptr && !search->startSolving(ctx)) {
+    // another choice is already known to be perfect
+    lb->reset();
+    return;
+  }
+  auto res = Result::UNSAT;
+  {
+    // the context must not be interrupted anymore once it is left
+    const QubitChoiceSearch::SolvingGuard guard(search, ctx);
+    try {
+      res = lb->solve();
+    } catch (const z3::exception&) {
+      // solvers interrupted by `setPerfect` may report the cancellation
+      if (search == nullptr || !search->perfect()) {
+        throw;
+      }
+    }
+  }
   if (Result::SAT == res) {
     auto* const m = lb->getModel();
-    choiceResults.timeout = results.timeout = false;
+    choiceResults.timeout = false;
 
     // quickly determine cost
     choiceResults.output.singleQubitGates =
@@ -875,8 +992,6 @@ number of variables: (|L|-1) * m!
       }
     }
 
-  } else {
-    results.timeout = true;
   }
   lb->reset();
 }
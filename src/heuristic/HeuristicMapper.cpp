@@ -22,8 +22,10 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -37,10 +39,81 @@
 #include <utility>
 #include <vector>
 
+namespace {
+/**
+ * @brief costs of the gates affected by a swap, accumulated as in the
+ * maximum-based and in the sum-based heuristics
+ */
+struct AffectedGateCosts {
+  double max = 0.;
+  double sum = 0.;
+  /** true if all costs are integers up to `MAX_INCREMENTAL_COST` */
+  bool exact = true;
+
+  void add(const double cost) {
+    max = std::max(max, cost);
+    sum += cost;
+    exact = exact && cost <= HeuristicMapper::MAX_INCREMENTAL_COST &&
+            cost == std::floor(cost);
+  }
+};
+
+/**
+ * @brief derives the cost of a node from the cost of its parent given the
+ * costs of all gates affected by the swap in between
+ *
+ * @param sum true if the cost is the sum of all gate costs, false if it is
+ * their maximum
+ * @param previous cost of the parent node
+ * @param before costs of the affected gates in the parent node
+ * @param after costs of the affected gates in the new node
+ * @param cost resulting cost of the new node
+ *
+ * @return false if the cost cannot be derived in a way that is guaranteed to
+ * yield the same result as a full recalculation
+ */
+bool patchCost(const bool sum, const double previous,
+               const AffectedGateCosts& before, const AffectedGateCosts& after,
+               double& cost) {
+  if (sum) {
+    // all sums of such integers are exact, independent of their order
+    if (!before.exact || !after.exact ||
+        previous > HeuristicMapper::MAX_INCREMENTAL_COST ||
+        previous != std::floor(previous)) {
+      return false;
+    }
+    cost = previous - before.sum + after.sum;
+    return true;
+  }
+  if (before.max < previous) {
+    // the maximum is attained by a gate not affected by the swap
+    cost = std::max(previous, after.max);
+    return true;
+  }
+  if (after.max >= before.max) {
+    cost = after.max;
+    return true;
+  }
+  // the maximum decreased, so it might now be attained by any other gate
+  return false;
+}
+} // namespace
+
 void HeuristicMapper::map(const Configuration& configuration) {
   if (configuration.dataLoggingEnabled()) {
-    dataLogger = std::make_unique<DataLogger>(configuration.dataLoggingPath,
-                                              *architecture, qc);
+    dataLogger = std::make_unique<DataLogger>(
+        configuration.dataLoggingPath, *architecture, qc,
+        configuration.dataLoggingFormat, configuration.dataLoggingLastLayers);
+  }
+
+  if (configuration.nThreadsExpansion > 1) {
+    if (expansionPool == nullptr ||
+        expansionPool->size() != configuration.nThreadsExpansion) {
+      expansionPool =
+          std::make_unique<ThreadPool>(configuration.nThreadsExpansion);
+    }
+  } else {
+    expansionPool.reset();
   }
 
   tightHeur = isTight(configuration.heuristic);
@@ -86,6 +159,15 @@ void HeuristicMapper::map(const Configuration& configuration) {
   }
 
   routeCircuit();
+  if (routingGatesBoundExceeded) {
+    const std::chrono::duration<double> diff =
+        std::chrono::steady_clock::now() - start;
+    results.time = diff.count();
+    if (config.dataLoggingEnabled()) {
+      dataLogger->close();
+    }
+    return;
+  }
 
   postMappingOptimizations(config);
   countGates(qcMapped, results.output);
@@ -378,6 +460,8 @@ void HeuristicMapper::routeCircuit() {
   std::size_t gateidx = 0;
   std::vector<std::size_t> gatesToAdjust{};
   results.output.gates = 0U;
+  routingGates = 0U;
+  routingGatesBoundExceeded = false;
   for (std::size_t layerIndex = 0; layerIndex < layers.size(); ++layerIndex) {
     const Node result = aStarMap(layerIndex, false);
 
@@ -396,7 +480,7 @@ void HeuristicMapper::routeCircuit() {
 
     // initial layer needs no swaps
     if (layerIndex != 0 || config.swapOnFirstLayer) {
-      for (const auto& swap : result.swaps) {
+      for (const auto& swap : getSwaps(result)) {
         if (swap.op == qc::SWAP) {
           if (config.verbose) {
             std::clog << "SWAP: " << swap.first << " <-> " << swap.second
@@ -407,6 +491,10 @@ void HeuristicMapper::routeCircuit() {
               architecture->isEdgeConnected({swap.first, swap.second}, false));
           qcMapped.swap(swap.first, swap.second);
           results.output.swaps++;
+          routingGates +=
+              architecture->isEdgeBidirectional({swap.first, swap.second})
+                  ? GATES_OF_BIDIRECTIONAL_SWAP
+                  : GATES_OF_UNIDIRECTIONAL_SWAP;
         } else if (swap.op == qc::Teleportation) {
           if (config.verbose) {
             std::clog << "TELE: " << swap.first << " <-> " << swap.second
@@ -418,6 +506,7 @@ void HeuristicMapper::routeCircuit() {
                           static_cast<qc::Qubit>(swap.middleAncilla)},
               qc::Teleportation);
           results.output.teleportations++;
+          routingGates += GATES_OF_TELEPORTATION;
         }
         gateidx++;
       }
@@ -459,6 +548,7 @@ void HeuristicMapper::routeCircuit() {
           qcMapped.h(reversed.first);
 
           results.output.directionReverse++;
+          routingGates += GATES_OF_DIRECTION_REVERSE;
           gateidx += 5;
         } else {
           qcMapped.cx(qc::Control{static_cast<qc::Qubit>(cnot.first)},
@@ -467,6 +557,12 @@ void HeuristicMapper::routeCircuit() {
         }
       }
     }
+
+    if (routingGatesBound != nullptr &&
+        routingGates > routingGatesBound->load(std::memory_order_relaxed)) {
+      routingGatesBoundExceeded = true;
+      return;
+    }
   }
 
   if (config.debug && results.heuristicBenchmark.expandedNodes > 0) {
@@ -562,6 +658,7 @@ void HeuristicMapper::routeCircuit() {
 HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
   const auto& config = results.config;
   nextNodeId = 0;
+  swapHistory.clear();
 
   const SingleQubitMultiplicity& singleQubitMultiplicity =
       singleQubitMultiplicities.at(layer);
@@ -572,6 +669,7 @@ HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
   bool validMapping = false;
 
   mapUnmappedGates(layer);
+  prepareIncrementalCostUpdates(layer);
 
   node.locations = locations;
   node.qubits = qubits;
@@ -579,11 +677,8 @@ HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
   updateHeuristicCost(layer, node);
   updateLookaheadPenalty(layer, node);
 
-  if (config.dataLoggingEnabled()) {
-    dataLogger->logSearchNode(layer, node.id, node.parent,
-                              node.costFixed + node.costFixedReversals,
-                              node.costHeur, node.lookaheadPenalty, node.qubits,
-                              node.validMapping, node.swaps, node.depth);
+  if (config.dataLoggingEnabled() && !config.dataLoggingOnlyExpandedNodes) {
+    logSearchNode(node, layer);
   }
   nodes.push(node);
 
@@ -617,6 +712,8 @@ HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
       if (config.verbose) {
         std::clog << "Split layer\n";
       }
+      // the nodes generated so far refer to the gates of the unsplit layer
+      nodes.clear();
       // recursively restart search with newly split layer
       // (step to the end of the circuit, if reverse mapping is active, since
       // the split layer is inserted in this direction, otherwise 1 layer would
@@ -624,6 +721,9 @@ HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
       return aStarMap(reverse ? layer + 1 : layer, reverse);
     }
     Node current = nodes.top();
+    if (config.dataLoggingEnabled() && config.dataLoggingOnlyExpandedNodes) {
+      logSearchNode(current, layer);
+    }
     if (current.validMapping) {
       ++solutionNodes;
       if (!validMapping ||
@@ -724,18 +824,27 @@ HeuristicMapper::Node HeuristicMapper::aStarMap(size_t layer, bool reverse) {
     dataLogger->logFinalizeLayer(
         layer, compOp, singleQubitMultiplicities.at(layer),
         twoQubitMultiplicities.at(layer), qubits, result.id, result.costFixed,
-        result.costHeur, result.lookaheadPenalty, result.qubits, result.swaps,
-        result.depth);
+        result.costHeur, result.lookaheadPenalty, result.qubits,
+        getSwaps(result), result.depth);
   }
 
   // clear nodes
-  while (!nodes.empty()) {
-    nodes.pop();
-  }
+  nodes.clear();
+  incrementalSearchLayer = NO_LAYER;
 
   return result;
 }
 
+std::vector<Exchange> HeuristicMapper::getSwaps(const Node& node) const {
+  std::vector<Exchange> swaps{};
+  swaps.reserve(node.depth);
+  for (auto i = node.lastSwap; i != NO_SWAP; i = swapHistory.at(i).previous) {
+    swaps.emplace_back(swapHistory.at(i).swap);
+  }
+  std::reverse(swaps.begin(), swaps.end());
+  return swaps;
+}
+
 void HeuristicMapper::expandNode(Node& node, std::size_t layer) {
   const auto& consideredQubits = getConsideredQubits(layer);
   std::vector<std::vector<bool>> usedSwaps;
@@ -746,7 +855,7 @@ void HeuristicMapper::expandNode(Node& node, std::size_t layer) {
 
   // set up new teleportation qubits
   std::set<Edge> perms = architecture->getCouplingMap();
-  architecture->getCurrentTeleportations().clear();
+  CouplingMap teleportations{};
   architecture->getTeleportationQubits().clear();
   for (std::size_t i = 0; i < results.config.teleportationQubits; i += 2) {
     architecture->getTeleportationQubits().emplace_back(
@@ -759,7 +868,7 @@ void HeuristicMapper::expandNode(Node& node, std::size_t layer) {
         e.first = g.second;
         e.second = static_cast<std::uint16_t>(
             node.locations.at(qc.getNqubits() + i + 1));
-        architecture->getCurrentTeleportations().insert(e);
+        teleportations.insert(e);
         perms.insert(e);
       }
       if (g.second == node.locations.at(qc.getNqubits() + i) &&
@@ -767,7 +876,7 @@ void HeuristicMapper::expandNode(Node& node, std::size_t layer) {
         e.first = g.first;
         e.second = static_cast<std::uint16_t>(
             node.locations.at(qc.getNqubits() + i + 1));
-        architecture->getCurrentTeleportations().insert(e);
+        teleportations.insert(e);
         perms.insert(e);
       }
       if (g.first == node.locations.at(qc.getNqubits() + i + 1) &&
@@ -775,7 +884,7 @@ void HeuristicMapper::expandNode(Node& node, std::size_t layer) {
         e.first = g.second;
         e.second =
             static_cast<std::uint16_t>(node.locations.at(qc.getNqubits() + i));
-        architecture->getCurrentTeleportations().insert(e);
+        teleportations.insert(e);
         perms.insert(e);
       }
       if (g.second == node.locations.at(qc.getNqubits() + i + 1) &&
@@ -783,12 +892,14 @@ void HeuristicMapper::expandNode(Node& node, std::size_t layer) {
         e.first = g.first;
         e.second =
             static_cast<std::uint16_t>(node.locations.at(qc.getNqubits() + i));
-        architecture->getCurrentTeleportations().insert(e);
+        teleportations.insert(e);
         perms.insert(e);
       }
     }
   }
+  architecture->setCurrentTeleportations(teleportations);
 
+  std::vector<Edge> swaps{};
   for (const auto& q : consideredQubits) {
     for (const auto& edge : perms) {
       if (edge.first == node.locations.at(q) ||
@@ -796,45 +907,100 @@ void HeuristicMapper::expandNode(Node& node, std::size_t layer) {
         const auto q1 = node.qubits.at(edge.first);
         const auto q2 = node.qubits.at(edge.second);
         if (q2 == -1 || q1 == -1) {
-          expandNodeAddOneSwap(edge, node, layer);
+          swaps.emplace_back(edge);
         } else if (!usedSwaps.at(static_cast<std::size_t>(q1))
                         .at(static_cast<std::size_t>(q2))) {
           usedSwaps.at(static_cast<std::size_t>(q1))
               .at(static_cast<std::size_t>(q2)) = true;
           usedSwaps.at(static_cast<std::size_t>(q2))
               .at(static_cast<std::size_t>(q1)) = true;
-          expandNodeAddOneSwap(edge, node, layer);
+          swaps.emplace_back(edge);
         }
       }
     }
   }
+
+  if (expansionPool != nullptr && swaps.size() > 1) {
+    expandNodeAddSwapsInParallel(swaps, node, layer);
+    return;
+  }
+  for (const auto& swap : swaps) {
+    expandNodeAddOneSwap(swap, node, layer);
+  }
 }
 
 void HeuristicMapper::expandNodeAddOneSwap(const Edge& swap, Node& node,
                                            const std::size_t layer) {
-  Node newNode =
-      Node(nextNodeId++, node.id, node.qubits, node.locations, node.swaps,
-           node.validMappedTwoQubitGates, node.costFixed,
-           node.costFixedReversals, node.depth + 1, node.sharedSwaps);
+  Node newNode = createSuccessor(node);
 
   if (architecture->isEdgeConnected(swap, false)) {
-    applySWAP(swap, layer, newNode);
+    applySWAP(swap, layer, newNode, &node);
   } else {
     applyTeleportation(swap, layer, newNode);
   }
 
+  addSuccessor(newNode, layer);
+}
+
+void HeuristicMapper::expandNodeAddSwapsInParallel(
+    const std::vector<Edge>& swaps, const Node& node, const std::size_t layer) {
+  // everything modifying state shared between the new nodes (node ids, swap
+  // history, reservations in the lookahead penalty history) happens
+  // sequentially in the given order, hence the search is exactly the same as
+  // with sequential expansion
+  std::vector<Node> newNodes{};
+  newNodes.reserve(swaps.size());
+  std::vector<std::size_t> pendingSwaps{};
+  pendingSwaps.reserve(swaps.size());
+  for (std::size_t i = 0; i < swaps.size(); ++i) {
+    const auto& swap = swaps[i];
+    auto& newNode = newNodes.emplace_back(createSuccessor(node));
+    if (architecture->isEdgeConnected(swap, false)) {
+      newNode.lastSwap = appendSwap(
+          newNode.lastSwap, Exchange(swap.first, swap.second, qc::SWAP));
+      if (results.config.lookaheadHeuristic != LookaheadHeuristic::None) {
+        reserveLookaheadPenalties(layer, newNode);
+      }
+      pendingSwaps.emplace_back(i);
+    } else {
+      // teleportations are rare, so they are not worth to be parallelized
+      applyTeleportation(swap, layer, newNode);
+    }
+  }
+
+  expansionPool->parallelFor(
+      pendingSwaps.size(), [this, &swaps, &newNodes, &pendingSwaps, &node,
+                            layer](const std::size_t j) {
+        const auto i = pendingSwaps[j];
+        applyRecordedSWAP(swaps[i], layer, newNodes[i], &node);
+      });
+
+  for (const auto& newNode : newNodes) {
+    addSuccessor(newNode, layer);
+  }
+}
+
+void HeuristicMapper::addSuccessor(const Node& newNode,
+                                   const std::size_t layer) {
   nodes.push(newNode);
-  if (results.config.dataLoggingEnabled()) {
-    dataLogger->logSearchNode(layer, newNode.id, newNode.parent,
-                              newNode.costFixed + newNode.costFixedReversals,
-                              newNode.costHeur, newNode.lookaheadPenalty,
-                              newNode.qubits, newNode.validMapping,
-                              newNode.swaps, newNode.depth);
+  if (results.config.dataLoggingEnabled() &&
+      !results.config.dataLoggingOnlyExpandedNodes) {
+    logSearchNode(newNode, layer);
   }
 }
 
+void HeuristicMapper::logSearchNode(const Node& node, const std::size_t layer) {
+  dataLogger->logSearchNode(layer, node.id, node.parent,
+                            node.costFixed + node.costFixedReversals,
+                            node.costHeur, node.lookaheadPenalty, node.qubits,
+                            node.validMapping, getSwaps(node), node.depth);
+}
+
 void HeuristicMapper::recalculateFixedCost(std::size_t layer, Node& node) {
-  node.validMappedTwoQubitGates.clear();
+  assert(twoQubitMultiplicities.at(layer).size() <=
+         node.validMappedTwoQubitGates.size());
+  node.validMappedTwoQubitGates.reset();
+  std::size_t gateIdx = 0;
   for (const auto& [edge, mult] : twoQubitMultiplicities.at(layer)) {
     const auto [q1, q2] = edge;
     const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
@@ -842,8 +1008,9 @@ void HeuristicMapper::recalculateFixedCost(std::size_t layer, Node& node) {
 
     if (architecture->isEdgeConnected({physQ1, physQ2}, false)) {
       // validly mapped
-      node.validMappedTwoQubitGates.emplace(q1, q2);
+      node.validMappedTwoQubitGates.set(gateIdx);
     }
+    ++gateIdx;
   }
 
   if (fidelityAwareHeur) {
@@ -858,7 +1025,7 @@ void HeuristicMapper::recalculateFixedCostReversals(std::size_t layer,
                                                     Node& node) {
   node.costFixedReversals = 0.;
   if (architecture->bidirectional() || fidelityAwareHeur ||
-      node.validMappedTwoQubitGates.size() !=
+      node.validMappedTwoQubitGates.count() !=
           twoQubitMultiplicities.at(layer).size()) {
     // costFixedReversals should only be non-zero in goal nodes for
     // non-fidelity-aware heuristics and if there are unidirectional
@@ -885,7 +1052,8 @@ void HeuristicMapper::recalculateFixedCostNonFidelity(Node& node) {
   node.costFixed = 0;
 
   // swap costs
-  for (auto& swap : node.swaps) {
+  for (auto i = node.lastSwap; i != NO_SWAP; i = swapHistory.at(i).previous) {
+    const auto& swap = swapHistory.at(i).swap;
     if (swap.op == qc::SWAP) {
       // branch clone intended for performance reasons (checking edge-wise for
       // bidirectionality is not O(1))
@@ -922,7 +1090,8 @@ void HeuristicMapper::recalculateFixedCostFidelity(std::size_t layer,
                           static_cast<std::uint16_t>(node.locations.at(i)));
   }
   // adding cost of the swap gates
-  for (auto& swap : node.swaps) {
+  for (auto i = node.lastSwap; i != NO_SWAP; i = swapHistory.at(i).previous) {
+    const auto& swap = swapHistory.at(i).swap;
     if (swap.op == qc::SWAP) {
       node.costFixed +=
           architecture->getSwapFidelityCost(swap.first, swap.second);
@@ -932,9 +1101,9 @@ void HeuristicMapper::recalculateFixedCostFidelity(std::size_t layer,
     }
   }
   // adding cost of two qubit gates that are already mapped next to each other
+  std::size_t gateIdx = 0;
   for (const auto& [edge, mult] : twoQubitGateMultiplicity) {
-    if (node.validMappedTwoQubitGates.find(edge) ==
-        node.validMappedTwoQubitGates.end()) {
+    if (!node.validMappedTwoQubitGates.test(gateIdx++)) {
       // 2-qubit-gates not yet validly mapped are handled in the heuristic
       continue;
     }
@@ -950,7 +1119,14 @@ void HeuristicMapper::recalculateFixedCostFidelity(std::size_t layer,
 }
 
 void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
-                                Node& node) {
+                                Node& node, const Node* parent) {
+  node.lastSwap =
+      appendSwap(node.lastSwap, Exchange(swap.first, swap.second, qc::SWAP));
+  applyRecordedSWAP(swap, layer, node, parent);
+}
+
+void HeuristicMapper::applyRecordedSWAP(const Edge& swap, std::size_t layer,
+                                        Node& node, const Node* parent) {
   assert(architecture->isEdgeConnected(swap, false));
   const auto& singleQubitGateMultiplicity = singleQubitMultiplicities.at(layer);
 
@@ -971,9 +1147,8 @@ void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
         static_cast<std::int16_t>(swap.first);
   }
 
-  node.swaps.emplace_back(swap.first, swap.second, qc::SWAP);
-
   // check if swap created or destroyed any valid mappings of qubit pairs
+  std::size_t gateIdx = 0;
   for (const auto& [edge, mult] : twoQubitMultiplicities.at(layer)) {
     const auto [q3, q4] = edge;
     if (q3 == q1 || q3 == q2 || q4 == q1 || q4 == q2) {
@@ -981,8 +1156,7 @@ void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
       const auto physQ4 = static_cast<std::uint16_t>(node.locations.at(q4));
       if (architecture->isEdgeConnected({physQ3, physQ4}, false)) {
         // validly mapped now
-        if (fidelityAwareHeur && node.validMappedTwoQubitGates.find(edge) ==
-                                     node.validMappedTwoQubitGates.end()) {
+        if (fidelityAwareHeur && !node.validMappedTwoQubitGates.test(gateIdx)) {
           // not mapped validly before
           // add cost of newly validly mapped gates
           node.costFixed +=
@@ -991,11 +1165,10 @@ void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
               mult.second *
                   architecture->getTwoQubitFidelityCost(physQ4, physQ3);
         }
-        node.validMappedTwoQubitGates.emplace(edge);
+        node.validMappedTwoQubitGates.set(gateIdx);
       } else {
         // not mapped validly now
-        if (fidelityAwareHeur && node.validMappedTwoQubitGates.find(edge) !=
-                                     node.validMappedTwoQubitGates.end()) {
+        if (fidelityAwareHeur && node.validMappedTwoQubitGates.test(gateIdx)) {
           // mapped validly before
           // remove cost of now no longer validly mapped gates
           auto prevPhysQ3 = physQ3;
@@ -1017,9 +1190,10 @@ void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
               mult.second *
                   architecture->getTwoQubitFidelityCost(prevPhysQ4, prevPhysQ3);
         }
-        node.validMappedTwoQubitGates.erase(edge);
+        node.validMappedTwoQubitGates.reset(gateIdx);
       }
     }
+    ++gateIdx;
   }
 
   if (fidelityAwareHeur) {
@@ -1057,6 +1231,11 @@ void HeuristicMapper::applySWAP(const Edge& swap, std::size_t layer,
   }
 
   recalculateFixedCostReversals(layer, node);
+  if (parent != nullptr && incrementalSearchLayer == layer &&
+      results.config.teleportationQubits == 0) {
+    updateCostsIncrementally(layer, *parent, q1, q2, node);
+    return;
+  }
   updateHeuristicCost(layer, node);
   if (results.config.lookaheadHeuristic != LookaheadHeuristic::None) {
     updateLookaheadPenalty(layer, node);
@@ -1111,24 +1290,23 @@ void HeuristicMapper::applyTeleportation(const Edge& swap, std::size_t layer,
                         "ancillary in teleportation.");
   }
 
-  node.swaps.emplace_back(source, target, middleAnc, qc::Teleportation);
+  node.lastSwap = appendSwap(
+      node.lastSwap, Exchange(source, target, middleAnc, qc::Teleportation));
 
   node.costFixed += COST_TELEPORTATION;
 
   // check if swap created or destroyed any valid mappings of qubit pairs
+  std::size_t gateIdx = 0;
   for (const auto& [edge, mult] : twoQubitMultiplicities.at(layer)) {
     const auto [q3, q4] = edge;
     if (q3 == q1 || q3 == q2 || q4 == q1 || q4 == q2) {
       const auto physQ3 = static_cast<std::uint16_t>(node.locations.at(q3));
       const auto physQ4 = static_cast<std::uint16_t>(node.locations.at(q4));
-      if (architecture->isEdgeConnected({physQ3, physQ4}, false)) {
-        // validly mapped now
-        node.validMappedTwoQubitGates.emplace(edge);
-      } else {
-        // not mapped validly now
-        node.validMappedTwoQubitGates.erase(edge);
-      }
+      // validly mapped now or not
+      node.validMappedTwoQubitGates.set(
+          gateIdx, architecture->isEdgeConnected({physQ3, physQ4}, false));
     }
+    ++gateIdx;
   }
 
   recalculateFixedCostReversals(layer, node);
@@ -1220,7 +1398,7 @@ void HeuristicMapper::updateSharedSwaps(const Edge& swap, std::size_t layer,
 
 void HeuristicMapper::updateHeuristicCost(std::size_t layer, Node& node) {
   // the mapping is valid, only if all qubit pairs are mapped next to each other
-  node.validMapping = (node.validMappedTwoQubitGates.size() ==
+  node.validMapping = (node.validMappedTwoQubitGates.count() ==
                        twoQubitMultiplicities.at(layer).size());
 
   switch (results.config.heuristic) {
@@ -1245,41 +1423,220 @@ void HeuristicMapper::updateHeuristicCost(std::size_t layer, Node& node) {
   }
 }
 
-double HeuristicMapper::heuristicGateCountMaxDistance(std::size_t layer,
-                                                      Node& node) {
-  if (node.validMapping) {
-    return 0.;
+void HeuristicMapper::prepareIncrementalCostUpdates(const std::size_t layer) {
+  incrementalSearchLayer = NO_LAYER;
+  searchGateIndices.clear();
+  lookaheadPenaltyHistory.clear();
+  if (!incrementalCostUpdates) {
+    return;
   }
-  double costHeur = 0.;
 
-  for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
-    const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
-    const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
+  const auto addLayer = [this](const std::size_t l) {
+    auto& index = searchGateIndices.emplace_back();
+    index.layer = l;
+    index.gatesOfQubit.resize(architecture->getNqubits());
+    for (const auto& gate : twoQubitMultiplicities.at(l)) {
+      const auto [q1, q2] = gate.first;
+      const auto gateIdx = index.gates.size();
+      index.gates.emplace_back(gate);
+      index.gatesOfQubit.at(q1).emplace_back(gateIdx);
+      index.gatesOfQubit.at(q2).emplace_back(gateIdx);
+      // swaps do not map or unmap logical qubits, hence this only depends on
+      // the initial mapping of the search
+      if ((locations.at(q1) == DEFAULT_POSITION) !=
+          (locations.at(q2) == DEFAULT_POSITION)) {
+        index.partiallyMappedGates.emplace_back(gateIdx);
+      }
+    }
+  };
 
-    if (!architecture->bidirectional() &&
-        node.validMappedTwoQubitGates.find(edge) !=
-            node.validMappedTwoQubitGates.end()) {
-      // validly mapped 2-qubit-gates
-      if (!architecture->isEdgeConnected({physQ1, physQ2})) {
-        costHeur =
-            std::max(costHeur,
-                     static_cast<double>(forwardMult * COST_DIRECTION_REVERSE));
-      } else if (!architecture->isEdgeConnected({physQ2, physQ1})) {
-        costHeur =
-            std::max(costHeur,
-                     static_cast<double>(reverseMult * COST_DIRECTION_REVERSE));
+  addLayer(layer);
+  auto nextLayer = getNextLayer(layer);
+  for (std::size_t i = 0; i < results.config.nrLookaheads; ++i) {
+    if (nextLayer == std::numeric_limits<std::size_t>::max()) {
+      break;
+    }
+    addLayer(nextLayer);
+    nextLayer = getNextLayer(nextLayer);
+  }
+
+  const auto& distances = architecture->getDistances();
+  exactIncrementalSums = true;
+  for (std::size_t i = 0; i < distances.size() && exactIncrementalSums; ++i) {
+    const auto* row = distances.row(i);
+    exactIncrementalSums =
+        std::all_of(row, row + distances.size(), [](const double d) {
+          return d <= MAX_INCREMENTAL_COST && d == std::floor(d);
+        });
+  }
+
+  incrementalSearchLayer = layer;
+}
+
+void HeuristicMapper::reserveLookaheadPenalties(const std::size_t layer,
+                                                Node& node) {
+  if (incrementalSearchLayer != layer) {
+    return;
+  }
+  node.lookaheadPenalties = lookaheadPenaltyHistory.size();
+  lookaheadPenaltyHistory.resize(lookaheadPenaltyHistory.size() +
+                                 searchGateIndices.size() - 1);
+}
+
+void HeuristicMapper::updateCostsIncrementally(const std::size_t layer,
+                                               const Node& parent,
+                                               const std::int16_t q1,
+                                               const std::int16_t q2,
+                                               Node& node) {
+  const auto& config = results.config;
+  const auto& currentLayer = searchGateIndices.front();
+  node.validMapping =
+      (node.validMappedTwoQubitGates.count() == currentLayer.gates.size());
+
+  // collects all gates of a layer whose cost may differ between parent and
+  // node
+  std::vector<std::size_t> affectedGates{};
+  const auto collectAffectedGates = [&affectedGates, q1,
+                                     q2](const LayerGateIndex& index,
+                                         const bool freeQubits) {
+    affectedGates.clear();
+    for (const auto q : {q1, q2}) {
+      if (q != DEFAULT_POSITION) {
+        const auto& gates = index.gatesOfQubit.at(static_cast<std::size_t>(q));
+        affectedGates.insert(affectedGates.end(), gates.begin(), gates.end());
       }
+    }
+    if (freeQubits) {
+      affectedGates.insert(affectedGates.end(),
+                           index.partiallyMappedGates.begin(),
+                           index.partiallyMappedGates.end());
+    }
+    std::sort(affectedGates.begin(), affectedGates.end());
+    affectedGates.erase(std::unique(affectedGates.begin(), affectedGates.end()),
+                        affectedGates.end());
+  };
+
+  const bool sumHeur = config.heuristic == Heuristic::GateCountSumDistance;
+  if ((config.heuristic == Heuristic::GateCountMaxDistance ||
+       (sumHeur && exactIncrementalSums)) &&
+      !parent.validMapping) {
+    if (node.validMapping) {
+      node.costHeur = 0.;
     } else {
-      // not validly mapped 2-qubit-gates
-      if (forwardMult > 0) {
-        costHeur = std::max(costHeur, architecture->distance(physQ1, physQ2));
+      collectAffectedGates(currentLayer, false);
+      AffectedGateCosts before{};
+      AffectedGateCosts after{};
+      for (const auto gateIdx : affectedGates) {
+        const auto& [gate, multiplicity] = currentLayer.gates[gateIdx];
+        before.add(heuristicGateCountGateCost(
+            gate, multiplicity, parent.validMappedTwoQubitGates.test(gateIdx),
+            parent));
+        after.add(heuristicGateCountGateCost(
+            gate, multiplicity, node.validMappedTwoQubitGates.test(gateIdx),
+            node));
       }
-      if (reverseMult > 0) {
-        costHeur = std::max(costHeur, architecture->distance(physQ2, physQ1));
+      if (!patchCost(sumHeur, parent.costHeur, before, after, node.costHeur)) {
+        node.costHeur = sumHeur ? heuristicGateCountSumDistance(layer, node)
+                                : heuristicGateCountMaxDistance(layer, node);
       }
     }
+  } else {
+    updateHeuristicCost(layer, node);
+  }
+
+  if (config.lookaheadHeuristic == LookaheadHeuristic::None) {
+    return;
+  }
+  const bool sumLookahead =
+      config.lookaheadHeuristic == LookaheadHeuristic::GateCountSumDistance;
+  if ((config.lookaheadHeuristic != LookaheadHeuristic::GateCountMaxDistance &&
+       !(sumLookahead && exactIncrementalSums)) ||
+      parent.lookaheadPenalties == NO_LOOKAHEAD_PENALTIES) {
+    updateLookaheadPenalty(layer, node);
+    return;
+  }
+
+  // swapping a logical qubit with a free physical qubit changes the free
+  // qubits considered for all gates with an unmapped qubit
+  const bool freeQubitsChanged =
+      (q1 == DEFAULT_POSITION) != (q2 == DEFAULT_POSITION);
+  if (node.lookaheadPenalties == NO_LOOKAHEAD_PENALTIES) {
+    reserveLookaheadPenalties(layer, node);
+  }
+  node.lookaheadPenalty = 0.;
+  double factor = config.firstLookaheadFactor;
+  for (std::size_t i = 1; i < searchGateIndices.size(); ++i) {
+    const auto& index = searchGateIndices[i];
+    collectAffectedGates(index, freeQubitsChanged);
+    AffectedGateCosts before{};
+    AffectedGateCosts after{};
+    for (const auto gateIdx : affectedGates) {
+      const auto& [gate, multiplicity] = index.gates[gateIdx];
+      before.add(lookaheadGateCountGateCost(gate, multiplicity, parent));
+      after.add(lookaheadGateCountGateCost(gate, multiplicity, node));
+    }
+    double penalty = 0.;
+    if (!patchCost(sumLookahead,
+                   lookaheadPenaltyHistory[parent.lookaheadPenalties + i - 1],
+                   before, after, penalty)) {
+      penalty = sumLookahead
+                    ? lookaheadGateCountSumDistance(index.layer, node)
+                    : lookaheadGateCountMaxDistance(index.layer, node);
+    }
+    lookaheadPenaltyHistory.at(node.lookaheadPenalties + i - 1) = penalty;
+
+    // same order of operations as in `updateLookaheadPenalty`
+    node.lookaheadPenalty += factor * penalty;
+    factor *= config.lookaheadFactor;
+  }
+}
+
+double HeuristicMapper::heuristicGateCountGateCost(
+    const Edge& gate,
+    const std::pair<std::uint16_t, std::uint16_t>& multiplicity,
+    const bool validlyMapped, const Node& node) const {
+  const auto& [q1, q2] = gate;
+  const auto [forwardMult, reverseMult] = multiplicity;
+  const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
+  const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
+
+  if (!architecture->bidirectional() && validlyMapped) {
+    // validly mapped 2-qubit-gates
+    if (!architecture->isEdgeConnected({physQ1, physQ2})) {
+      return static_cast<double>(forwardMult * COST_DIRECTION_REVERSE);
+    }
+    if (!architecture->isEdgeConnected({physQ2, physQ1})) {
+      return static_cast<double>(reverseMult * COST_DIRECTION_REVERSE);
+    }
+    return 0.;
+  }
+
+  // not validly mapped 2-qubit-gates
+  if (forwardMult == 0) {
+    // forwardMult == 0 && reverseMult > 0
+    return architecture->distance(physQ2, physQ1);
+  }
+  if (reverseMult == 0) {
+    // forwardMult > 0 && reverseMult == 0
+    return architecture->distance(physQ1, physQ2);
+  }
+  // forwardMult > 0 && reverseMult > 0
+  return std::max(architecture->distance(physQ1, physQ2),
+                  architecture->distance(physQ2, physQ1));
+}
+
+double HeuristicMapper::heuristicGateCountMaxDistance(std::size_t layer,
+                                                      Node& node) {
+  if (node.validMapping) {
+    return 0.;
+  }
+  double costHeur = 0.;
+
+  std::size_t gateIdx = 0;
+  for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
+    const bool validlyMapped = node.validMappedTwoQubitGates.test(gateIdx++);
+    costHeur = std::max(costHeur, heuristicGateCountGateCost(
+                                      edge, multiplicity, validlyMapped, node));
   }
 
   return costHeur;
@@ -1292,38 +1649,11 @@ double HeuristicMapper::heuristicGateCountSumDistance(std::size_t layer,
   }
   double costHeur = 0.;
 
+  std::size_t gateIdx = 0;
   for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
-    const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
-    const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
-
-    if (!architecture->bidirectional() &&
-        node.validMappedTwoQubitGates.find(edge) !=
-            node.validMappedTwoQubitGates.end()) {
-      // validly mapped 2-qubit-gates
-      if (!architecture->isEdgeConnected({physQ1, physQ2})) {
-        costHeur += forwardMult * COST_DIRECTION_REVERSE;
-      } else if (!architecture->isEdgeConnected({physQ2, physQ1})) {
-        costHeur += reverseMult * COST_DIRECTION_REVERSE;
-      }
-    } else {
-      // not validly mapped 2-qubit-gates
-      double swapCost = 0.;
-
-      if (forwardMult == 0) {
-        // forwardMult == 0 && reverseMult > 0
-        swapCost = architecture->distance(physQ2, physQ1);
-      } else if (reverseMult == 0) {
-        // forwardMult > 0 && reverseMult == 0
-        swapCost = architecture->distance(physQ1, physQ2);
-      } else {
-        // forwardMult > 0 && reverseMult > 0
-        swapCost = std::max(architecture->distance(physQ1, physQ2),
-                            architecture->distance(physQ2, physQ1));
-      }
-      costHeur += swapCost;
-    }
+    const bool validlyMapped = node.validMappedTwoQubitGates.test(gateIdx++);
+    costHeur +=
+        heuristicGateCountGateCost(edge, multiplicity, validlyMapped, node);
   }
 
   return costHeur;
@@ -1340,11 +1670,13 @@ double HeuristicMapper::heuristicGateCountSumDistanceMinusSharedSwaps(
   std::vector<std::size_t> nSwaps{};
   nSwaps.reserve(twoQubitGateMultiplicity.size());
 
+  std::size_t gateIdx = 0;
   for (const auto& [edge, multiplicity] : twoQubitGateMultiplicity) {
     const auto& [q1, q2] = edge;
     const auto [forwardMult, reverseMult] = multiplicity;
     const auto physQ1 = static_cast<std::uint16_t>(node.locations.at(q1));
     const auto physQ2 = static_cast<std::uint16_t>(node.locations.at(q2));
+    const bool validlyMapped = node.validMappedTwoQubitGates.test(gateIdx++);
 
     if (architecture->unidirectional()) {
       // only for purely unidirectional architectures is it certain that at
@@ -1353,8 +1685,7 @@ double HeuristicMapper::heuristicGateCountSumDistanceMinusSharedSwaps(
           std::min(forwardMult, reverseMult) * COST_DIRECTION_REVERSE;
     }
 
-    if (node.validMappedTwoQubitGates.find(edge) !=
-        node.validMappedTwoQubitGates.end()) {
+    if (validlyMapped) {
       // validly mapped 2-qubit-gates
       continue;
     }
@@ -1463,14 +1794,12 @@ double HeuristicMapper::heuristicFidelityBestLocation(std::size_t layer,
 
   // iterating over all virtual qubit pairs, that share a gate on the
   // current layer
+  std::size_t gateIdx = 0;
   for (const auto& [edge, mult] : twoQubitGateMultiplicity) {
     const auto [q1, q2] = edge;
     const auto [forwardMult, reverseMult] = mult;
 
-    const bool edgeDone = (node.validMappedTwoQubitGates.find(edge) !=
-                               node.validMappedTwoQubitGates.end() ||
-                           node.validMappedTwoQubitGates.find({q1, q2}) !=
-                               node.validMappedTwoQubitGates.end());
+    const bool edgeDone = node.validMappedTwoQubitGates.test(gateIdx++);
 
     // find the optimal edge, to which to remap the given virtual qubit
     // pair and take the cost of moving it there via swaps plus the
@@ -1526,6 +1855,12 @@ void HeuristicMapper::updateLookaheadPenalty(const std::size_t layer,
   auto nextLayer = getNextLayer(layer);
   double factor = config.firstLookaheadFactor;
 
+  // record the penalties of each layer to derive those of child nodes from
+  const bool record = incrementalSearchLayer == layer;
+  if (record && node.lookaheadPenalties == NO_LOOKAHEAD_PENALTIES) {
+    reserveLookaheadPenalties(layer, node);
+  }
+
   for (std::size_t i = 0; i < config.nrLookaheads; ++i) {
     if (nextLayer == std::numeric_limits<std::size_t>::max()) {
       break;
@@ -1542,6 +1877,9 @@ void HeuristicMapper::updateLookaheadPenalty(const std::size_t layer,
     default:
       break;
     }
+    if (record) {
+      lookaheadPenaltyHistory.at(node.lookaheadPenalties + i) = penalty;
+    }
 
     node.lookaheadPenalty += factor * penalty;
     factor *= config.lookaheadFactor;
@@ -1550,65 +1888,75 @@ void HeuristicMapper::updateLookaheadPenalty(const std::size_t layer,
   }
 }
 
+double HeuristicMapper::lookaheadGateCountGateCost(
+    const Edge& gate,
+    const std::pair<std::uint16_t, std::uint16_t>& multiplicity,
+    const Node& node) const {
+  const auto& [q1, q2] = gate;
+  const auto [forwardMult, reverseMult] = multiplicity;
+
+  const auto loc1 = node.locations.at(q1);
+  const auto loc2 = node.locations.at(q2);
+  if (loc1 == DEFAULT_POSITION && loc2 == DEFAULT_POSITION) {
+    // no penalty
+    return 0.;
+  }
+  if (loc1 == DEFAULT_POSITION) {
+    auto min = std::numeric_limits<double>::max();
+    for (std::uint16_t j = 0; j < architecture->getNqubits(); ++j) {
+      if (node.qubits.at(j) == DEFAULT_POSITION) {
+        // TODO: Consider fidelity here if available
+        if (forwardMult > 0) {
+          min = std::min(
+              min, architecture->distance(j, static_cast<std::uint16_t>(loc2)));
+        }
+        if (reverseMult > 0) {
+          min = std::min(
+              min, architecture->distance(static_cast<std::uint16_t>(loc2), j));
+        }
+      }
+    }
+    return min;
+  }
+  if (loc2 == DEFAULT_POSITION) {
+    auto min = std::numeric_limits<double>::max();
+    for (std::uint16_t j = 0; j < architecture->getNqubits(); ++j) {
+      if (node.qubits.at(j) == DEFAULT_POSITION) {
+        // TODO: Consider fidelity here if available
+        if (forwardMult > 0) {
+          min = std::min(
+              min, architecture->distance(static_cast<std::uint16_t>(loc1), j));
+        }
+        if (reverseMult > 0) {
+          min = std::min(
+              min, architecture->distance(j, static_cast<std::uint16_t>(loc1)));
+        }
+      }
+    }
+    return min;
+  }
+  double cost = std::numeric_limits<double>::max();
+  if (forwardMult > 0) {
+    cost = std::min(cost,
+                    architecture->distance(static_cast<std::uint16_t>(loc1),
+                                           static_cast<std::uint16_t>(loc2)));
+  }
+  if (reverseMult > 0) {
+    cost = std::min(cost,
+                    architecture->distance(static_cast<std::uint16_t>(loc2),
+                                           static_cast<std::uint16_t>(loc1)));
+  }
+  return cost;
+}
+
 double
 HeuristicMapper::lookaheadGateCountMaxDistance(const std::size_t layer,
                                                HeuristicMapper::Node& node) {
   double penalty = 0.;
 
   for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
-
-    const auto loc1 = node.locations.at(q1);
-    const auto loc2 = node.locations.at(q2);
-    if (loc1 == DEFAULT_POSITION && loc2 == DEFAULT_POSITION) {
-      // no penalty
-    } else if (loc1 == DEFAULT_POSITION) {
-      auto min = std::numeric_limits<double>::max();
-      for (std::uint16_t j = 0; j < architecture->getNqubits(); ++j) {
-        if (node.qubits.at(j) == DEFAULT_POSITION) {
-          // TODO: Consider fidelity here if available
-          if (forwardMult > 0) {
-            min = std::min(min, architecture->distance(
-                                    j, static_cast<std::uint16_t>(loc2)));
-          }
-          if (reverseMult > 0) {
-            min = std::min(min, architecture->distance(
-                                    static_cast<std::uint16_t>(loc2), j));
-          }
-        }
-      }
-      penalty = std::max(penalty, min);
-    } else if (loc2 == DEFAULT_POSITION) {
-      auto min = std::numeric_limits<double>::max();
-      for (std::uint16_t j = 0; j < architecture->getNqubits(); ++j) {
-        if (node.qubits.at(j) == DEFAULT_POSITION) {
-          // TODO: Consider fidelity here if available
-          if (forwardMult > 0) {
-            min = std::min(min, architecture->distance(
-                                    static_cast<std::uint16_t>(loc1), j));
-          }
-          if (reverseMult > 0) {
-            min = std::min(min, architecture->distance(
-                                    j, static_cast<std::uint16_t>(loc1)));
-          }
-        }
-      }
-      penalty = std::max(penalty, min);
-    } else {
-      double cost = std::numeric_limits<double>::max();
-      if (forwardMult > 0) {
-        cost = std::min(
-            cost, architecture->distance(static_cast<std::uint16_t>(loc1),
-                                         static_cast<std::uint16_t>(loc2)));
-      }
-      if (reverseMult > 0) {
-        cost = std::min(
-            cost, architecture->distance(static_cast<std::uint16_t>(loc2),
-                                         static_cast<std::uint16_t>(loc1)));
-      }
-      penalty = std::max(penalty, cost);
-    }
+    penalty =
+        std::max(penalty, lookaheadGateCountGateCost(edge, multiplicity, node));
   }
 
   return penalty;
@@ -1620,59 +1968,7 @@ HeuristicMapper::lookaheadGateCountSumDistance(const std::size_t layer,
   double penalty = 0.;
 
   for (const auto& [edge, multiplicity] : twoQubitMultiplicities.at(layer)) {
-    const auto& [q1, q2] = edge;
-    const auto [forwardMult, reverseMult] = multiplicity;
-
-    const auto loc1 = node.locations.at(q1);
-    const auto loc2 = node.locations.at(q2);
-    if (loc1 == DEFAULT_POSITION && loc2 == DEFAULT_POSITION) {
-      // no penalty
-    } else if (loc1 == DEFAULT_POSITION) {
-      auto min = std::numeric_limits<double>::max();
-      for (std::uint16_t j = 0; j < architecture->getNqubits(); ++j) {
-        if (node.qubits.at(j) == DEFAULT_POSITION) {
-          // TODO: Consider fidelity here if available
-          if (forwardMult > 0) {
-            min = std::min(min, architecture->distance(
-                                    j, static_cast<std::uint16_t>(loc2)));
-          }
-          if (reverseMult > 0) {
-            min = std::min(min, architecture->distance(
-                                    static_cast<std::uint16_t>(loc2), j));
-          }
-        }
-      }
-      penalty += min;
-    } else if (loc2 == DEFAULT_POSITION) {
-      auto min = std::numeric_limits<double>::max();
-      for (std::uint16_t j = 0; j < architecture->getNqubits(); ++j) {
-        if (node.qubits.at(j) == DEFAULT_POSITION) {
-          // TODO: Consider fidelity here if available
-          if (forwardMult > 0) {
-            min = std::min(min, architecture->distance(
-                                    static_cast<std::uint16_t>(loc1), j));
-          }
-          if (reverseMult > 0) {
-            min = std::min(min, architecture->distance(
-                                    j, static_cast<std::uint16_t>(loc1)));
-          }
-        }
-      }
-      penalty += min;
-    } else {
-      double cost = std::numeric_limits<double>::max();
-      if (forwardMult > 0) {
-        cost = std::min(
-            cost, architecture->distance(static_cast<std::uint16_t>(loc1),
-                                         static_cast<std::uint16_t>(loc2)));
-      }
-      if (reverseMult > 0) {
-        cost = std::min(
-            cost, architecture->distance(static_cast<std::uint16_t>(loc2),
-                                         static_cast<std::uint16_t>(loc1)));
-      }
-      penalty += cost;
-    }
+    penalty += lookaheadGateCountGateCost(edge, multiplicity, node);
   }
 
   return penalty;
@@ -0,0 +1,135 @@
+//
+// This file is part of the MQT QMAP library released under the MIT license.
+// See README.md or go to https://github.com/cda-tum/qmap for more information.
+//
+
+#include "heuristic/PortfolioMapper.hpp"
+
+#include "Architecture.hpp"
+#include "MappingResults.hpp"
+#include "ThreadPool.hpp"
+#include "configuration/Configuration.hpp"
+#include "configuration/InitialLayout.hpp"
+#include "configuration/Method.hpp"
+#include "heuristic/HeuristicMapper.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+void PortfolioMapper::map(const Configuration& configuration) {
+  const auto configurations = configuration.portfolio.empty()
+                                  ? defaultPortfolio(configuration)
+                                  : configuration.portfolio;
+  for (const auto& config : configurations) {
+    if (config.method != Method::Heuristic) {
+      throw QMAPException("Portfolio mapper only supports configurations of "
+                          "the heuristic mapper!");
+    }
+  }
+  const auto n = configurations.size();
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // private copies of the circuit and the architecture for each run
+  std::vector<Architecture> architectures(n, *architecture);
+  std::vector<std::unique_ptr<HeuristicMapper>> mappers{};
+  mappers.reserve(n);
+  for (auto& arch : architectures) {
+    mappers.emplace_back(std::make_unique<HeuristicMapper>(qc, arch));
+  }
+
+  std::size_t nThreads = configuration.nThreadsPortfolio;
+  if (nThreads == 0) {
+    nThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+  }
+  ThreadPool pool(std::min(nThreads, n));
+
+  std::atomic<std::size_t> bestRoutingGates{
+      std::numeric_limits<std::size_t>::max()};
+  std::vector<MappingResults::PortfolioRunInfo> runs(n);
+  pool.parallelFor(n, [&](const std::size_t i) {
+    auto& mapper = *mappers[i];
+    auto& run = runs[i];
+    run.config = configurations[i];
+
+    const auto runStart = std::chrono::steady_clock::now();
+    mapper.setRoutingGatesBound(&bestRoutingGates);
+    mapper.map(run.config);
+    const std::chrono::duration<double> diff =
+        std::chrono::steady_clock::now() - runStart;
+    run.time = diff.count();
+    run.stoppedEarly = mapper.stoppedAtRoutingGatesBound();
+    run.routingGates = mapper.getRoutingGates();
+    if (run.stoppedEarly) {
+      return;
+    }
+
+    // runs with as many routing gates as the best one are not stopped, since
+    // they might still win a tie
+    auto best = bestRoutingGates.load();
+    while (run.routingGates < best &&
+           !bestRoutingGates.compare_exchange_weak(best, run.routingGates)) {
+      // `best` has been updated to the current value, try again
+    }
+  });
+
+  std::optional<std::size_t> winner{};
+  for (std::size_t i = 0; i < n; ++i) {
+    if (runs[i].stoppedEarly) {
+      continue;
+    }
+    if (!winner.has_value()) {
+      winner = i;
+      continue;
+    }
+    const auto& best = runs[*winner];
+    if (runs[i].routingGates < best.routingGates ||
+        (runs[i].routingGates == best.routingGates &&
+         mappers[i]->getResults().output.gates <
+             mappers[*winner]->getResults().output.gates)) {
+      winner = i;
+    }
+  }
+  if (!winner.has_value()) {
+    throw QMAPException("No configuration in the portfolio finished mapping!");
+  }
+
+  results = mappers[*winner]->getResults();
+  qcMapped = mappers[*winner]->getMappedCircuit();
+  results.portfolioRuns = std::move(runs);
+  results.portfolioWinner = *winner;
+
+  const std::chrono::duration<double> diff =
+      std::chrono::steady_clock::now() - start;
+  results.time = diff.count();
+}
+
+std::vector<Configuration>
+PortfolioMapper::defaultPortfolio(const Configuration& configuration) {
+  auto base = configuration;
+  base.method = Method::Heuristic;
+  base.portfolio.clear();
+  base.dataLoggingPath.clear();
+
+  std::vector<Configuration> portfolio{};
+  for (const auto layout : {InitialLayout::Dynamic, InitialLayout::Static,
+                            InitialLayout::Identity}) {
+    for (const auto passes :
+         {std::size_t{0}, DEFAULT_PORTFOLIO_BIDIRECTIONAL_PASSES}) {
+      auto& config = portfolio.emplace_back(base);
+      config.initialLayout = layout;
+      config.iterativeBidirectionalRouting = passes > 0;
+      config.iterativeBidirectionalRoutingPasses = passes;
+    }
+  }
+  return portfolio;
+}
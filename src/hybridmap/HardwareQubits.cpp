@@ -81,10 +81,63 @@ void HardwareQubits::computeSwapDistance(HwQubit q1, HwQubit q2) {
   }
 }
 
+std::vector<SwapDistance> HardwareQubits::computeHops(HwQubit q) const {
+  std::vector<SwapDistance> hops(swapDistances.size(),
+                                 std::numeric_limits<SwapDistance>::max());
+  std::queue<HwQubit> queue;
+  queue.push(q);
+  hops[q] = 0;
+  while (!queue.empty()) {
+    auto current = queue.front();
+    queue.pop();
+    for (const auto& nearbyQubit : nearbyQubits.at(current)) {
+      if (hops[nearbyQubit] == std::numeric_limits<SwapDistance>::max()) {
+        hops[nearbyQubit] = hops[current] + 1;
+        queue.push(nearbyQubit);
+      }
+    }
+  }
+  return hops;
+}
+
 void HardwareQubits::resetSwapDistances() {
-  // TODO Improve to only reset the swap distances necessary (use a breadth
-  // first search)
   swapDistances = SymmetricMatrix(arch->getNqubits(), -1);
+  swapDistancesExact = true;
+}
+
+void HardwareQubits::resetSwapDistances(
+    HwQubit movedQubit, const std::vector<SwapDistance>& hopsBefore) {
+  const auto hopsAfter = computeHops(movedQubit);
+  constexpr auto unreachable = std::numeric_limits<SwapDistance>::max();
+  // length of the shortest path between two qubits via the moved qubit
+  const auto hopsVia = [](const std::vector<SwapDistance>& hops, HwQubit q1,
+                          HwQubit q2) {
+    if (hops[q1] == unreachable || hops[q2] == unreachable) {
+      return std::numeric_limits<int64_t>::max();
+    }
+    return static_cast<int64_t>(hops[q1]) + hops[q2];
+  };
+  for (HwQubit i = 0; i < swapDistances.size(); ++i) {
+    for (HwQubit j = 0; j < i; ++j) {
+      const auto distance = swapDistances(i, j);
+      if (distance < 0) {
+        continue;
+      }
+      if (distance == unreachable) {
+        // the qubits can only have been connected by the moved qubit
+        if (hopsVia(hopsAfter, i, j) != std::numeric_limits<int64_t>::max()) {
+          swapDistances(i, j) = -1;
+        }
+        continue;
+      }
+      // the swap distance is one less than the hops of the path
+      const auto hops = static_cast<int64_t>(distance) + 1;
+      if (hopsVia(hopsBefore, i, j) <= hops ||
+          hopsVia(hopsAfter, i, j) < hops) {
+        swapDistances(i, j) = -1;
+      }
+    }
+  }
 }
 
 void HardwareQubits::move(HwQubit hwQubit, CoordIndex newCoord) {
@@ -92,10 +145,12 @@ void HardwareQubits::move(HwQubit hwQubit, CoordIndex newCoord) {
     throw std::runtime_error("Invalid coordinate");
   }
   // check if new coordinate is already occupied
-  for (const auto& [qubit, coord] : hwToCoordIdx) {
-    if (coord == newCoord) {
-      throw std::runtime_error("Coordinate already occupied");
-    }
+  if (isMapped(newCoord)) {
+    throw std::runtime_error("Coordinate already occupied");
+  }
+  std::vector<SwapDistance> hopsBefore;
+  if (swapDistancesExact) {
+    hopsBefore = computeHops(hwQubit);
   }
 
   // remove qubit from old nearby qubits
@@ -105,6 +160,8 @@ void HardwareQubits::move(HwQubit hwQubit, CoordIndex newCoord) {
         nearbyQubits.at(qubit).begin(), nearbyQubits.at(qubit).end(), hwQubit));
   }
   // move qubit and compute new nearby qubits
+  coordIdxToHw[hwToCoordIdx.at(hwQubit)] = NO_QUBIT;
+  coordIdxToHw[newCoord] = hwQubit;
   hwToCoordIdx.at(hwQubit) = newCoord;
   computeNearbyQubits(hwQubit);
 
@@ -115,7 +172,11 @@ void HardwareQubits::move(HwQubit hwQubit, CoordIndex newCoord) {
   }
 
   // update/reset swap distances
-  resetSwapDistances();
+  if (swapDistancesExact) {
+    resetSwapDistances(hwQubit, hopsBefore);
+  } else {
+    resetSwapDistances();
+  }
 }
 
 std::vector<Swap> HardwareQubits::getNearbySwaps(HwQubit q) const {
@@ -129,14 +190,10 @@ std::vector<Swap> HardwareQubits::getNearbySwaps(HwQubit q) const {
 
 void HardwareQubits::computeNearbyQubits(HwQubit q) {
   std::set<HwQubit> newNearbyQubits;
-  auto coordQ = hwToCoordIdx.at(q);
-  for (const auto& coord : hwToCoordIdx) {
-    if (coord.first == q) {
-      continue;
-    }
-    if (arch->getEuclideanDistance(coordQ, coord.second) <=
-        arch->getInteractionRadius()) {
-      newNearbyQubits.emplace(coord.first);
+  // only coordinates within the interaction radius need to be checked
+  for (const auto& coord : arch->getNearbyCoordinates(hwToCoordIdx.at(q))) {
+    if (isMapped(coord)) {
+      newNearbyQubits.emplace(coordIdxToHw[coord]);
     }
   }
   nearbyQubits.insert_or_assign(q, newNearbyQubits);
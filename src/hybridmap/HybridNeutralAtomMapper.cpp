@@ -38,6 +38,7 @@ qc::QuantumComputation NeutralAtomMapper::map(qc::QuantumComputation& qc,
   mappedQc = qc::QuantumComputation(arch.getNpositions());
   nMoves = 0;
   nSwaps = 0;
+  swapGateBetterCache.clear();
   qc::CircuitOptimizer::replaceMCXWithMCZ(qc);
   qc::CircuitOptimizer::singleQubitGateFusion(qc);
   qc::CircuitOptimizer::flattenOperations(qc);
@@ -88,7 +89,7 @@ qc::QuantumComputation NeutralAtomMapper::map(qc::QuantumComputation& qc,
         gatesToExecute = getExecutableGates(frontLayer.getGates());
       }
       mapAllPossibleGates(frontLayer);
-      lookaheadLayer.initLayerOffset(frontLayer.getIteratorOffset());
+      lookaheadLayer.updateLayerOffset(frontLayer.getIteratorOffset());
       reassignGatesToLayers(frontLayer.getGates(), lookaheadLayer.getGates());
       if (this->parameters.verbose) {
         printLayers();
@@ -107,7 +108,7 @@ qc::QuantumComputation NeutralAtomMapper::map(qc::QuantumComputation& qc,
         gatesToExecute = getExecutableGates(frontLayer.getGates());
       }
       mapAllPossibleGates(frontLayer);
-      lookaheadLayer.initLayerOffset(frontLayer.getIteratorOffset());
+      lookaheadLayer.updateLayerOffset(frontLayer.getIteratorOffset());
       reassignGatesToLayers(frontLayer.getGates(), lookaheadLayer.getGates());
       if (this->parameters.verbose) {
         printLayers();
@@ -192,6 +193,7 @@ void NeutralAtomMapper::mapGate(const qc::Operation* op) {
     return;
   }
   this->executedCommutingGates.emplace_back(op);
+  this->swapGateBetterCache.erase(op);
   if (this->parameters.verbose) {
     std::cout << "mapped " << op->getName() << " ";
     for (auto qubit : op->getUsedQubits()) {
@@ -305,6 +307,8 @@ void NeutralAtomMapper::updateMappingMove(AtomMove move) {
   mappedQc.move(move.first, move.second);
   auto toMoveHwQubit = this->hardwareQubits.getHwQubit(move.first);
   this->hardwareQubits.move(toMoveHwQubit, move.second);
+  // distances and free coordinates of all gates might have changed
+  this->swapGateBetterCache.clear();
   if (this->parameters.verbose) {
     std::cout << "moved " << move.first << " to " << move.second;
     if (this->mapping.isMapped(toMoveHwQubit)) {
@@ -1280,6 +1284,22 @@ NeutralAtomMapper::estimateNumMove(const qc::Operation* opPointer) {
 }
 
 bool NeutralAtomMapper::swapGateBetter(const qc::Operation* opPointer) {
+  // the estimates only depend on the hardware qubits of the gate as long as
+  // no atom has been moved
+  auto usedQubits = opPointer->getUsedQubits();
+  auto usedHwQubits = this->mapping.getHwQubits(usedQubits);
+  auto cached = this->swapGateBetterCache.find(opPointer);
+  if (cached != this->swapGateBetterCache.end() &&
+      cached->second.first == usedHwQubits) {
+    return cached->second.second;
+  }
+  const auto swapBetter = estimateSwapGateBetter(opPointer);
+  this->swapGateBetterCache[opPointer] = {std::move(usedHwQubits), swapBetter};
+  return swapBetter;
+}
+
+bool NeutralAtomMapper::estimateSwapGateBetter(
+    const qc::Operation* opPointer) {
   auto [minNumSwaps, minTimeSwaps] = estimateNumSwapGates(opPointer);
   if (minNumSwaps == 0) {
     return true;
@@ -11,9 +11,11 @@
 #include "ir/operations/Operation.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <set>
+#include <utility>
 #include <vector>
 
 namespace na {
@@ -43,13 +45,12 @@ void NeutralAtomLayer::initLayerOffset(
   this->mappedSingleQubitGates.clear();
   // if iteratorOffset is empty, set all iterators to begin
   if (iteratorOffset.empty()) {
-    for (uint32_t i = 0; i < this->dag.size(); ++i) {
-      this->iterators[i] = this->dag[i].begin();
-    }
+    this->layerOffset.assign(this->dag.size(), 0);
   } else {
-    for (uint32_t i = 0; i < this->dag.size(); ++i) {
-      this->iterators[i] = this->dag[i].begin() + iteratorOffset[i];
-    }
+    this->layerOffset = iteratorOffset;
+  }
+  for (uint32_t i = 0; i < this->dag.size(); ++i) {
+    this->iterators[i] = this->dag[i].begin() + this->layerOffset[i];
   }
   std::set<qc::Qubit> allQubits;
   for (uint32_t i = 0; i < this->dag.size(); ++i) {
@@ -58,6 +59,64 @@ void NeutralAtomLayer::initLayerOffset(
   updateByQubits(allQubits);
 }
 
+void NeutralAtomLayer::updateLayerOffset(
+    const std::vector<uint32_t>& iteratorOffset) {
+  this->mappedSingleQubitGates.clear();
+  std::set<qc::Qubit> qubitsToUpdate;
+  for (uint32_t i = 0; i < this->dag.size(); ++i) {
+    if (iteratorOffset[i] != this->layerOffset[i]) {
+      this->layerOffset[i] = iteratorOffset[i];
+      this->iterators[i] = this->dag[i].begin() + iteratorOffset[i];
+      this->candidates[i].clear();
+      qubitsToUpdate.emplace(i);
+    }
+  }
+  if (qubitsToUpdate.empty()) {
+    return;
+  }
+  // gates using an updated qubit are only candidates for the other qubits
+  // until the updated qubits have been scanned again
+  GateList remainingGates;
+  for (const auto* opPointer : this->gates) {
+    const auto usedQubits = opPointer->getUsedQubits();
+    if (std::none_of(usedQubits.begin(), usedQubits.end(),
+                     [&qubitsToUpdate](const auto& qubit) {
+                       return qubitsToUpdate.find(qubit) !=
+                              qubitsToUpdate.end();
+                     })) {
+      remainingGates.emplace_back(opPointer);
+      continue;
+    }
+    for (const auto& qubit : usedQubits) {
+      if (qubitsToUpdate.find(qubit) == qubitsToUpdate.end()) {
+        candidates[qubit].emplace_back(opPointer);
+      }
+    }
+  }
+  this->gates = std::move(remainingGates);
+  updateByQubits(qubitsToUpdate);
+
+  // restore the order of initLayerOffset, i.e., sorted by the first qubit of
+  // the gates and then by their position on this qubit
+  std::vector<std::pair<std::pair<qc::Qubit, std::ptrdiff_t>,
+                        const qc::Operation*>>
+      sortedGates;
+  sortedGates.reserve(this->gates.size());
+  for (const auto* opPointer : this->gates) {
+    const auto qubit = *opPointer->getUsedQubits().begin();
+    const auto it = std::find_if(
+        this->iterators[qubit], this->dag[qubit].end(),
+        [&opPointer](const auto* op) { return op->get() == opPointer; });
+    sortedGates.emplace_back(
+        std::make_pair(qubit, std::distance(this->dag[qubit].begin(), it)),
+        opPointer);
+  }
+  std::sort(sortedGates.begin(), sortedGates.end());
+  for (std::size_t i = 0; i < sortedGates.size(); ++i) {
+    this->gates[i] = sortedGates[i].second;
+  }
+}
+
 void NeutralAtomLayer::updateCandidatesByQubits(
     const std::set<qc::Qubit>& qubitsToUpdate) {
   for (const auto& qubit : qubitsToUpdate) {
@@ -0,0 +1,558 @@
+#include "CDCLSolver.hpp"
+
+#include "Logic.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace cnflogic {
+
+namespace {
+// the Luby sequence 1, 1, 2, 1, 1, 2, 4, ... scaled by powers of `y`
+double luby(const double y, std::size_t x) {
+  std::size_t size = 1U;
+  std::size_t seq = 0U;
+  while (size < x + 1U) {
+    ++seq;
+    size = (2U * size) + 1U;
+  }
+  while (size - 1U != x) {
+    size = (size - 1U) >> 1U;
+    --seq;
+    x = x % size;
+  }
+  return std::pow(y, static_cast<double>(seq));
+}
+
+constexpr std::size_t RESTART_BASE = 100U;
+constexpr double VARIABLE_DECAY = 0.95;
+constexpr double CLAUSE_DECAY = 0.999;
+constexpr double MIN_LEARNTS = 1000.;
+constexpr double LEARNTS_GROWTH = 1.1;
+constexpr std::size_t GLUE_LBD = 2U;
+// the clock is only read every that many conflicts
+constexpr std::size_t TIME_CHECK_INTERVAL = 64U;
+} // namespace
+
+CDCLSolver::Lit CDCLSolver::toLit(const int literal) {
+  const auto v = static_cast<Lit>(std::abs(literal)) - 1U;
+  return (2U * v) + (literal < 0 ? 1U : 0U);
+}
+
+std::int8_t CDCLSolver::value(const Lit l) const {
+  const auto a = assigns[var(l)];
+  if (a == UNASSIGNED) {
+    return UNASSIGNED;
+  }
+  return static_cast<std::int8_t>(a ^ static_cast<std::int8_t>(l & 1U));
+}
+
+void CDCLSolver::reserveVariables(const std::size_t n) {
+  while (assigns.size() < n) {
+    const auto v = assigns.size();
+    assigns.emplace_back(UNASSIGNED);
+    polarity.emplace_back(false);
+    levels.emplace_back(0U);
+    reasons.emplace_back(NO_REASON);
+    activity.emplace_back(0.);
+    heapIndex.emplace_back(NOT_IN_HEAP);
+    seen.emplace_back(false);
+    watches.resize(2U * assigns.size());
+    heapInsert(v);
+  }
+}
+
+bool CDCLSolver::addClause(const std::vector<int>& clause) {
+  if (!ok) {
+    return false;
+  }
+  std::vector<Lit> lits{};
+  lits.reserve(clause.size());
+  for (const auto l : clause) {
+    reserveVariables(static_cast<std::size_t>(std::abs(l)));
+    lits.emplace_back(toLit(l));
+  }
+  std::sort(lits.begin(), lits.end());
+  lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+
+  // clauses are only added at the top level, where all assignments are final
+  std::size_t j = 0U;
+  for (std::size_t i = 0U; i < lits.size(); ++i) {
+    if (value(lits[i]) == 1 || (i > 0U && lits[i] == neg(lits[i - 1U]))) {
+      return true;
+    }
+    if (value(lits[i]) == UNASSIGNED) {
+      lits[j++] = lits[i];
+    }
+  }
+  lits.resize(j);
+
+  if (lits.empty()) {
+    ok = false;
+    return false;
+  }
+  if (lits.size() == 1U) {
+    enqueue(lits.front(), NO_REASON);
+    ok = propagate() == NO_REASON;
+    return ok;
+  }
+  attachClause(std::move(lits), false);
+  return true;
+}
+
+Result CDCLSolver::solve(const std::vector<int>& assumptions) {
+  model.clear();
+  if (!ok) {
+    return Result::UNSAT;
+  }
+  std::vector<Lit> lits{};
+  lits.reserve(assumptions.size());
+  for (const auto l : assumptions) {
+    reserveVariables(static_cast<std::size_t>(std::abs(l)));
+    lits.emplace_back(toLit(l));
+  }
+  maxLearnts = std::max(
+      {maxLearnts, MIN_LEARNTS, static_cast<double>(clauses.size()) / 3.});
+
+  conflictBudget = conflictLimit == 0U
+                       ? std::numeric_limits<std::size_t>::max()
+                       : conflicts + conflictLimit;
+  deadline = std::chrono::steady_clock::now() + timeout;
+  nextTimeCheck = conflicts;
+  budgetHit = false;
+
+  auto result = Result::NDEF;
+  for (std::size_t restarts = 0U; result == Result::NDEF && !budgetHit;
+       ++restarts) {
+    const auto maxConflicts = static_cast<std::size_t>(
+        luby(2., restarts) * static_cast<double>(RESTART_BASE));
+    result = search(maxConflicts, lits);
+  }
+  if (result == Result::SAT) {
+    model.assign(assigns.size() + 1U, false);
+    for (std::size_t v = 0U; v < assigns.size(); ++v) {
+      model[v + 1U] = assigns[v] == 1;
+    }
+  }
+  cancelUntil(0U);
+  return result;
+}
+
+bool CDCLSolver::budgetExhausted() {
+  if (conflicts >= conflictBudget) {
+    budgetHit = true;
+  } else if (timeout.count() > 0 && conflicts >= nextTimeCheck) {
+    nextTimeCheck = conflicts + TIME_CHECK_INTERVAL;
+    budgetHit = std::chrono::steady_clock::now() >= deadline;
+  }
+  return budgetHit;
+}
+
+Result CDCLSolver::search(const std::size_t maxConflicts,
+                          const std::vector<Lit>& assumptions) {
+  std::size_t conflictsHere = 0U;
+  std::vector<Lit> learnt{};
+  while (true) {
+    const auto conflict = propagate();
+    if (conflict != NO_REASON) {
+      ++conflicts;
+      ++conflictsHere;
+      if (decisionLevel() == 0U) {
+        ok = false;
+        return Result::UNSAT;
+      }
+      std::size_t backtrackLevel = 0U;
+      analyze(conflict, learnt, backtrackLevel);
+      cancelUntil(backtrackLevel);
+      if (learnt.size() == 1U) {
+        enqueue(learnt.front(), NO_REASON);
+      } else {
+        const auto lbd = computeLBD(learnt);
+        const auto ref = attachClause(learnt, true);
+        clauses[ref].lbd = lbd;
+        bumpClause(clauses[ref]);
+        enqueue(learnt.front(), ref);
+      }
+      variableIncrement /= VARIABLE_DECAY;
+      clauseIncrement /= CLAUSE_DECAY;
+      continue;
+    }
+
+    if (conflictsHere >= maxConflicts || budgetExhausted()) {
+      cancelUntil(0U);
+      return Result::NDEF;
+    }
+    if (static_cast<double>(learnts.size()) >=
+        maxLearnts + static_cast<double>(trail.size())) {
+      reduceLearnts();
+      maxLearnts *= LEARNTS_GROWTH;
+    }
+
+    // assumptions are decided first, each on its own decision level
+    std::optional<Lit> next{};
+    while (decisionLevel() < assumptions.size()) {
+      const auto p = assumptions[decisionLevel()];
+      const auto v = value(p);
+      if (v == 1) {
+        trailLimits.emplace_back(trail.size());
+      } else if (v == 0) {
+        return Result::UNSAT;
+      } else {
+        next = p;
+        break;
+      }
+    }
+    while (!next.has_value()) {
+      if (heap.empty()) {
+        return Result::SAT;
+      }
+      const auto v = heapPop();
+      if (assigns[v] == UNASSIGNED) {
+        next = static_cast<Lit>((2U * v) + (polarity[v] ? 0U : 1U));
+      }
+    }
+    trailLimits.emplace_back(trail.size());
+    enqueue(*next, NO_REASON);
+  }
+}
+
+void CDCLSolver::enqueue(const Lit l, const ClauseRef reason) {
+  const auto v = var(l);
+  assigns[v] = (l & 1U) != 0U ? 0 : 1;
+  levels[v] = decisionLevel();
+  reasons[v] = reason;
+  trail.emplace_back(l);
+}
+
+CDCLSolver::ClauseRef CDCLSolver::propagate() {
+  auto conflict = NO_REASON;
+  while (propagated < trail.size() && conflict == NO_REASON) {
+    const auto falseLit = neg(trail[propagated++]);
+    auto& ws = watches[falseLit];
+    std::size_t i = 0U;
+    std::size_t j = 0U;
+    while (i < ws.size()) {
+      const auto w = ws[i++];
+      if (value(w.blocker) == 1) {
+        ws[j++] = w;
+        continue;
+      }
+      const auto ref = w.ref;
+      auto& lits = clauses[ref].lits;
+      if (lits[0] == falseLit) {
+        std::swap(lits[0], lits[1]);
+      }
+      const Watcher updated{ref, lits[0]};
+      if (lits[0] != w.blocker && value(lits[0]) == 1) {
+        ws[j++] = updated;
+        continue;
+      }
+      bool moved = false;
+      for (std::size_t k = 2U; k < lits.size(); ++k) {
+        if (value(lits[k]) != 0) {
+          std::swap(lits[1], lits[k]);
+          watches[lits[1]].emplace_back(updated);
+          moved = true;
+          break;
+        }
+      }
+      if (moved) {
+        continue;
+      }
+      ws[j++] = updated;
+      if (value(lits[0]) == 0) {
+        conflict = ref;
+        while (i < ws.size()) {
+          ws[j++] = ws[i++];
+        }
+      } else {
+        enqueue(lits[0], ref);
+      }
+    }
+    ws.resize(j);
+  }
+  if (conflict != NO_REASON) {
+    propagated = trail.size();
+  }
+  return conflict;
+}
+
+void CDCLSolver::analyze(ClauseRef conflict, std::vector<Lit>& learnt,
+                         std::size_t& backtrackLevel) {
+  learnt.clear();
+  learnt.emplace_back(0U); // placeholder for the asserting literal
+  std::size_t pathCount = 0U;
+  auto index = trail.size();
+  Lit p = 0U;
+  bool first = true;
+  do {
+    auto& c = clauses[conflict];
+    if (c.learnt) {
+      bumpClause(c);
+    }
+    for (std::size_t j = first ? 0U : 1U; j < c.lits.size(); ++j) {
+      const auto q = c.lits[j];
+      const auto v = var(q);
+      if (!seen[v] && levels[v] > 0U) {
+        bumpVariable(v);
+        seen[v] = true;
+        if (levels[v] >= decisionLevel()) {
+          ++pathCount;
+        } else {
+          learnt.emplace_back(q);
+        }
+      }
+    }
+    first = false;
+    do {
+      --index;
+    } while (!seen[var(trail[index])]);
+    p = trail[index];
+    conflict = reasons[var(p)];
+    seen[var(p)] = false;
+    --pathCount;
+  } while (pathCount > 0U);
+  learnt.front() = neg(p);
+
+  // drop literals implied by the other literals of the clause
+  analyzeToClear = learnt;
+  std::uint64_t abstractLevels = 0U;
+  for (std::size_t i = 1U; i < learnt.size(); ++i) {
+    abstractLevels |= abstractLevel(var(learnt[i]));
+  }
+  std::size_t j = 1U;
+  for (std::size_t i = 1U; i < learnt.size(); ++i) {
+    if (reasons[var(learnt[i])] == NO_REASON ||
+        !redundant(learnt[i], abstractLevels)) {
+      learnt[j++] = learnt[i];
+    }
+  }
+  learnt.resize(j);
+  for (const auto l : analyzeToClear) {
+    seen[var(l)] = false;
+  }
+
+  backtrackLevel = 0U;
+  if (learnt.size() > 1U) {
+    std::size_t maxIndex = 1U;
+    for (std::size_t i = 2U; i < learnt.size(); ++i) {
+      if (levels[var(learnt[i])] > levels[var(learnt[maxIndex])]) {
+        maxIndex = i;
+      }
+    }
+    std::swap(learnt[1], learnt[maxIndex]);
+    backtrackLevel = levels[var(learnt[1])];
+  }
+}
+
+bool CDCLSolver::redundant(const Lit p, const std::uint64_t abstractLevels) {
+  // `p` is redundant if all paths from it through the implication graph end
+  // in literals of the learnt clause
+  analyzeStack.clear();
+  analyzeStack.emplace_back(p);
+  const auto top = analyzeToClear.size();
+  while (!analyzeStack.empty()) {
+    const auto& lits = clauses[reasons[var(analyzeStack.back())]].lits;
+    analyzeStack.pop_back();
+    for (std::size_t k = 1U; k < lits.size(); ++k) {
+      const auto q = lits[k];
+      const auto v = var(q);
+      if (seen[v] || levels[v] == 0U) {
+        continue;
+      }
+      if (reasons[v] != NO_REASON &&
+          (abstractLevel(v) & abstractLevels) != 0U) {
+        seen[v] = true;
+        analyzeStack.emplace_back(q);
+        analyzeToClear.emplace_back(q);
+      } else {
+        for (auto i = top; i < analyzeToClear.size(); ++i) {
+          seen[var(analyzeToClear[i])] = false;
+        }
+        analyzeToClear.resize(top);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::size_t CDCLSolver::computeLBD(const std::vector<Lit>& lits) {
+  ++levelStamp;
+  std::size_t lbd = 0U;
+  for (const auto l : lits) {
+    const auto level = levels[var(l)];
+    if (levelStamps.size() <= level) {
+      levelStamps.resize(level + 1U, 0U);
+    }
+    if (levelStamps[level] != levelStamp) {
+      levelStamps[level] = levelStamp;
+      ++lbd;
+    }
+  }
+  return lbd;
+}
+
+void CDCLSolver::cancelUntil(const std::size_t level) {
+  if (decisionLevel() <= level) {
+    return;
+  }
+  for (auto i = trail.size(); i > trailLimits[level]; --i) {
+    const auto v = var(trail[i - 1U]);
+    polarity[v] = assigns[v] == 1;
+    assigns[v] = UNASSIGNED;
+    reasons[v] = NO_REASON;
+    if (!inHeap(v)) {
+      heapInsert(v);
+    }
+  }
+  trail.resize(trailLimits[level]);
+  trailLimits.resize(level);
+  propagated = trail.size();
+}
+
+CDCLSolver::ClauseRef CDCLSolver::attachClause(std::vector<Lit> lits,
+                                               const bool learnt) {
+  ClauseRef ref{};
+  if (freeClauses.empty()) {
+    ref = static_cast<ClauseRef>(clauses.size());
+    clauses.emplace_back();
+  } else {
+    ref = freeClauses.back();
+    freeClauses.pop_back();
+  }
+  auto& c = clauses[ref];
+  c.lits = std::move(lits);
+  c.activity = 0.;
+  c.learnt = learnt;
+  c.deleted = false;
+  watches[c.lits[0]].push_back({ref, c.lits[1]});
+  watches[c.lits[1]].push_back({ref, c.lits[0]});
+  if (learnt) {
+    learnts.emplace_back(ref);
+  }
+  return ref;
+}
+
+bool CDCLSolver::locked(const ClauseRef ref) const {
+  const auto& c = clauses[ref];
+  return reasons[var(c.lits[0])] == ref && value(c.lits[0]) == 1;
+}
+
+void CDCLSolver::reduceLearnts() {
+  std::sort(learnts.begin(), learnts.end(),
+            [this](const ClauseRef a, const ClauseRef b) {
+              return clauses[a].activity < clauses[b].activity;
+            });
+  const auto limit = clauseIncrement / static_cast<double>(learnts.size());
+  std::vector<ClauseRef> kept{};
+  for (std::size_t i = 0U; i < learnts.size(); ++i) {
+    const auto ref = learnts[i];
+    auto& c = clauses[ref];
+    if (c.lits.size() > 2U && c.lbd > GLUE_LBD && !locked(ref) &&
+        (i < learnts.size() / 2U || c.activity < limit)) {
+      c.deleted = true;
+      c.lits = {};
+      freeClauses.emplace_back(ref);
+    } else {
+      kept.emplace_back(ref);
+    }
+  }
+  learnts = std::move(kept);
+  // deleted clauses may only be reused once no watch refers to them anymore
+  for (auto& ws : watches) {
+    ws.erase(std::remove_if(ws.begin(), ws.end(),
+                            [this](const Watcher& w) {
+                              return clauses[w.ref].deleted;
+                            }),
+             ws.end());
+  }
+}
+
+void CDCLSolver::bumpVariable(const std::size_t v) {
+  activity[v] += variableIncrement;
+  if (activity[v] > 1e100) {
+    for (auto& a : activity) {
+      a *= 1e-100;
+    }
+    variableIncrement *= 1e-100;
+  }
+  if (inHeap(v)) {
+    heapUp(heapIndex[v]);
+  }
+}
+
+void CDCLSolver::bumpClause(Clause& c) {
+  c.activity += clauseIncrement;
+  if (c.activity > 1e20) {
+    for (const auto ref : learnts) {
+      clauses[ref].activity *= 1e-20;
+    }
+    clauseIncrement *= 1e-20;
+  }
+}
+
+void CDCLSolver::heapInsert(const std::size_t v) {
+  heapIndex[v] = heap.size();
+  heap.emplace_back(v);
+  heapUp(heapIndex[v]);
+}
+
+std::size_t CDCLSolver::heapPop() {
+  const auto top = heap.front();
+  heapIndex[top] = NOT_IN_HEAP;
+  const auto last = heap.back();
+  heap.pop_back();
+  if (!heap.empty()) {
+    heap.front() = last;
+    heapIndex[last] = 0U;
+    heapDown(0U);
+  }
+  return top;
+}
+
+void CDCLSolver::heapUp(std::size_t i) {
+  const auto v = heap[i];
+  while (i > 0U) {
+    const auto parent = (i - 1U) / 2U;
+    if (activity[heap[parent]] >= activity[v]) {
+      break;
+    }
+    heap[i] = heap[parent];
+    heapIndex[heap[i]] = i;
+    i = parent;
+  }
+  heap[i] = v;
+  heapIndex[v] = i;
+}
+
+void CDCLSolver::heapDown(std::size_t i) {
+  const auto v = heap[i];
+  while (true) {
+    auto child = (2U * i) + 1U;
+    if (child >= heap.size()) {
+      break;
+    }
+    if (child + 1U < heap.size() &&
+        activity[heap[child + 1U]] > activity[heap[child]]) {
+      ++child;
+    }
+    if (activity[heap[child]] <= activity[v]) {
+      break;
+    }
+    heap[i] = heap[child];
+    heapIndex[heap[i]] = i;
+    i = child;
+  }
+  heap[i] = v;
+  heapIndex[v] = i;
+}
+} // namespace cnflogic
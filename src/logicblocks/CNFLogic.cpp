@@ -0,0 +1,857 @@
+#include "CNFLogic.hpp"
+
+#include "CNFModel.hpp"
+#include "Logic.hpp"
+#include "LogicTerm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <plog/Log.h>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+namespace cnflogic {
+
+namespace {
+[[noreturn]] void unsupported(const char* msg) {
+  PLOG_FATAL << msg;
+  throw std::runtime_error(msg);
+}
+
+// sums of Boolean terms keep the Boolean type, hence the operation matters
+bool isNumeric(const LogicTerm& a) {
+  switch (a.getOpType()) {
+  case OpType::ADD:
+  case OpType::SUB:
+  case OpType::MUL:
+  case OpType::DIV:
+    return true;
+  case OpType::ITE:
+    return isNumeric(a.getNodes()[1]) || isNumeric(a.getNodes()[2]);
+  default:
+    return a.getCType() == CType::INT || a.getCType() == CType::REAL;
+  }
+}
+
+FILE* openProcess(const std::string& command) {
+#ifdef _WIN32
+  return _popen(command.c_str(), "r");
+#else
+  return popen(command.c_str(), "r");
+#endif
+}
+
+// the exit code of the process or -1 if it did not terminate normally
+int closeProcess(FILE* process) {
+#ifdef _WIN32
+  return _pclose(process);
+#else
+  const auto status = pclose(process);
+  if (status == -1 || !WIFEXITED(status)) {
+    return -1;
+  }
+  return WEXITSTATUS(status);
+#endif
+}
+
+// exit codes of SAT solvers following the conventions of the SAT competition
+constexpr int EXIT_SATISFIABLE = 10;
+constexpr int EXIT_UNSATISFIABLE = 20;
+} // namespace
+
+CNFLogicBlock::~CNFLogicBlock() {
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  delete model;
+}
+
+void CNFLogicBlock::initialize() {
+  nVariables = 0U;
+  nClauses = 0U;
+  clauseBuffer.clear();
+  passedLiterals = 0U;
+  solver = CDCLSolver{};
+  encoded.clear();
+  counters.clear();
+
+  // variable 1 is the constant true
+  newVariable();
+  clauseBuffer.push_back(TRUE_LITERAL);
+  clauseBuffer.push_back(0);
+  ++nClauses;
+}
+
+void CNFLogicBlock::addClause(const std::vector<int>& clause) {
+  std::vector<int> literals;
+  literals.reserve(clause.size());
+  for (const auto lit : clause) {
+    if (lit == TRUE_LITERAL) {
+      return; // trivially satisfied
+    }
+    if (lit != -TRUE_LITERAL) {
+      literals.push_back(lit);
+    }
+  }
+  if (literals.empty()) {
+    literals.push_back(-TRUE_LITERAL); // unsatisfiable
+  }
+  clauseBuffer.insert(clauseBuffer.end(), literals.begin(), literals.end());
+  clauseBuffer.push_back(0);
+  ++nClauses;
+}
+
+int CNFLogicBlock::andLiteral(std::vector<int> inputs) {
+  std::sort(inputs.begin(), inputs.end());
+  inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+  std::vector<int> literals;
+  literals.reserve(inputs.size());
+  for (const auto lit : inputs) {
+    if (lit == -TRUE_LITERAL ||
+        std::binary_search(inputs.begin(), inputs.end(), -lit)) {
+      return -TRUE_LITERAL;
+    }
+    if (lit != TRUE_LITERAL) {
+      literals.push_back(lit);
+    }
+  }
+  if (literals.empty()) {
+    return TRUE_LITERAL;
+  }
+  if (literals.size() == 1U) {
+    return literals.front();
+  }
+
+  const auto y = newVariable();
+  std::vector<int> clause{y};
+  for (const auto lit : literals) {
+    addClause({-y, lit});
+    clause.push_back(-lit);
+  }
+  addClause(clause);
+  return y;
+}
+
+int CNFLogicBlock::orLiteral(std::vector<int> inputs) {
+  for (auto& lit : inputs) {
+    lit = -lit;
+  }
+  return -andLiteral(std::move(inputs));
+}
+
+int CNFLogicBlock::xorLiteral(const int a, const int b) {
+  if (a == TRUE_LITERAL || a == -TRUE_LITERAL) {
+    return a == TRUE_LITERAL ? -b : b;
+  }
+  if (b == TRUE_LITERAL || b == -TRUE_LITERAL) {
+    return b == TRUE_LITERAL ? -a : a;
+  }
+  if (a == b) {
+    return -TRUE_LITERAL;
+  }
+  if (a == -b) {
+    return TRUE_LITERAL;
+  }
+  const auto y = newVariable();
+  addClause({-y, a, b});
+  addClause({-y, -a, -b});
+  addClause({y, -a, b});
+  addClause({y, a, -b});
+  return y;
+}
+
+int CNFLogicBlock::iteLiteral(const int c, const int t, const int e) {
+  if (c == TRUE_LITERAL) {
+    return t;
+  }
+  if (c == -TRUE_LITERAL) {
+    return e;
+  }
+  if (t == e) {
+    return t;
+  }
+  const auto y = newVariable();
+  addClause({-c, -t, y});
+  addClause({-c, t, -y});
+  addClause({c, -e, y});
+  addClause({c, e, -y});
+  return y;
+}
+
+int CNFLogicBlock::equalBits(std::vector<int> a, std::vector<int> b) {
+  const auto width = std::max(a.size(), b.size());
+  a.resize(width, -TRUE_LITERAL);
+  b.resize(width, -TRUE_LITERAL);
+  std::vector<int> equal;
+  equal.reserve(width);
+  for (std::size_t i = 0U; i < width; ++i) {
+    equal.push_back(-xorLiteral(a[i], b[i]));
+  }
+  return andLiteral(std::move(equal));
+}
+
+int CNFLogicBlock::literal(const LogicTerm& a) {
+  const auto encoding = encode(a);
+  if (encoding.size() != 1U) {
+    unsupported("Expected a Boolean term");
+  }
+  return encoding.front();
+}
+
+std::vector<int> CNFLogicBlock::bits(const LogicTerm& a) { return encode(a); }
+
+std::vector<int> CNFLogicBlock::encode(const LogicTerm& a) {
+  if (a.getOpType() == OpType::Constant) {
+    if (a.getCType() == CType::BITVECTOR) {
+      const auto words = a.getBitVectorWords();
+      std::vector<int> result(a.getBitVectorSize());
+      for (std::size_t i = 0U; i < result.size(); ++i) {
+        const auto bit = (words[i / 64U] >> (i % 64U)) & 1U;
+        result[i] = bit != 0U ? TRUE_LITERAL : -TRUE_LITERAL;
+      }
+      return result;
+    }
+    if (isNumeric(a)) {
+      unsupported("Numbers are only supported in comparisons");
+    }
+    return {a.getBoolValue() ? TRUE_LITERAL : -TRUE_LITERAL};
+  }
+
+  // ids are only unique among the terms of this block
+  const auto cacheable = a.getLogic() == this;
+  if (cacheable) {
+    if (const auto it = encoded.find(a.getID()); it != encoded.end()) {
+      return it->second;
+    }
+  }
+
+  const auto& nodes = a.getNodes();
+  std::vector<int> result;
+  switch (a.getOpType()) {
+  case OpType::Variable:
+    if (a.getCType() == CType::BOOL) {
+      result.push_back(newVariable());
+    } else if (a.getCType() == CType::BITVECTOR) {
+      for (std::size_t i = 0U; i < a.getBitVectorSize(); ++i) {
+        result.push_back(newVariable());
+      }
+    } else {
+      unsupported("Unsupported type");
+    }
+    break;
+  case OpType::AND:
+  case OpType::OR: {
+    std::vector<int> inputs;
+    inputs.reserve(nodes.size());
+    for (const auto& node : nodes) {
+      inputs.push_back(literal(node));
+    }
+    result.push_back(a.getOpType() == OpType::AND
+                         ? andLiteral(std::move(inputs))
+                         : orLiteral(std::move(inputs)));
+  } break;
+  case OpType::NEG:
+    result = encode(nodes[0]);
+    for (auto& lit : result) {
+      lit = -lit;
+    }
+    break;
+  case OpType::IMPL:
+    result.push_back(orLiteral({-literal(nodes[0]), literal(nodes[1])}));
+    break;
+  case OpType::ITE: {
+    const auto c = literal(nodes[0]);
+    auto t = encode(nodes[1]);
+    auto e = encode(nodes[2]);
+    const auto width = std::max(t.size(), e.size());
+    t.resize(width, -TRUE_LITERAL);
+    e.resize(width, -TRUE_LITERAL);
+    for (std::size_t i = 0U; i < width; ++i) {
+      result.push_back(iteLiteral(c, t[i], e[i]));
+    }
+  } break;
+  case OpType::EQ:
+  case OpType::XOR:
+    if (isNumeric(nodes[0]) || isNumeric(nodes[1])) {
+      result.push_back(encodeComparison(a));
+    } else {
+      const auto equal = equalBits(encode(nodes[0]), encode(nodes[1]));
+      result.push_back(a.getOpType() == OpType::EQ ? equal : -equal);
+    }
+    break;
+  case OpType::BitEq:
+    result.push_back(equalBits(encode(nodes[0]), encode(nodes[1])));
+    break;
+  case OpType::GT:
+  case OpType::LT:
+  case OpType::GTE:
+  case OpType::LTE:
+    result.push_back(encodeComparison(a));
+    break;
+  case OpType::BitAnd:
+  case OpType::BitOr:
+  case OpType::BitXor:
+    result = encodeBitwise(a);
+    break;
+  default:
+    unsupported("Unsupported operation");
+  }
+
+  if (cacheable) {
+    encoded.emplace(a.getID(), result);
+  }
+  return result;
+}
+
+std::vector<int> CNFLogicBlock::encodeBitwise(const LogicTerm& a) {
+  std::vector<std::vector<int>> operands;
+  std::size_t width = 0U;
+  for (const auto& node : a.getNodes()) {
+    operands.emplace_back(encode(node));
+    width = std::max(width, operands.back().size());
+  }
+  std::vector<int> result;
+  result.reserve(width);
+  for (std::size_t i = 0U; i < width; ++i) {
+    std::vector<int> inputs;
+    inputs.reserve(operands.size());
+    for (const auto& operand : operands) {
+      inputs.push_back(i < operand.size() ? operand[i] : -TRUE_LITERAL);
+    }
+    if (a.getOpType() == OpType::BitAnd) {
+      result.push_back(andLiteral(std::move(inputs)));
+    } else if (a.getOpType() == OpType::BitOr) {
+      result.push_back(orLiteral(std::move(inputs)));
+    } else {
+      auto bit = -TRUE_LITERAL;
+      for (const auto lit : inputs) {
+        bit = xorLiteral(bit, lit);
+      }
+      result.push_back(bit);
+    }
+  }
+  return result;
+}
+
+void CNFLogicBlock::collectSum(const LogicTerm& a, const bool negative,
+                               std::vector<int>& inputs, std::int64_t& offset) {
+  const std::int64_t sign = negative ? -1 : 1;
+  // -x = (1 - x) - 1 keeps all inputs positive
+  const auto addLiteral = [&](const int lit) {
+    if (negative) {
+      inputs.push_back(-lit);
+      offset -= 1;
+    } else {
+      inputs.push_back(lit);
+    }
+  };
+
+  if (a.getOpType() == OpType::Constant) {
+    offset += sign * (a.getCType() == CType::BOOL
+                          ? static_cast<std::int64_t>(a.getBoolValue())
+                          : static_cast<std::int64_t>(a.getIntValue()));
+    return;
+  }
+  const auto& nodes = a.getNodes();
+  switch (a.getOpType()) {
+  case OpType::ADD:
+    for (const auto& node : nodes) {
+      collectSum(node, negative, inputs, offset);
+    }
+    break;
+  case OpType::SUB:
+    for (std::size_t i = 0U; i < nodes.size(); ++i) {
+      collectSum(nodes[i], i == 0U ? negative : !negative, inputs, offset);
+    }
+    break;
+  case OpType::ITE:
+    // ite(c, t, e) with constants differing by at most one is e + (t - e) * c
+    if (isNumeric(a) && nodes[1].getOpType() == OpType::Constant &&
+        nodes[2].getOpType() == OpType::Constant) {
+      const std::int64_t t = nodes[1].getIntValue();
+      const std::int64_t e = nodes[2].getIntValue();
+      if (t == e) {
+        offset += sign * e;
+      } else if (t - e == 1) {
+        offset += sign * e;
+        addLiteral(literal(nodes[0]));
+      } else if (t - e == -1) {
+        offset += sign * t;
+        addLiteral(-literal(nodes[0]));
+      } else {
+        unsupported("Only sums of Boolean terms are supported");
+      }
+      break;
+    }
+    [[fallthrough]];
+  default:
+    if (isNumeric(a) || a.getCType() == CType::BITVECTOR) {
+      unsupported("Only sums of Boolean terms are supported");
+    }
+    addLiteral(literal(a));
+  }
+}
+
+int CNFLogicBlock::encodeComparison(const LogicTerm& a) {
+  // the comparison is rewritten to `sum(inputs) OP -offset`
+  std::vector<int> inputs;
+  std::int64_t offset = 0;
+  collectSum(a.getNodes()[0], false, inputs, offset);
+  collectSum(a.getNodes()[1], true, inputs, offset);
+  const auto k = -offset;
+
+  const std::vector<int>* outputs = nullptr;
+  const auto atLeast = [&](const std::int64_t j) {
+    if (j <= 0) {
+      return TRUE_LITERAL;
+    }
+    if (j > static_cast<std::int64_t>(inputs.size())) {
+      return -TRUE_LITERAL;
+    }
+    if (outputs == nullptr) {
+      outputs = &counter(inputs);
+    }
+    return (*outputs)[static_cast<std::size_t>(j - 1)];
+  };
+
+  switch (a.getOpType()) {
+  case OpType::GTE:
+    return atLeast(k);
+  case OpType::GT:
+    return atLeast(k + 1);
+  case OpType::LTE:
+    return -atLeast(k + 1);
+  case OpType::LT:
+    return -atLeast(k);
+  case OpType::EQ:
+    return andLiteral({atLeast(k), -atLeast(k + 1)});
+  case OpType::XOR:
+    return -andLiteral({atLeast(k), -atLeast(k + 1)});
+  default:
+    unsupported("Unsupported operation");
+  }
+}
+
+const std::vector<int>& CNFLogicBlock::counter(std::vector<int> inputs) {
+  std::sort(inputs.begin(), inputs.end());
+  if (const auto it = counters.find(inputs); it != counters.end()) {
+    return it->second;
+  }
+  auto outputs = totalize(inputs, 0U, inputs.size());
+  return counters.emplace(std::move(inputs), std::move(outputs)).first->second;
+}
+
+std::vector<int> CNFLogicBlock::totalize(const std::vector<int>& inputs,
+                                         const std::size_t begin,
+                                         const std::size_t end) {
+  if (end - begin == 1U) {
+    return {inputs[begin]};
+  }
+  const auto mid = begin + ((end - begin) / 2U);
+  const auto a = totalize(inputs, begin, mid);
+  const auto b = totalize(inputs, mid, end);
+
+  std::vector<int> r(a.size() + b.size());
+  for (auto& lit : r) {
+    lit = newVariable();
+  }
+  // r[i + j - 1] iff at least i of a and j of b hold (with a[-1] = b[-1] = 1)
+  for (std::size_t i = 0U; i <= a.size(); ++i) {
+    for (std::size_t j = 0U; j <= b.size(); ++j) {
+      if (i + j > 0U) {
+        std::vector<int> up{r[i + j - 1]};
+        if (i > 0U) {
+          up.push_back(-a[i - 1]);
+        }
+        if (j > 0U) {
+          up.push_back(-b[j - 1]);
+        }
+        addClause(up);
+      }
+      if (i + j < r.size()) {
+        std::vector<int> down{-r[i + j]};
+        if (i < a.size()) {
+          down.push_back(a[i]);
+        }
+        if (j < b.size()) {
+          down.push_back(b[j]);
+        }
+        addClause(down);
+      }
+    }
+  }
+  return r;
+}
+
+void CNFLogicBlock::assertTerm(const LogicTerm& a) {
+  switch (a.getOpType()) {
+  case OpType::AND:
+    for (const auto& node : a.getNodes()) {
+      assertTerm(node);
+    }
+    break;
+  case OpType::OR: {
+    std::vector<int> clause;
+    for (const auto& node : a.getNodes()) {
+      clause.push_back(literal(node));
+    }
+    addClause(clause);
+  } break;
+  case OpType::IMPL:
+    addClause({-literal(a.getNodes()[0]), literal(a.getNodes()[1])});
+    break;
+  default:
+    addClause({literal(a)});
+  }
+}
+
+void CNFLogicBlock::assertFormula(const LogicTerm& a) {
+  if (convertWhenAssert) {
+    assertTerm(a);
+  } else {
+    LogicBlock::assertFormula(a);
+  }
+}
+
+void CNFLogicBlock::produceInstance() {
+  for (const auto& clause : clauses) {
+    assertTerm(clause);
+  }
+  clauses.clear();
+}
+
+Result CNFLogicBlock::solve() { return solve(LogicVector{}); }
+
+Result CNFLogicBlock::solve(const LogicVector& assumptions) {
+  produceInstance();
+  std::vector<int> literals;
+  literals.reserve(assumptions.size());
+  for (const auto& assumption : assumptions) {
+    literals.push_back(literal(assumption));
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  delete model;
+  model = nullptr;
+  return solverCommand.empty() ? solveInternal(literals)
+                               : solveExternal(literals);
+}
+
+void CNFLogicBlock::setConflictLimit(const std::size_t limit) {
+  if (!solverCommand.empty()) {
+    throw std::invalid_argument(
+        "The conflict limit is not supported by external SAT solvers");
+  }
+  conflictLimit = limit;
+}
+
+void CNFLogicBlock::setTimeout(const std::chrono::milliseconds t) {
+  if (!solverCommand.empty()) {
+    throw std::invalid_argument(
+        "The timeout is not supported by external SAT solvers");
+  }
+  timeout = t;
+}
+
+Result CNFLogicBlock::solveInternal(const std::vector<int>& assumptions) {
+  // the built-in solver keeps the clauses passed before
+  solver.reserveVariables(nVariables);
+  std::vector<int> clause;
+  for (; passedLiterals < clauseBuffer.size(); ++passedLiterals) {
+    if (clauseBuffer[passedLiterals] == 0) {
+      solver.addClause(clause);
+      clause.clear();
+    } else {
+      clause.push_back(clauseBuffer[passedLiterals]);
+    }
+  }
+
+  solver.setConflictLimit(conflictLimit);
+  solver.setTimeout(timeout);
+  const auto res = solver.solve(assumptions);
+  if (res == Result::SAT) {
+    setModel(solver.getModel());
+  }
+  return res;
+}
+
+Result CNFLogicBlock::solveExternal(const std::vector<int>& assumptions) {
+  std::random_device rd;
+  const auto path = std::filesystem::temp_directory_path() /
+                    ("qmap_" + std::to_string(rd()) + ".cnf");
+  {
+    std::ofstream ofs(path);
+    if (!ofs.good()) {
+      unsupported("Could not write DIMACS file");
+    }
+    dumpDIMACS(ofs, assumptions);
+  }
+
+  FILE* process = openProcess(solverCommand + " \"" + path.string() + "\"");
+  if (process == nullptr) {
+    std::filesystem::remove(path);
+    unsupported("Could not run SAT solver");
+  }
+  std::string output;
+  std::array<char, 4096> buffer{};
+  while (std::fgets(buffer.data(), static_cast<int>(buffer.size()), process) !=
+         nullptr) {
+    output += buffer.data();
+  }
+  const auto exitCode = closeProcess(process);
+  std::filesystem::remove(path);
+  // solvers report the result by their exit code; others exit with 0
+  if (exitCode != 0 && exitCode != EXIT_SATISFIABLE &&
+      exitCode != EXIT_UNSATISFIABLE) {
+    unsupported("SAT solver failed");
+  }
+
+  auto res = Result::NDEF;
+  std::vector<bool> assignment(nVariables + 1U, false);
+  std::istringstream iss(output);
+  std::string line;
+  while (std::getline(iss, line)) {
+    if (line.rfind("s ", 0) == 0) {
+      if (line.find("UNSATISFIABLE") != std::string::npos) {
+        res = Result::UNSAT;
+      } else if (line.find("SATISFIABLE") != std::string::npos) {
+        res = Result::SAT;
+      }
+    } else if (line.rfind("v ", 0) == 0) {
+      std::istringstream values(line.substr(2U));
+      int lit = 0;
+      while (values >> lit) {
+        if (lit > 0 && static_cast<std::size_t>(lit) <= nVariables) {
+          assignment[static_cast<std::size_t>(lit)] = true;
+        }
+      }
+    }
+  }
+  if (res == Result::NDEF) {
+    unsupported("SAT solver did not report a result");
+  }
+  if (res == Result::SAT) {
+    setModel(std::move(assignment));
+  }
+  return res;
+}
+
+void CNFLogicBlock::setModel(std::vector<bool> assignment) {
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  model = new CNFModel(std::move(assignment));
+}
+
+void CNFLogicBlock::dumpDIMACS(std::ostream& os,
+                               const std::vector<int>& assumptions) const {
+  os << "p cnf " << nVariables << " " << nClauses + assumptions.size()
+     << "\n";
+  bool first = true;
+  for (const auto lit : clauseBuffer) {
+    if (lit == 0) {
+      os << (first ? "0\n" : " 0\n");
+      first = true;
+    } else {
+      os << (first ? "" : " ") << lit;
+      first = false;
+    }
+  }
+  for (const auto lit : assumptions) {
+    os << lit << " 0\n";
+  }
+}
+
+std::string CNFLogicBlock::dumpInternalSolver() {
+  produceInstance();
+  std::stringstream ss;
+  dumpDIMACS(ss);
+  return ss.str();
+}
+
+void CNFLogicBlock::internalReset() { initialize(); }
+
+bool CNFLogicBlock::value(const int lit, const std::vector<bool>& assignment) {
+  const auto v = static_cast<std::size_t>(lit > 0 ? lit : -lit);
+  const bool assigned = v < assignment.size() && assignment[v];
+  return lit > 0 ? assigned : !assigned;
+}
+
+std::vector<bool>
+CNFLogicBlock::evaluateBits(const LogicTerm& a,
+                            const std::vector<bool>& assignment) {
+  std::vector<bool> result;
+  const auto& nodes = a.getNodes();
+  switch (a.getOpType()) {
+  case OpType::Constant:
+    if (a.getCType() == CType::BITVECTOR) {
+      const auto words = a.getBitVectorWords();
+      for (std::size_t i = 0U; i < a.getBitVectorSize(); ++i) {
+        result.push_back(((words[i / 64U] >> (i % 64U)) & 1U) != 0U);
+      }
+      return result;
+    }
+    break;
+  case OpType::Variable:
+    if (a.getCType() == CType::BITVECTOR) {
+      const auto it = encoded.find(a.getID());
+      if (a.getLogic() != this || it == encoded.end()) {
+        // never used in a formula, hence unconstrained
+        return std::vector<bool>(a.getBitVectorSize(), false);
+      }
+      for (const auto lit : it->second) {
+        result.push_back(value(lit, assignment));
+      }
+      return result;
+    }
+    break;
+  case OpType::NEG:
+    if (a.getCType() == CType::BITVECTOR) {
+      result = evaluateBits(nodes[0], assignment);
+      result.flip();
+      return result;
+    }
+    break;
+  case OpType::ITE:
+    if (a.getCType() == CType::BITVECTOR) {
+      return evaluateBits(evaluateNumber(nodes[0], assignment) != 0 ? nodes[1]
+                                                                    : nodes[2],
+                          assignment);
+    }
+    break;
+  case OpType::BitAnd:
+  case OpType::BitOr:
+  case OpType::BitXor: {
+    std::vector<std::vector<bool>> operands;
+    std::size_t width = 0U;
+    for (const auto& node : nodes) {
+      operands.emplace_back(evaluateBits(node, assignment));
+      width = std::max(width, operands.back().size());
+    }
+    result.assign(width, a.getOpType() == OpType::BitAnd);
+    for (auto& operand : operands) {
+      operand.resize(width, false);
+      for (std::size_t i = 0U; i < width; ++i) {
+        if (a.getOpType() == OpType::BitAnd) {
+          result[i] = result[i] && operand[i];
+        } else if (a.getOpType() == OpType::BitOr) {
+          result[i] = result[i] || operand[i];
+        } else {
+          result[i] = result[i] != operand[i];
+        }
+      }
+    }
+    return result;
+  }
+  default:
+    break;
+  }
+  // a Boolean term used as a bitvector of width one
+  return {evaluateNumber(a, assignment) != 0};
+}
+
+std::int64_t
+CNFLogicBlock::evaluateNumber(const LogicTerm& a,
+                              const std::vector<bool>& assignment) {
+  if (a.getCType() == CType::BITVECTOR) {
+    const auto b = evaluateBits(a, assignment);
+    std::uint64_t word = 0U;
+    for (std::size_t i = 0U; i < std::min<std::size_t>(b.size(), 64U); ++i) {
+      word |= static_cast<std::uint64_t>(b[i]) << i;
+    }
+    return static_cast<std::int64_t>(word);
+  }
+
+  const auto& nodes = a.getNodes();
+  const auto number = [&](const std::size_t i) {
+    return evaluateNumber(nodes[i], assignment);
+  };
+  const auto equal = [&]() {
+    if (nodes[0].getCType() == CType::BITVECTOR ||
+        nodes[1].getCType() == CType::BITVECTOR) {
+      auto x = evaluateBits(nodes[0], assignment);
+      auto y = evaluateBits(nodes[1], assignment);
+      const auto width = std::max(x.size(), y.size());
+      x.resize(width, false);
+      y.resize(width, false);
+      return x == y;
+    }
+    return number(0) == number(1);
+  };
+
+  switch (a.getOpType()) {
+  case OpType::Constant:
+    return a.getCType() == CType::BOOL
+               ? static_cast<std::int64_t>(a.getBoolValue())
+               : static_cast<std::int64_t>(a.getIntValue());
+  case OpType::Variable: {
+    if (a.getCType() != CType::BOOL) {
+      unsupported("Unsupported type");
+    }
+    const auto it = encoded.find(a.getID());
+    if (a.getLogic() != this || it == encoded.end()) {
+      return 0;
+    }
+    return static_cast<std::int64_t>(value(it->second.front(), assignment));
+  }
+  case OpType::AND:
+    return static_cast<std::int64_t>(
+        std::all_of(nodes.begin(), nodes.end(), [&](const LogicTerm& node) {
+          return evaluateNumber(node, assignment) != 0;
+        }));
+  case OpType::OR:
+    return static_cast<std::int64_t>(
+        std::any_of(nodes.begin(), nodes.end(), [&](const LogicTerm& node) {
+          return evaluateNumber(node, assignment) != 0;
+        }));
+  case OpType::NEG:
+    return static_cast<std::int64_t>(number(0) == 0);
+  case OpType::IMPL:
+    return static_cast<std::int64_t>(number(0) == 0 || number(1) != 0);
+  case OpType::ITE:
+    return number(0) != 0 ? number(1) : number(2);
+  case OpType::EQ:
+  case OpType::BitEq:
+    return static_cast<std::int64_t>(equal());
+  case OpType::XOR:
+    return static_cast<std::int64_t>(!equal());
+  case OpType::ADD: {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0U; i < nodes.size(); ++i) {
+      sum += number(i);
+    }
+    return sum;
+  }
+  case OpType::SUB: {
+    std::int64_t difference = number(0);
+    for (std::size_t i = 1U; i < nodes.size(); ++i) {
+      difference -= number(i);
+    }
+    return difference;
+  }
+  case OpType::GT:
+    return static_cast<std::int64_t>(number(0) > number(1));
+  case OpType::LT:
+    return static_cast<std::int64_t>(number(0) < number(1));
+  case OpType::GTE:
+    return static_cast<std::int64_t>(number(0) >= number(1));
+  case OpType::LTE:
+    return static_cast<std::int64_t>(number(0) <= number(1));
+  default:
+    unsupported("Unsupported operation");
+  }
+}
+
+} // namespace cnflogic
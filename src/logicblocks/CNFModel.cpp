@@ -0,0 +1,53 @@
+#include "CNFModel.hpp"
+
+#include "CNFLogic.hpp"
+#include "LogicBlock.hpp"
+#include "LogicTerm.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace cnflogic {
+
+namespace {
+CNFLogicBlock& getBlock(LogicBlock* lb) {
+  auto* const block = dynamic_cast<CNFLogicBlock*>(lb);
+  if (block == nullptr) {
+    throw std::runtime_error("Model does not belong to a CNF logic block");
+  }
+  return *block;
+}
+} // namespace
+
+bool CNFModel::getBoolValue(const LogicTerm& a, LogicBlock* lb) {
+  return getBlock(lb).evaluateNumber(a, assignment) != 0;
+}
+
+int32_t CNFModel::getIntValue(const LogicTerm& a, LogicBlock* lb) {
+  return static_cast<int32_t>(getBlock(lb).evaluateNumber(a, assignment));
+}
+
+double CNFModel::getRealValue(const LogicTerm& a, LogicBlock* lb) {
+  return static_cast<double>(getBlock(lb).evaluateNumber(a, assignment));
+}
+
+uint64_t CNFModel::getBitvectorValue(const LogicTerm& a, LogicBlock* lb) {
+  return getBitvectorWords(a, lb).front();
+}
+
+std::vector<uint64_t> CNFModel::getBitvectorWords(const LogicTerm& a,
+                                                  LogicBlock* lb) {
+  const auto bits = getBlock(lb).evaluateBits(a, assignment);
+  std::vector<uint64_t> words(std::max<std::size_t>((bits.size() + 63U) / 64U,
+                                                    1U));
+  for (std::size_t i = 0U; i < bits.size(); ++i) {
+    if (bits[i]) {
+      words[i / 64U] |= uint64_t{1} << (i % 64U);
+    }
+  }
+  return words;
+}
+} // namespace cnflogic
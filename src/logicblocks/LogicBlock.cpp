@@ -33,6 +33,7 @@ void LogicBlock::reset() {
   model = nullptr;
   clauses.clear();
   internalReset();
+  termTable.clear();
   gid = 0U;
 }
 
@@ -41,6 +42,7 @@ void LogicBlockOptimizer::reset() {
   clauses.clear();
   weightedTerms.clear();
   internalReset();
+  termTable.clear();
   gid = 0U;
 }
 
@@ -6,8 +6,11 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
@@ -101,8 +104,59 @@ std::string LogicTerm::getStrRep(OpType op) {
   return os.str();
 }
 
-LogicTerm::LogicTerm(const OpType op, const LogicTerm& a, const LogicTerm& b)
-    : lb(getValidLogicPtr(a, b)) {
+LogicTerm::Node& LogicTerm::init() {
+  auto created = std::make_shared<Node>();
+  auto& n = *created;
+  node = std::move(created);
+  return n;
+}
+
+LogicTerm::LogicTerm(const bool v) {
+  auto& n = init();
+  n.opType = OpType::Constant;
+  n.value = v;
+}
+
+LogicTerm::LogicTerm(const int32_t v) {
+  auto& n = init();
+  n.opType = OpType::Constant;
+  n.iValue = v;
+  n.cType = CType::INT;
+}
+
+LogicTerm::LogicTerm(const double v) {
+  auto& n = init();
+  n.opType = OpType::Constant;
+  n.fValue = v;
+  n.cType = CType::REAL;
+}
+
+LogicTerm::LogicTerm(const uint64_t v, const uint16_t bvs) {
+  auto& n = init();
+  n.opType = OpType::Constant;
+  n.bvValue = v;
+  n.bvSize = bvs;
+  n.cType = CType::BITVECTOR;
+}
+
+LogicTerm::LogicTerm(const std::vector<uint64_t>& words, const uint16_t bvs) {
+  auto& n = init();
+  n.opType = OpType::Constant;
+  n.bvValue = words.empty() ? 0U : words.front();
+  n.bvSize = bvs;
+  n.cType = CType::BITVECTOR;
+  if (bvs > 64U) {
+    n.bvWords = words;
+    n.bvWords.resize((bvs + 63U) / 64U, 0U);
+    if (const auto rest = bvs % 64U; rest != 0U) {
+      n.bvWords.back() &= (uint64_t{1} << rest) - 1U;
+    }
+  }
+}
+
+LogicTerm::LogicTerm(const OpType op, const LogicTerm& a,
+                     const LogicTerm& b) {
+  auto* const lb = getValidLogicPtr(a, b);
   if (a.isConst() || b.isConst()) {
     *this = combineConst(a, b, op, lb);
     return;
@@ -136,38 +190,90 @@ uint64_t LogicTerm::getNextId(Logic* logic) {
 
 LogicTerm::LogicTerm(OpType op, const std::initializer_list<LogicTerm>& n,
                      CType type, Logic* logic)
-    : lb(logic), id(getNextId(logic)), depth(getMax(n)), name(getStrRep(op)),
-      opType(op), bvSize(getMaxBVSize(n)), nodes(n), cType(type) {}
+    : LogicTerm(op, std::vector<LogicTerm>(n), type, logic) {}
 
 LogicTerm::LogicTerm(OpType op, const std::vector<LogicTerm>& n, CType type,
-                     Logic* logic)
-    : lb(logic), id(getNextId(logic)), depth(getMax(n)), name(getStrRep(op)),
-      opType(op), bvSize(getMaxBVSize(n)), nodes(n), cType(type) {}
+                     Logic* logic) {
+  auto* const table = logic != nullptr ? logic->getTermTable() : nullptr;
+  if (table != nullptr) {
+    if (auto shared = table->find(op, n, type)) {
+      node = std::move(shared);
+      return;
+    }
+  }
+  // not created by `init`, since the table only keeps weak references which
+  // would retain the memory of a combined allocation
+  auto created = std::shared_ptr<Node>(new Node());
+  created->lb = logic;
+  created->id = getNextId(logic);
+  created->depth = getMax(n);
+  created->name = getStrRep(op);
+  created->opType = op;
+  created->bvSize = getMaxBVSize(n);
+  created->nodes = n;
+  created->cType = type;
+  node = std::move(created);
+  if (table != nullptr) {
+    table->insert(node);
+  }
+}
 
-LogicTerm::LogicTerm(Logic* logic)
-    : lb(logic), id(getNextId(lb)), name(std::to_string(id)) {}
+LogicTerm::LogicTerm(Logic* logic) {
+  auto& t = init();
+  t.lb = logic;
+  t.id = getNextId(logic);
+  t.name = std::to_string(t.id);
+}
 
-LogicTerm::LogicTerm(std::string n, Logic* logic)
-    : lb(logic), id(getNextId(lb)), name(std::move(n)) {}
+LogicTerm::LogicTerm(std::string n, Logic* logic) {
+  auto& t = init();
+  t.lb = logic;
+  t.id = getNextId(logic);
+  t.name = std::move(n);
+}
 
 LogicTerm::LogicTerm(OpType op, std::string n, CType type,
-                     Logic* logic) // potentially , uint16_t bvs = 0
-    : lb(logic), id(getNextId(lb)), name(std::move(n)), opType(op),
-      cType(type) {}
+                     Logic* logic) { // potentially , uint16_t bvs = 0
+  auto& t = init();
+  t.lb = logic;
+  t.id = getNextId(logic);
+  t.name = std::move(n);
+  t.opType = op;
+  t.cType = type;
+}
 
-LogicTerm::LogicTerm(std::string n, const uint64_t identifier, Logic* logic)
-    : lb(logic), id(identifier), name(std::move(n)) {}
+LogicTerm::LogicTerm(std::string n, const uint64_t identifier, Logic* logic) {
+  auto& t = init();
+  t.lb = logic;
+  t.id = identifier;
+  t.name = std::move(n);
+}
 
-LogicTerm::LogicTerm(CType type, Logic* logic)
-    : lb(logic), id(getNextId(lb)), name(std::to_string(id)), cType(type) {}
+LogicTerm::LogicTerm(CType type, Logic* logic) {
+  auto& t = init();
+  t.lb = logic;
+  t.id = getNextId(logic);
+  t.name = std::to_string(t.id);
+  t.cType = type;
+}
 
-LogicTerm::LogicTerm(std::string n, CType type, Logic* logic, uint16_t bvs)
-    : lb(logic), id(getNextId(lb)), name(std::move(n)), bvSize(bvs),
-      cType(type) {}
+LogicTerm::LogicTerm(std::string n, CType type, Logic* logic, uint16_t bvs) {
+  auto& t = init();
+  t.lb = logic;
+  t.id = getNextId(logic);
+  t.name = std::move(n);
+  t.bvSize = bvs;
+  t.cType = type;
+}
 
 LogicTerm::LogicTerm(std::string n, const uint64_t identifier, CType type,
-                     Logic* logic)
-    : lb(logic), id(identifier), name(std::move(n)), cType(type) {}
+                     Logic* logic) {
+  auto& t = init();
+  t.lb = logic;
+  t.id = identifier;
+  t.name = std::move(n);
+  t.cType = type;
+}
 
 LogicTerm LogicTerm::noneTerm() {
   return {OpType::None, "None", CType::BOOL, nullptr};
@@ -309,67 +415,83 @@ LogicTerm LogicTerm::operator!() const { return LogicTerm::neg(*this); }
 bool LogicTerm::isConst() const { return getOpType() == OpType::Constant; }
 
 bool LogicTerm::getBoolValue() const {
-  switch (cType) {
+  switch (node->cType) {
   case CType::BOOL:
-    return value;
+    return node->value;
   case CType::INT:
-    return iValue != 0;
+    return node->iValue != 0;
   case CType::REAL:
-    return fValue != 0;
+    return node->fValue != 0;
   case CType::BITVECTOR:
-    return bvValue != 0;
+    return node->bvValue != 0 ||
+           std::any_of(node->bvWords.begin(), node->bvWords.end(),
+                       [](const uint64_t w) { return w != 0U; });
   default:
     return false;
   }
 }
 
 int LogicTerm::getIntValue() const {
-  switch (cType) {
+  switch (node->cType) {
   case CType::BOOL:
-    return value ? 1 : 0;
+    return node->value ? 1 : 0;
   case CType::INT:
-    return iValue;
+    return node->iValue;
   case CType::REAL:
-    return static_cast<int32_t>(std::floor(fValue));
+    return static_cast<int32_t>(std::floor(node->fValue));
   case CType::BITVECTOR:
-    return static_cast<int>(bvValue);
+    return static_cast<int>(node->bvValue);
   default:
     return std::numeric_limits<int>::infinity();
   }
 }
 
 double LogicTerm::getFloatValue() const {
-  switch (cType) {
+  switch (node->cType) {
   case CType::BOOL:
-    return value ? 1.0 : 0.0;
+    return node->value ? 1.0 : 0.0;
   case CType::INT:
-    return iValue;
+    return node->iValue;
   case CType::REAL:
-    return fValue;
+    return node->fValue;
   case CType::BITVECTOR:
-    return static_cast<double>(bvValue);
+    return static_cast<double>(node->bvValue);
   default:
     return std::numeric_limits<double>::infinity();
   }
 }
 
 uint64_t LogicTerm::getBitVectorValue() const {
-  switch (cType) {
+  switch (node->cType) {
   case CType::BOOL:
-    return value ? 1.0 : 0.0;
+    return node->value ? 1.0 : 0.0;
   case CType::INT:
-    return static_cast<uint64_t>(iValue);
+    return static_cast<uint64_t>(node->iValue);
   case CType::REAL:
-    return static_cast<uint64_t>(fValue);
+    return static_cast<uint64_t>(node->fValue);
   case CType::BITVECTOR:
-    return bvValue & (static_cast<uint64_t>(std::pow(2, bvSize)) - 1U);
+    if (node->bvSize >= 64U) {
+      return node->bvValue;
+    }
+    return node->bvValue & ((uint64_t{1} << node->bvSize) - 1U);
   default:
     return std::numeric_limits<uint64_t>::infinity();
   }
 }
 
+std::vector<uint64_t> LogicTerm::getBitVectorWords() const {
+  if (!node->bvWords.empty()) {
+    return node->bvWords;
+  }
+  std::vector<uint64_t> words((getBitVectorSize() + 63U) / 64U, 0U);
+  if (!words.empty()) {
+    words.front() = getBitVectorValue();
+  }
+  return words;
+}
+
 uint16_t LogicTerm::getBitVectorSize() const {
-  switch (cType) {
+  switch (node->cType) {
   case CType::BOOL:
     return 1U;
   case CType::INT:
@@ -377,13 +499,16 @@ uint16_t LogicTerm::getBitVectorSize() const {
   case CType::REAL:
     return 256U;
   case CType::BITVECTOR:
-    return bvSize;
+    return node->bvSize;
   default:
     return std::numeric_limits<uint16_t>::infinity();
   }
 }
 
 bool LogicTerm::deepEquals(const LogicTerm& other) const {
+  if (node == other.node) {
+    return true;
+  }
   if (getOpType() == OpType::Variable && getID() == other.getID()) {
     return true;
   }
@@ -670,6 +795,77 @@ uint16_t LogicTerm::getMaxBVSize(const std::vector<LogicTerm>& terms) {
   return ret;
 }
 
+std::shared_ptr<const LogicTerm::Node>
+TermTable::find(const OpType op, const std::vector<LogicTerm>& nodes,
+                const CType type) {
+  const auto [begin, end] = entries.equal_range(hash(op, nodes, type));
+  for (auto it = begin; it != end;) {
+    auto candidate = it->second.lock();
+    if (candidate == nullptr) {
+      it = entries.erase(it);
+      continue;
+    }
+    if (candidate->opType == op && candidate->cType == type &&
+        std::equal(nodes.begin(), nodes.end(), candidate->nodes.begin(),
+                   candidate->nodes.end(), sameTerm)) {
+      return candidate;
+    }
+    ++it;
+  }
+  return nullptr;
+}
+
+void TermTable::insert(const std::shared_ptr<const LogicTerm::Node>& node) {
+  if (entries.size() >= sweepSize) {
+    // drop the entries of freed terms, at most once per doubling of the table
+    for (auto it = entries.begin(); it != entries.end();) {
+      it = it->second.expired() ? entries.erase(it) : std::next(it);
+    }
+    sweepSize = std::max(MIN_SWEEP_SIZE, 2U * entries.size());
+  }
+  entries.emplace(hash(node->opType, node->nodes, node->cType), node);
+}
+
+void TermTable::clear() {
+  entries.clear();
+  sweepSize = MIN_SWEEP_SIZE;
+}
+
+std::size_t TermTable::hash(const OpType op,
+                            const std::vector<LogicTerm>& nodes,
+                            const CType type) {
+  auto combine = [](std::size_t& seed, const std::size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
+  };
+  std::size_t seed = static_cast<std::size_t>(op);
+  combine(seed, static_cast<std::size_t>(type));
+  for (const auto& t : nodes) {
+    if (t.isConst()) {
+      combine(seed, static_cast<std::size_t>(t.getCType()));
+      combine(seed, std::hash<double>{}(t.getFloatValue()));
+    } else {
+      combine(seed, t.getID());
+    }
+  }
+  return seed;
+}
+
+bool TermTable::sameTerm(const LogicTerm& a, const LogicTerm& b) {
+  if (a.node == b.node) {
+    return true;
+  }
+  if (a.isConst() != b.isConst()) {
+    return false;
+  }
+  if (a.isConst()) {
+    return a.getCType() == b.getCType() &&
+           a.getBitVectorSize() == b.getBitVectorSize() &&
+           TermHash{}(a, b);
+  }
+  return a.getID() == b.getID() && a.getLogic() == b.getLogic() &&
+         a.getCType() == b.getCType();
+}
+
 std::size_t TermHash::operator()(const LogicTerm& t) const {
   if (t.getOpType() == OpType::None) {
     throw std::runtime_error("Invalid OpType");
@@ -691,7 +887,10 @@ bool TermHash::operator()(const LogicTerm& t1, const LogicTerm& t2) const {
     case CType::REAL:
       return t1.getFloatValue() == t2.getFloatValue();
     case CType::BITVECTOR:
-      return t1.getBitVectorValue() == t2.getBitVectorValue();
+      if (t1.getBitVectorSize() <= 64U && t2.getBitVectorSize() <= 64U) {
+        return t1.getBitVectorValue() == t2.getBitVectorValue();
+      }
+      return t1.getBitVectorWords() == t2.getBitVectorWords();
     default:
       return false;
     }
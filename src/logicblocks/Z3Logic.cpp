@@ -217,6 +217,30 @@ Result Z3LogicBlock::solve() {
   return Result::UNSAT;
 }
 
+Result Z3LogicBlock::solve(const LogicVector& assumptions) {
+  // clauses only need to be passed to the solver once, since it keeps them
+  // for subsequent calls
+  if (!convertWhenAssert) {
+    produceInstance();
+  }
+  clauses.clear();
+
+  z3::expr_vector literals(*ctx);
+  for (const auto& assumption : assumptions) {
+    literals.push_back(convert(assumption, CType::BOOL));
+  }
+  const auto res = solver->check(literals);
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  delete model;
+  model = nullptr;
+  if (res == z3::sat) {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    model = new Z3Model(ctx, std::make_shared<z3::model>(solver->get_model()));
+    return Result::SAT;
+  }
+  return Result::UNSAT;
+}
+
 void Z3LogicBlock::internalReset() {
   variables.clear();
   cache.clear();
@@ -382,8 +406,21 @@ z3::expr Z3Base::convertConstant(const LogicTerm& a, CType toType) {
     return ctx->int_val(a.getIntValue());
   case logicbase::CType::REAL:
     return ctx->real_val(std::to_string(a.getFloatValue()).c_str());
-  case logicbase::CType::BITVECTOR:
-    return ctx->bv_val(a.getBitVectorValue(), a.getBitVectorSize());
+  case logicbase::CType::BITVECTOR: {
+    const auto size = a.getBitVectorSize();
+    if (size <= 64U) {
+      return ctx->bv_val(a.getBitVectorValue(), size);
+    }
+    // wider constants are concatenated from their 64-bit words
+    const auto words = a.getBitVectorWords();
+    const auto topWidth =
+        static_cast<unsigned>(size - (64U * (words.size() - 1U)));
+    auto res = ctx->bv_val(words.back(), topWidth);
+    for (auto i = words.size() - 1U; i > 0U; --i) {
+      res = z3::concat(res, ctx->bv_val(words[i - 1U], 64U));
+    }
+    return res;
+  }
   default:
     const auto* const msg = "Unsupported type";
     PLOG_FATAL << msg;
@@ -450,6 +487,31 @@ Result Z3LogicOptimizer::solve() {
   return Result::UNSAT;
 }
 
+Result Z3LogicOptimizer::solve(const LogicVector& assumptions) {
+  // clauses only need to be passed to the optimizer once, since it keeps them
+  // for subsequent calls
+  if (!convertWhenAssert) {
+    produceInstance();
+  }
+  clauses.clear();
+
+  z3::expr_vector literals(*ctx);
+  for (const auto& assumption : assumptions) {
+    literals.push_back(convert(assumption, CType::BOOL));
+  }
+  const auto res = optimizer->check(literals);
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  delete model;
+  model = nullptr;
+  if (res == z3::sat) {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    model =
+        new Z3Model(ctx, std::make_shared<z3::model>(optimizer->get_model()));
+    return Result::SAT;
+  }
+  return Result::UNSAT;
+}
+
 void Z3LogicOptimizer::internalReset() {
   weightedTerms.clear();
   variables.clear();
@@ -4,8 +4,11 @@
 #include "LogicTerm.hpp"
 #include "Z3Logic.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <z3++.h>
 
 namespace z3logic {
@@ -36,4 +39,19 @@ uint64_t Z3Model::getBitvectorValue(const LogicTerm& a, LogicBlock* lb) {
       model->eval(Z3Base::getExprTerm(a.getID(), a.getCType(), llb))
           .as_int64());
 }
+
+std::vector<uint64_t> Z3Model::getBitvectorWords(const LogicTerm& a,
+                                                 LogicBlock* lb) {
+  auto* llb = dynamic_cast<Z3Base*>(lb);
+  const auto value =
+      model->eval(Z3Base::getExprTerm(a.getID(), a.getCType(), llb), true);
+  const auto size = value.get_sort().bv_size();
+  std::vector<uint64_t> words((size + 63U) / 64U);
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    const auto lo = static_cast<unsigned>(64U * i);
+    const auto hi = std::min(lo + 63U, size - 1U);
+    words[i] = value.extract(hi, lo).simplify().get_numeral_uint64();
+  }
+  return words;
+}
 } // namespace z3logic
@@ -27,6 +27,7 @@ from .pyqmap import (
     CliffordSynthesizer,
     CommanderGrouping,
     Configuration,
+    DataLoggingFormat,
     Encoding,
     Heuristic,
     HybridMapperParameters,
@@ -55,6 +56,7 @@ __all__ = [
     "CliffordSynthesizer",
     "CommanderGrouping",
     "Configuration",
+    "DataLoggingFormat",
     "Encoding",
     "Heuristic",
     "HybridMapperParameters",
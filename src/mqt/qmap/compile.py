@@ -21,6 +21,7 @@ from .pyqmap import (
     Architecture,
     CommanderGrouping,
     Configuration,
+    DataLoggingFormat,
     EarlyTermination,
     Encoding,
     Heuristic,
@@ -70,6 +71,9 @@ def compile(  # noqa: A001
     automatic_layer_splits_node_limit: int | None = 5000,
     early_termination: str | EarlyTermination = "none",
     early_termination_limit: int = 0,
+    n_threads_expansion: int = 1,
+    portfolio: list[Configuration] | None = None,
+    n_threads_portfolio: int = 0,
     lookahead_heuristic: str | LookaheadHeuristic | None = "gate_count_max_distance",
     lookaheads: int = 15,
     lookahead_factor: float = 0.5,
@@ -80,8 +84,10 @@ def compile(  # noqa: A001
     commander_grouping: str | CommanderGrouping = "fixed3",
     swap_reduction: str | SwapReduction = "coupling_limit",
     swap_limit: int = 0,
+    cache_swap_distances: bool = False,
     include_WCNF: bool = False,  # noqa: N803
     use_subsets: bool = True,
+    n_threads_subsets: int = 1,
     subgraph: set[int] | None = None,
     pre_mapping_optimizations: bool = True,
     post_mapping_optimizations: bool = True,
@@ -90,6 +96,7 @@ def compile(  # noqa: A001
     verbose: bool = False,
     debug: bool = False,
     visualizer: SearchVisualizer | None = None,
+    data_logging_format: str | DataLoggingFormat = "csv",
 ) -> tuple[QuantumCircuit, MappingResults]:
     """Interface to the MQT QMAP tool for mapping quantum circuits.
 
@@ -97,7 +104,7 @@ def compile(  # noqa: A001
         circ: The circuit to map.
         arch: The architecture to map to.
         calibration: The calibration to use.
-        method: The mapping method to use. Either "heuristic" or "exact". Defaults to "heuristic".
+        method: The mapping method to use. Either "heuristic", "exact", or "portfolio" (running several heuristic configurations concurrently and keeping the best result). Defaults to "heuristic".
         heuristic: The heuristic function to use for the routing search. Defaults to "gate_count_max_distance".
         initial_layout: The initial layout to use. Defaults to "dynamic".
         iterative_bidirectional_routing_passes: Number of iterative bidirectional routing passes to perform or None to disable. Defaults to None.
@@ -105,6 +112,9 @@ def compile(  # noqa: A001
         automatic_layer_splits_node_limit: The number of expanded nodes after which to split a layer or None to disable automatic layer splitting. Defaults to 5000.
         early_termination: The early termination strategy to use, i.e. terminating the search after a goal node has been found, but before it is guarantueed to be optimal. Defaults to "none".
         early_termination_limit: The number of nodes (counted according to the early termination strategy) after which to terminate the search early. Defaults to 0.
+        n_threads_expansion: The number of threads evaluating the successors of each search node in parallel. The mapping result does not depend on this value. Defaults to 1.
+        portfolio: The heuristic mapper configurations to run with the "portfolio" method or None to use variations of the initial layout and iterative bidirectional routing settings. Defaults to None.
+        n_threads_portfolio: The number of threads running the portfolio or 0 to use one thread per configuration (limited by the available hardware threads). Defaults to 0.
         lookahead_heuristic: The heuristic function to use as a lookahead penalty during search or None to disable lookahead. Defaults to "gate_count_max_distance".
         lookaheads: The number of lookaheads to be used or None if no lookahead should be used. Defaults to 15.
         lookahead_factor: The rate at which the contribution of future layers to the lookahead decreases. Defaults to 0.5.
@@ -112,8 +122,10 @@ def compile(  # noqa: A001
         commander_grouping: The grouping strategy to use for the commander and bimander encoding. Defaults to "halves".
         swap_reduction: The swap reduction strategy to use. Defaults to "coupling_limit".
         swap_limit: Set a custom limit for max swaps per layer, for the increasing reduction strategy it sets the max swaps per layer. Defaults to 0.
+        cache_swap_distances: Cache the swap distances of all permutations of each qubit subset in the architecture, so that they are computed only once (in exact mapper). Defaults to False.
         include_WCNF: Include WCNF file in the results. Defaults to False.
         use_subsets: Use qubit subsets, or consider all available physical qubits at once. Defaults to True.
+        n_threads_subsets: The number of threads solving the instances of different qubit subsets concurrently (in exact mapper). Defaults to 1.
         subgraph: List of qubits to consider for mapping (in exact mapper), if None all qubits are considered. Defaults to None.
         use_teleportation: Use teleportation in addition to swaps. Defaults to False.
         teleportation_fake: Assign qubits as ancillary for teleportation in the initial placement but don't actually use them (used for comparisons). Defaults to False.
@@ -125,6 +137,7 @@ def compile(  # noqa: A001
         verbose: Print more detailed information during the mapping process. Defaults to False.
         debug: Gather additional information during the mapping process (e.g. number of generated nodes, branching factors, ...). Defaults to False.
         visualizer: A SearchVisualizer object to log the search process to. Defaults to None.
+        data_logging_format: The file format of the logged search nodes, either "csv" or "binary" (written in the background and read via memory mapping, which is much faster for large searches). Defaults to "csv".
 
     Returns:
         The mapped circuit and the mapping results.
@@ -156,12 +169,18 @@ def compile(  # noqa: A001
         config.automatic_layer_splits_node_limit = automatic_layer_splits_node_limit
     config.early_termination = EarlyTermination(early_termination)
     config.early_termination_limit = early_termination_limit
+    config.n_threads_expansion = n_threads_expansion
+    if portfolio is not None:
+        config.portfolio = portfolio
+    config.n_threads_portfolio = n_threads_portfolio
     config.encoding = Encoding(encoding)
     config.commander_grouping = CommanderGrouping(commander_grouping)
     config.swap_reduction = SwapReduction(swap_reduction)
     config.swap_limit = swap_limit
+    config.cache_swap_distances = cache_swap_distances
     config.include_WCNF = include_WCNF
     config.use_subsets = use_subsets
+    config.n_threads_subsets = n_threads_subsets
     config.subgraph = subgraph
     config.use_teleportation = use_teleportation
     config.teleportation_fake = teleportation_fake
@@ -174,6 +193,7 @@ def compile(  # noqa: A001
     config.debug = debug
     if visualizer is not None and visualizer.data_logging_path is not None:
         config.data_logging_path = visualizer.data_logging_path
+        config.data_logging_format = DataLoggingFormat(data_logging_format)
     if lookahead_heuristic is None:
         config.lookahead_heuristic = LookaheadHeuristic.none
         config.lookaheads = 0
@@ -184,8 +204,10 @@ def compile(  # noqa: A001
 
     results = map(circ, architecture, config)
 
-    circ = qasm3.loads(results.mapped_circuit)
-    layout = extract_initial_layout_from_qasm(results.mapped_circuit, circ.qregs)
+    # the OpenQASM string is generated on every access
+    mapped_circuit = results.mapped_circuit
+    circ = qasm3.loads(mapped_circuit)
+    layout = extract_initial_layout_from_qasm(mapped_circuit, circ.qregs)
 
     circ._layout = TranspileLayout(  # noqa: SLF001
         initial_layout=layout, input_qubit_mapping=layout.get_virtual_bits()
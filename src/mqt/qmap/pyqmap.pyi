@@ -131,6 +131,9 @@ class Configuration:
     automatic_layer_splits_node_limit: int
     early_termination: EarlyTermination
     early_termination_limit: int
+    n_threads_expansion: int
+    portfolio: list[Configuration]
+    n_threads_portfolio: int
     lookahead_heuristic: LookaheadHeuristic
     lookahead_factor: float
     lookaheads: int
@@ -140,19 +143,47 @@ class Configuration:
     subgraph: set[int]
     swap_limit: int
     swap_reduction: SwapReduction
+    cache_swap_distances: bool
     teleportation_fake: bool
     teleportation_qubits: int
     teleportation_seed: int
     timeout: int
     use_subsets: bool
+    n_threads_subsets: int
     use_teleportation: bool
     verbose: bool
     debug: bool
     data_logging_path: str
+    data_logging_format: DataLoggingFormat
+    data_logging_only_expanded_nodes: bool
+    data_logging_last_layers: int
 
     def __init__(self) -> None: ...
     def json(self) -> dict[str, Any]: ...
 
+class DataLoggingFormat:
+    __members__: ClassVar[dict[DataLoggingFormat, int]] = ...  # read-only
+    binary: ClassVar[DataLoggingFormat] = ...
+    csv: ClassVar[DataLoggingFormat] = ...
+
+    @overload
+    def __init__(self, value: int) -> None: ...
+    @overload
+    def __init__(self, arg0: str) -> None: ...
+    @overload
+    def __init__(self, arg0: DataLoggingFormat) -> None: ...
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str: ...
+    @property
+    def value(self) -> int: ...
+
 class EarlyTermination:
     __members__: ClassVar[dict[EarlyTermination, int]] = ...  # read-only
     none: ClassVar[EarlyTermination] = ...
@@ -330,6 +361,15 @@ class LayerHeuristicBenchmarkInfo:
     def __init__(self) -> None: ...
     def json(self) -> dict[str, Any]: ...
 
+class PortfolioRunInfo:
+    configuration: Configuration
+    time: float
+    routing_gates: int
+    stopped_early: bool
+
+    def __init__(self) -> None: ...
+    def json(self) -> dict[str, Any]: ...
+
 class MappingResults:
     configuration: Configuration
     input: CircuitInfo
@@ -340,8 +380,12 @@ class MappingResults:
     wcnf: str
     heuristic_benchmark: HeuristicBenchmarkInfo
     layer_heuristic_benchmark: LayerHeuristicBenchmarkInfo
+    portfolio_runs: list[PortfolioRunInfo]
+    portfolio_winner: int
 
     def __init__(self) -> None: ...
+    @property
+    def mapped_circuit_object(self) -> QuantumComputation | None: ...
     def csv(self) -> str: ...
     def json(self) -> dict[str, Any]: ...
 
@@ -349,6 +393,7 @@ class Method:
     __members__: ClassVar[dict[Method, int]] = ...  # read-only
     exact: ClassVar[Method] = ...
     heuristic: ClassVar[Method] = ...
+    portfolio: ClassVar[Method] = ...
 
     @overload
     def __init__(self, value: int) -> None: ...
@@ -394,6 +439,9 @@ class SwapReduction:
     def value(self) -> int: ...
 
 def map(circ: str | QuantumCircuit, arch: Architecture, config: Configuration) -> MappingResults: ...  # noqa: A001
+def map_batch(
+    circuits: list[str | QuantumCircuit], arch: Architecture, configs: list[Configuration], n_threads: int = 0
+) -> list[MappingResults]: ...
 
 class TargetMetric:
     __members__: ClassVar[dict[TargetMetric, int]] = ...  # read-only
@@ -462,7 +510,21 @@ class SynthesisConfiguration:
     verbosity: Verbosity
     heuristic: bool
     split_size: int
+    n_threads_heuristic: int
     linear_search: bool
+    incremental_solving: bool
+    use_cnf_backend: bool
+    cnf_solver_command: str
+
+    def __init__(self) -> None: ...
+    def json(self) -> dict[str, Any]: ...
+
+class HeuristicBlockInfo:
+    begin: int
+    end: int
+    depth: int
+    runtime: float
+    solver_calls: int
 
     def __init__(self) -> None: ...
     def json(self) -> dict[str, Any]: ...
@@ -474,10 +536,14 @@ class SynthesisResults:
     @property
     def circuit(self) -> str: ...
     @property
+    def circuit_object(self) -> QuantumComputation | None: ...
+    @property
     def depth(self) -> int: ...
     @property
     def gates(self) -> int: ...
     @property
+    def heuristic_blocks(self) -> list[HeuristicBlockInfo]: ...
+    @property
     def runtime(self) -> float: ...
     @property
     def single_qubit_gates(self) -> int: ...
@@ -486,6 +552,8 @@ class SynthesisResults:
     @property
     def tableau(self) -> str: ...
     @property
+    def tableau_object(self) -> Tableau | None: ...
+    @property
     def two_qubit_gates(self) -> int: ...
 
 class QuantumComputation:
@@ -585,7 +653,9 @@ class HybridNAMapper:
     def get_animation_csv(self) -> str: ...
     def get_init_hw_pos(self) -> dict[int, int]: ...
     def get_mapped_qc(self) -> str: ...
+    def get_mapped_qc_object(self) -> QuantumComputation: ...
     def get_mapped_qc_aod(self) -> str: ...
+    def get_mapped_qc_aod_object(self) -> QuantumComputation: ...
     def map(self, circ: object, initial_mapping: InitialCircuitMapping = ..., verbose: bool = ...) -> None: ...
     def map_qasm_file(
         self, filename: str, initial_mapping: InitialCircuitMapping = ..., verbose: bool = ...
@@ -140,7 +140,6 @@ class FinalNodeNotFoundError(Exception):
 
 
 def _parse_search_graph(file_path: str, final_node_id: int, only_solution_path: bool) -> tuple[nx.Graph, int]:
-    graph = nx.Graph()
     root: None | int = None
     nodes: dict[int, SearchNode] = {}
     with Path(file_path).open(encoding=locale.getpreferredencoding(False)) as file:
@@ -164,6 +163,73 @@ def _parse_search_graph(file_path: str, final_node_id: int, only_solution_path:
             )
             if parentid == nodeid:
                 root = nodeid
+    return _build_search_graph(nodes, root, final_node_id, only_solution_path)
+
+
+def _parse_search_graph_binary(
+    nodes_file_path: str, swaps_file_path: str, final_node_id: int, only_solution_path: bool
+) -> tuple[nx.Graph, int]:
+    import numpy as np  # noqa: PLC0415
+
+    header_size = 32
+    header = np.fromfile(nodes_file_path, dtype="=u4", count=header_size // 4)
+    nqubits = int(header[3])
+    node_dtype = np.dtype({
+        "names": [
+            "id",
+            "parent",
+            "fixed_cost",
+            "heuristic_cost",
+            "lookahead_penalty",
+            "depth",
+            "swaps_begin",
+            "n_swaps",
+            "valid",
+            "layout",
+        ],
+        "formats": ["=u8", "=u8", "=f8", "=f8", "=f8", "=u8", "=u8", "=u4", "u1", ("=i2", (nqubits,))],
+        "offsets": [0, 8, 16, 24, 32, 40, 48, 56, 60, 64],
+        "itemsize": int(header[4]),
+    })
+    swap_dtype = np.dtype({"names": ["first", "second"], "formats": ["=u2", "=u2"], "offsets": [0, 2], "itemsize": 8})
+
+    def load_records(file_path: str, dtype: np.dtype) -> np.ndarray:
+        # the records are mapped lazily, so that only the touched pages are read
+        if Path(file_path).stat().st_size <= header_size:
+            return np.zeros(0, dtype=dtype)
+        return np.memmap(file_path, dtype=dtype, mode="r", offset=header_size)
+
+    records = load_records(nodes_file_path, node_dtype)
+    swap_records = load_records(swaps_file_path, swap_dtype)
+
+    root: None | int = None
+    nodes: dict[int, SearchNode] = {}
+    for record in records.tolist():
+        nodeid, parentid, fixed_cost, heuristic_cost, lookahead_penalty, depth, swaps_begin, n_swaps, valid, layout = (
+            record
+        )
+        swaps = swap_records[swaps_begin : swaps_begin + n_swaps].tolist()
+        nodes[nodeid] = SearchNode(
+            nodeid,
+            parentid if parentid != nodeid else None,
+            fixed_cost,
+            heuristic_cost,
+            lookahead_penalty,
+            valid == 1,
+            nodeid == final_node_id,
+            depth,
+            tuple(layout),
+            tuple(swaps),
+        )
+        if parentid == nodeid:
+            root = nodeid
+    return _build_search_graph(nodes, root, final_node_id, only_solution_path)
+
+
+def _build_search_graph(
+    nodes: dict[int, SearchNode], root: int | None, final_node_id: int, only_solution_path: bool
+) -> tuple[nx.Graph, int]:
+    graph = nx.Graph()
     if root is None:
         raise RootNodeNotFoundError
     if only_solution_path:
@@ -769,6 +835,15 @@ def _visualize_layout(
             search_node_trace.marker.line.width = marker_line_widths
 
 
+def _layer_data_exists(data_logging_path: str, layer: int) -> bool:
+    if not Path(f"{data_logging_path}layer_{layer}.json").exists():
+        return False
+    return (
+        Path(f"{data_logging_path}nodes_layer_{layer}.bin").exists()
+        or Path(f"{data_logging_path}nodes_layer_{layer}.csv").exists()
+    )
+
+
 def _load_layer_data(
     data_logging_path: str,
     layer: int,
@@ -813,7 +888,8 @@ def _load_layer_data(
     if not Path(f"{data_logging_path}layer_{layer}.json").exists():
         msg = f"No data at {data_logging_path}layer_{layer}.json"
         raise FileNotFoundError(msg)
-    if not Path(f"{data_logging_path}nodes_layer_{layer}.csv").exists():
+    binary = Path(f"{data_logging_path}nodes_layer_{layer}.bin").exists()
+    if not binary and not Path(f"{data_logging_path}nodes_layer_{layer}.csv").exists():
         msg = f"No data at {data_logging_path}nodes_layer_{layer}.csv"
         raise FileNotFoundError(msg)
 
@@ -832,9 +908,17 @@ def _load_layer_data(
     initial_positions = _reverse_layout(initial_layout)
     final_node_id = circuit_layer["final_node_id"]
 
-    graph, graph_root = _parse_search_graph(
-        f"{data_logging_path}nodes_layer_{layer}.csv", final_node_id, show_only_solution_path
-    )
+    if binary:
+        graph, graph_root = _parse_search_graph_binary(
+            f"{data_logging_path}nodes_layer_{layer}.bin",
+            f"{data_logging_path}swaps_layer_{layer}.bin",
+            final_node_id,
+            show_only_solution_path,
+        )
+    else:
+        graph, graph_root = _parse_search_graph(
+            f"{data_logging_path}nodes_layer_{layer}.csv", final_node_id, show_only_solution_path
+        )
 
     pos = _layout_search_graph(graph, graph_root, layout, tapered_layer_heights)
 
@@ -1754,6 +1838,15 @@ def visualize_search_graph(
         msg = f"Invalid layer {layer}. There are only {number_of_layers} layers in the data log."
         raise ValueError(msg)
 
+    # with `data_logging_last_layers`, only the data of the last layers is kept
+    first_layer = next((i for i in range(number_of_layers) if _layer_data_exists(data_logging_path, i)), None)
+    if first_layer is None:
+        msg = f"No layer data at {data_logging_path}"
+        raise FileNotFoundError(msg)
+    if isinstance(layer, int) and layer < first_layer:
+        msg = f"The data of layer {layer} has not been kept in the data log (first kept layer: {first_layer})."
+        raise ValueError(msg)
+
     # prepare search graph traces
     search_node_traces, search_edge_traces, search_node_stem_trace = _prepare_search_graph_scatters(
         number_of_node_traces,
@@ -2096,15 +2189,15 @@ def visualize_search_graph(
     if isinstance(layer, int):
         update_layer(layer)
     else:
-        update_layer(0)
+        update_layer(first_layer)
 
     layer_slider = interactive(
         update_layer,
         new_layer=IntSlider(
-            min=0,
+            min=first_layer,
             max=number_of_layers - 1,
             step=1,
-            value=0,
+            value=first_layer,
             description="Layer:",
             layout=Layout(width=f"{width - 80}px"),
         ),
@@ -31,6 +31,32 @@
 
 namespace na {
 
+namespace {
+/// Checks whether the point lies within the bounds of the zone.
+auto isInZone(const Architecture::ZoneProperties& zone,
+              const Point& p) -> bool {
+  return p.x >= zone.minX && p.x <= zone.maxX && p.y >= zone.minY &&
+         p.y <= zone.maxY;
+}
+
+/**
+ * @brief Returns the first site of a row (if `horizontal`) or column, whose
+ * x- or y-coordinate, respectively, is greater than (if `upper`) or not less
+ * than `c`.
+ * @details Analogous to `std::upper_bound` and `std::lower_bound`, the sites
+ * of the line must be sorted by the respective coordinate.
+ */
+auto getBoundInLine(const std::vector<Point>& sites,
+                    const std::vector<Index>& line, const bool horizontal,
+                    const Number c,
+                    const bool upper) -> std::vector<Index>::const_iterator {
+  return std::partition_point(line.cbegin(), line.cend(), [&](const Index i) {
+    const auto& coordinate = horizontal ? sites[i].x : sites[i].y;
+    return upper ? coordinate <= c : coordinate < c;
+  });
+}
+} // namespace
+
 auto Architecture::fromFile(const std::string& jsonFn,
                             const std::string& csvFn) -> void {
   std::ifstream jsonS(jsonFn);
@@ -131,14 +157,13 @@ auto Architecture::fromFileStream(std::istream& jsonS,
         "While reading the JSON data, the following error occurred: " +
         std::string(e.what()));
   }
+  buildSiteIndex();
 }
 
 auto Architecture::getZoneAt(const Point& p) const -> Zone {
   const auto& it =
-      std::find_if(zones.cbegin(), zones.cend(), [&](const auto& zProp) {
-        return p.x >= zProp.minX && p.x <= zProp.maxX && p.y >= zProp.minY &&
-               p.y <= zProp.maxY;
-      });
+      std::find_if(zones.cbegin(), zones.cend(),
+                   [&](const auto& zProp) { return isInZone(zProp, p); });
   if (it == zones.cend()) {
     std::stringstream ss;
     ss << "The point " << p << " is not in any zone.";
@@ -147,6 +172,14 @@ auto Architecture::getZoneAt(const Point& p) const -> Zone {
   return static_cast<Zone>(std::distance(zones.cbegin(), it));
 }
 
+auto Architecture::getZoneOfSite(const Index& i) const -> Zone {
+  if (siteZones[i] == NO_ZONE) {
+    // reports that the site is not in any zone
+    return getZoneAt(getPositionOfSite(i));
+  }
+  return siteZones[i];
+}
+
 auto Architecture::isAllowedLocally(const FullOpType& t) const -> bool {
   const auto it = gateSet.find(t);
   return it != gateSet.end() && it->second.scope == Scope::Local;
@@ -193,238 +226,294 @@ auto Architecture::isAllowedGlobally(const FullOpType& t,
   // zone exists in gateZones
   return gateZones.find(zone) != gateZones.end();
 }
-auto Architecture::getRowsInZone(const Zone& z) const -> std::vector<Number> {
-  std::unordered_set<Number> rows;
-  std::for_each(sites.cbegin(), sites.cend(), [&](const auto& s) {
-    if (s.x >= zones[z].minX && s.x <= zones[z].maxX and s.y >= zones[z].minY &&
-        s.y <= zones[z].maxY) {
-      rows.insert(s.y);
-    }
-  });
-  std::vector<Number> result(rows.cbegin(), rows.cend());
-  std::sort(result.begin(), result.end());
-  return result;
+auto Architecture::getRowsInZone(const Zone& z) const
+    -> const std::vector<Number>& {
+  return zoneRows[z];
 }
-auto Architecture::getColsInZone(const Zone& z) const -> std::vector<Number> {
-  std::unordered_set<Number> cols;
-  std::for_each(sites.cbegin(), sites.cend(), [&](const auto& s) {
-    if (s.x >= zones[z].minX && s.x <= zones[z].maxX and
-        s.y >= zones[z].minY and s.y <= zones[z].maxY) {
-      cols.insert(s.x);
-    }
-  });
-  std::vector<Number> result(cols.cbegin(), cols.cend());
-  std::sort(result.begin(), result.end());
-  return result;
+auto Architecture::getColsInZone(const Zone& z) const
+    -> const std::vector<Number>& {
+  return zoneCols[z];
 }
 auto Architecture::getNrowsInZone(const Zone& z) const -> Index {
   return Architecture::getRowsInZone(z).size();
 }
-auto Architecture::getSitesInRow(const Zone& z,
-                                 const Index& row) const -> std::vector<Index> {
-  const auto y = Architecture::getRowsInZone(z)[row];
-  std::vector<Index> atoms;
-  for (Index i = 0; i < sites.size(); ++i) {
-    const auto& s = sites[i];
-    if (s.y == y && s.x >= zones[z].minX && s.x <= zones[z].maxX) {
-      atoms.emplace_back(i);
-    }
-  }
-  return atoms;
+auto Architecture::getSitesInRow(const Zone& z, const Index& row) const
+    -> const std::vector<Index>& {
+  return zoneRowSites[z][row];
 }
-auto Architecture::getSitesInZone(const Zone& z) const -> std::vector<Index> {
-  std::vector<Index> atoms;
-  for (Index i = 0; i < sites.size(); ++i) {
-    const auto& s = sites[i];
-    if (s.x >= zones[z].minX && s.x <= zones[z].maxX && s.y >= zones[z].minY &&
-        s.y <= zones[z].maxY) {
-      atoms.emplace_back(i);
-    }
-  }
-  return atoms;
+auto Architecture::getSitesInZone(const Zone& z) const
+    -> const std::vector<Index>& {
+  return zoneSites[z];
 }
 auto Architecture::getNearestXLeft(const Number& x, const Zone& z,
                                    const bool proper) const -> Number {
   const auto& cols = getColsInZone(z);
-  if (!std::any_of(cols.cbegin(), cols.cend(),
-                   [&](const auto& c) { return proper ? c < x : c <= x; })) {
+  // the first column that is not left of x
+  const auto it = proper ? std::lower_bound(cols.cbegin(), cols.cend(), x)
+                         : std::upper_bound(cols.cbegin(), cols.cend(), x);
+  if (it == cols.cbegin()) {
     return x;
   }
-
-  Number result = std::numeric_limits<Number>::min();
-  for (const auto& c : cols) {
-    if ((proper ? c < x : c <= x) && c > result) {
-      result = c;
-    }
-  }
-  return result;
+  return *std::prev(it);
 }
 
 auto Architecture::getNearestXRight(const Number& x, const Zone& z,
                                     const bool proper) const -> Number {
   const auto& cols = getColsInZone(z);
-  if (!std::any_of(cols.cbegin(), cols.cend(),
-                   [&](const auto& c) { return proper ? c > x : c >= x; })) {
+  // the first column right of x
+  const auto it = proper ? std::upper_bound(cols.cbegin(), cols.cend(), x)
+                         : std::lower_bound(cols.cbegin(), cols.cend(), x);
+  if (it == cols.cend()) {
     return x;
   }
-
-  Number result = std::numeric_limits<Number>::max();
-  for (const auto& c : cols) {
-    if ((proper ? c > x : c >= x) && c < result) {
-      result = c;
-    }
-  }
-  return result;
+  return *it;
 }
 auto Architecture::hasSiteLeft(const Point& p, bool proper, bool sameZone) const
     -> std::pair<std::vector<Point>::const_reverse_iterator, bool> {
-  const auto& zone = getZoneAt(p);
-  const auto& it =
-      std::find_if(sites.crbegin(), sites.crend(), [&](const auto& s) {
-        return s.y == p.y and (proper ? s.x < p.x : s.x <= p.x) and
-               (not sameZone or getZoneAt(s) == zone);
-      });
-  return {it, it != sites.crend()};
+  const auto& site = getNearestSiteLeft(p, proper, sameZone);
+  if (!site.has_value()) {
+    return {sites.crend(), false};
+  }
+  return {std::make_reverse_iterator(std::next(
+              sites.cbegin(), static_cast<std::ptrdiff_t>(*site) + 1)),
+          true};
 }
 auto Architecture::hasSiteRight(const Point& p, bool proper, bool sameZone)
     const -> std::pair<std::vector<Point>::const_iterator, bool> {
-  const auto& zone = getZoneAt(p);
-  const auto& it =
-      std::find_if(sites.cbegin(), sites.cend(), [&](const auto& s) {
-        return s.y == p.y and (proper ? s.x > p.x : s.x >= p.x) and
-               (not sameZone or getZoneAt(s) == zone);
-      });
-  return {it, it != sites.cend()};
+  const auto& site = getNearestSiteRight(p, proper, sameZone);
+  if (!site.has_value()) {
+    return {sites.cend(), false};
+  }
+  return {std::next(sites.cbegin(), static_cast<std::ptrdiff_t>(*site)), true};
 }
 auto Architecture::hasSiteUp(const Point& p, bool proper, bool sameZone) const
     -> std::pair<std::vector<Point>::const_reverse_iterator, bool> {
-  const auto& zone = getZoneAt(p);
-  const auto& it =
-      std::find_if(sites.crbegin(), sites.crend(), [&](const auto& s) {
-        return s.x == p.x and (proper ? s.y < p.y : s.y <= p.y) and
-               (not sameZone or getZoneAt(s) == zone);
-      });
-  return {it, it != sites.crend()};
+  const auto& site = getNearestSiteUp(p, proper, sameZone);
+  if (!site.has_value()) {
+    return {sites.crend(), false};
+  }
+  return {std::make_reverse_iterator(std::next(
+              sites.cbegin(), static_cast<std::ptrdiff_t>(*site) + 1)),
+          true};
 }
 auto Architecture::hasSiteDown(const Point& p, bool proper, bool sameZone) const
     -> std::pair<std::vector<Point>::const_iterator, bool> {
-  const auto& zone = getZoneAt(p);
-  const auto& it =
-      std::find_if(sites.cbegin(), sites.cend(), [&](const auto& s) {
-        return s.x == p.x and (proper ? s.y > p.y : s.y >= p.y) and
-               (not sameZone or getZoneAt(s) == zone);
-      });
-  return {it, it != sites.cend()};
+  const auto& site = getNearestSiteDown(p, proper, sameZone);
+  if (!site.has_value()) {
+    return {sites.cend(), false};
+  }
+  return {std::next(sites.cbegin(), static_cast<std::ptrdiff_t>(*site)), true};
 }
 auto Architecture::getNearestSiteLeft(const Point& p, const bool proper,
                                       const bool sameZone) const
     -> std::optional<Index> {
-  const auto& [it, success] = hasSiteLeft(p, proper, sameZone);
-  if (not success) {
-    return std::nullopt;
-  }
-  return sites.size() -
-         static_cast<std::size_t>(std::distance(sites.crbegin(), it)) - 1;
+  return getNearestSiteInLine(p, true, false, proper, sameZone);
 }
 auto Architecture::getNearestSiteRight(const Point& p, const bool proper,
                                        const bool sameZone) const
     -> std::optional<Index> {
-  const auto& [it, success] = hasSiteRight(p, proper, sameZone);
-  if (not success) {
-    return std::nullopt;
-  }
-  return static_cast<std::size_t>(std::distance(sites.cbegin(), it));
+  return getNearestSiteInLine(p, true, true, proper, sameZone);
 }
 auto Architecture::getNearestSiteUp(const Point& p, const bool proper,
                                     const bool sameZone) const
     -> std::optional<Index> {
-  const auto& [it, success] = hasSiteUp(p, proper, sameZone);
-  if (not success) {
-    return std::nullopt;
-  }
-  return sites.size() -
-         static_cast<std::size_t>(std::distance(sites.crbegin(), it)) - 1;
+  return getNearestSiteInLine(p, false, false, proper, sameZone);
 }
 auto Architecture::getNearestSiteDown(const Point& p, const bool proper,
                                       const bool sameZone) const
     -> std::optional<Index> {
-  const auto& [it, success] = hasSiteDown(p, proper, sameZone);
-  if (not success) {
-    return std::nullopt;
-  }
-  return static_cast<std::size_t>(std::distance(sites.cbegin(), it));
+  return getNearestSiteInLine(p, false, true, proper, sameZone);
 }
 auto Architecture::getNearestSiteUpRight(const Point& p, const bool proper,
                                          const bool sameZone) const
     -> std::optional<Index> {
-  const auto& zone = getZoneAt(p);
-  std::optional<Index> opt;
-  for (std::size_t i = 0; i < sites.size(); ++i) {
-    const auto& s = sites[i];
-    if ((proper ? s.x > p.x and s.y < p.y : s.x >= p.x and s.y <= p.y) and
-        (not sameZone or getZoneAt(s) == zone)) {
-      if (!opt or (s - p).length() < (getPositionOfSite(*opt) - p).length()) {
-        opt = i;
-      }
-    }
-  }
-  return opt;
+  return getNearestSiteInQuadrant(p, true, false, proper, sameZone);
 }
 auto Architecture::getNearestSiteUpLeft(const Point& p, const bool proper,
                                         const bool sameZone) const
     -> std::optional<Index> {
-  const auto& zone = getZoneAt(p);
-  std::optional<Index> opt;
-  for (std::size_t i = 0; i < sites.size(); ++i) {
-    const auto& s = sites[i];
-    if ((proper ? s.x < p.x and s.y < p.y : s.x <= p.x and s.y <= p.y) and
-        (not sameZone or getZoneAt(s) == zone)) {
-      if (!opt or (s - p).length() < (getPositionOfSite(*opt) - p).length()) {
-        opt = i;
-      }
-    }
-  }
-  return opt;
+  return getNearestSiteInQuadrant(p, false, false, proper, sameZone);
 }
 auto Architecture::getNearestSiteDownLeft(const Point& p, const bool proper,
                                           const bool sameZone) const
     -> std::optional<Index> {
+  return getNearestSiteInQuadrant(p, false, true, proper, sameZone);
+}
+auto Architecture::getNearestSiteDownRight(const Point& p, const bool proper,
+                                           const bool sameZone) const
+    -> std::optional<Index> {
+  return getNearestSiteInQuadrant(p, true, true, proper, sameZone);
+}
+auto Architecture::getNearestSiteInLine(const Point& p, const bool horizontal,
+                                        const bool forward, const bool proper,
+                                        const bool sameZone) const
+    -> std::optional<Index> {
   const auto& zone = getZoneAt(p);
-  std::optional<Index> opt;
-  for (std::size_t i = 0; i < sites.size(); ++i) {
-    const auto& s = sites[i];
-    if ((proper ? s.x < p.x and s.y > p.y : s.x <= p.x and s.y >= p.y) and
-        (not sameZone or getZoneAt(s) == zone)) {
-      if (!opt or (s - p).length() < (getPositionOfSite(*opt) - p).length()) {
-        opt = i;
-      }
+  const auto& lines = horizontal ? allRows : allCols;
+  const auto& lineIt = std::lower_bound(lines.cbegin(), lines.cend(),
+                                        horizontal ? p.y : p.x);
+  if (lineIt == lines.cend() || *lineIt != (horizontal ? p.y : p.x)) {
+    return std::nullopt;
+  }
+  const auto& line = (horizontal ? rowSites : colSites)[static_cast<Index>(
+      std::distance(lines.cbegin(), lineIt))];
+  const auto& isCandidate = [&](const Index i) {
+    return not sameZone or siteZones[i] == zone;
+  };
+  // the sites before and after p are separated here, where a site at p only
+  // counts if not proper
+  const auto bound = getBoundInLine(sites, line, horizontal,
+                                     horizontal ? p.x : p.y, forward == proper);
+  if (forward) {
+    const auto& it = std::find_if(bound, line.cend(), isCandidate);
+    if (it != line.cend()) {
+      return *it;
+    }
+  } else {
+    const auto& it = std::find_if(std::make_reverse_iterator(bound),
+                                  line.crend(), isCandidate);
+    if (it != line.crend()) {
+      return *it;
     }
   }
-  return opt;
+  return std::nullopt;
 }
-auto Architecture::getNearestSiteDownRight(const Point& p, const bool proper,
-                                           const bool sameZone) const
+auto Architecture::getNearestSiteInQuadrant(const Point& p, const bool right,
+                                            const bool down, const bool proper,
+                                            const bool sameZone) const
     -> std::optional<Index> {
   const auto& zone = getZoneAt(p);
   std::optional<Index> opt;
-  for (std::size_t i = 0; i < sites.size(); ++i) {
-    const auto& s = sites[i];
-    if ((proper ? s.x > p.x and s.y > p.y : s.x >= p.x and s.y >= p.y) and
-        (not sameZone or getZoneAt(s) == zone)) {
-      if (!opt or (s - p).length() < (getPositionOfSite(*opt) - p).length()) {
-        opt = i;
+  Distance optDistance = 0;
+  // visits sites of a row by increasing distance to p in x-direction
+  const auto& visitSites = [&](auto it, const auto end) {
+    for (; it != end; ++it) {
+      const auto& s = sites[*it];
+      if (opt and static_cast<Distance>(std::abs(s.x - p.x)) > optDistance) {
+        // all remaining sites of the row are farther away
+        return;
+      }
+      if (not sameZone or siteZones[*it] == zone) {
+        const Distance d = (s - p).length();
+        if (!opt or d < optDistance or (d == optDistance and *it < *opt)) {
+          opt = *it;
+          optDistance = d;
+        }
+      }
+    }
+  };
+  // returns false if the row and all further rows are farther away
+  const auto& visitRow = [&](const Index r) {
+    if (opt and
+        static_cast<Distance>(std::abs(allRows[r] - p.y)) > optDistance) {
+      return false;
+    }
+    const auto& row = rowSites[r];
+    const auto bound = getBoundInLine(sites, row, true, p.x, right == proper);
+    if (right) {
+      visitSites(bound, row.cend());
+    } else {
+      visitSites(std::make_reverse_iterator(bound), row.crend());
+    }
+    return true;
+  };
+  // the rows above and below p are separated here, where the row of p only
+  // counts if not proper
+  const auto rowBound =
+      static_cast<Index>(std::distance(
+          allRows.cbegin(),
+          down == proper
+              ? std::upper_bound(allRows.cbegin(), allRows.cend(), p.y)
+              : std::lower_bound(allRows.cbegin(), allRows.cend(), p.y)));
+  if (down) {
+    for (Index r = rowBound; r < allRows.size(); ++r) {
+      if (!visitRow(r)) {
+        break;
+      }
+    }
+  } else {
+    for (Index r = rowBound; r > 0; --r) {
+      if (!visitRow(r - 1)) {
+        break;
       }
     }
   }
   return opt;
 }
 auto Architecture::getSiteAt(const Point& p) const -> std::optional<Index> {
-  auto it = std::find_if(sites.begin(), sites.end(),
-                         [&](const auto& site) { return site == p; });
-  if (it == sites.end()) {
+  const auto& rowIt = std::lower_bound(allRows.cbegin(), allRows.cend(), p.y);
+  if (rowIt == allRows.cend() || *rowIt != p.y) {
     return std::nullopt;
   }
-  return std::distance(sites.begin(), it);
+  const auto& row = rowSites[static_cast<Index>(
+      std::distance(allRows.cbegin(), rowIt))];
+  const auto& it = getBoundInLine(sites, row, true, p.x, false);
+  if (it == row.cend() || sites[*it].x != p.x) {
+    return std::nullopt;
+  }
+  return *it;
+}
+auto Architecture::buildSiteIndex() -> void {
+  siteZones.assign(sites.size(), NO_ZONE);
+  std::map<Number, std::vector<Index>> rowMap;
+  std::map<Number, std::vector<Index>> colMap;
+  for (Index i = 0; i < sites.size(); ++i) {
+    const auto& s = sites[i];
+    const auto& it =
+        std::find_if(zones.cbegin(), zones.cend(),
+                     [&](const auto& zProp) { return isInZone(zProp, s); });
+    if (it != zones.cend()) {
+      siteZones[i] = static_cast<Zone>(std::distance(zones.cbegin(), it));
+    }
+    rowMap[s.y].emplace_back(i);
+    colMap[s.x].emplace_back(i);
+  }
+  // the sites are collected by index, hence, sorting them stably by their
+  // position keeps sites at the same position sorted by index
+  allRows.clear();
+  rowSites.clear();
+  for (auto& [y, row] : rowMap) {
+    std::stable_sort(row.begin(), row.end(), [&](const auto& i, const auto& j) {
+      return sites[i].x < sites[j].x;
+    });
+    allRows.emplace_back(y);
+    rowSites.emplace_back(std::move(row));
+  }
+  allCols.clear();
+  colSites.clear();
+  for (auto& [x, col] : colMap) {
+    std::stable_sort(col.begin(), col.end(), [&](const auto& i, const auto& j) {
+      return sites[i].y < sites[j].y;
+    });
+    allCols.emplace_back(x);
+    colSites.emplace_back(std::move(col));
+  }
+  // zones may overlap, hence, sites are assigned to every zone containing them
+  zoneSites.assign(zones.size(), {});
+  zoneRows.assign(zones.size(), {});
+  zoneCols.assign(zones.size(), {});
+  zoneRowSites.assign(zones.size(), {});
+  for (Zone z = 0; z < zones.size(); ++z) {
+    for (Index i = 0; i < sites.size(); ++i) {
+      if (isInZone(zones[z], sites[i])) {
+        zoneSites[z].emplace_back(i);
+        zoneRows[z].emplace_back(sites[i].y);
+        zoneCols[z].emplace_back(sites[i].x);
+      }
+    }
+    for (auto* v : {&zoneRows[z], &zoneCols[z]}) {
+      std::sort(v->begin(), v->end());
+      v->erase(std::unique(v->begin(), v->end()), v->end());
+    }
+    zoneRowSites[z].resize(zoneRows[z].size());
+    for (const auto& i : zoneSites[z]) {
+      const auto& rowIt = std::lower_bound(zoneRows[z].cbegin(),
+                                           zoneRows[z].cend(), sites[i].y);
+      zoneRowSites[z][static_cast<Index>(
+                          std::distance(zoneRows[z].cbegin(), rowIt))]
+          .emplace_back(i);
+    }
+  }
 }
 auto Architecture::withConfig(const Configuration& config) const
     -> Architecture {
@@ -482,6 +571,7 @@ auto Architecture::withConfig(const Configuration& config) const
       }
     }
   }
+  result.buildSiteIndex();
   return result;
 }
 auto Architecture::getPositionOffsetBy(const Point& p, const Number& rows,
@@ -3,9 +3,11 @@
 // See README.md or go to https://github.com/cda-tum/qmap for more information.
 //
 
+#include "ThreadPool.hpp"
 #include "cliffordsynthesis/CliffordSynthesizer.hpp"
 #include "exact/ExactMapper.hpp"
 #include "heuristic/HeuristicMapper.hpp"
+#include "heuristic/PortfolioMapper.hpp"
 #include "hybridmap/HybridNeutralAtomMapper.hpp"
 #include "hybridmap/NeutralAtomScheduler.hpp"
 #include "nlohmann/json.hpp"
@@ -15,6 +17,11 @@
 #include "python/qiskit/QuantumCircuit.hpp"
 #include "string"
 
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 
@@ -33,13 +40,10 @@ void loadQC(qc::QuantumComputation& qc, const py::object& circ) {
   }
 }
 
-// c++ binding function
-MappingResults map(const py::object& circ, Architecture& arch,
-                   Configuration& config) {
-  qc::QuantumComputation qc{};
-
-  loadQC(qc, circ);
-
+// maps an already imported circuit (does not touch any Python objects, so it
+// can be called without holding the GIL)
+MappingResults mapCircuit(qc::QuantumComputation& qc, Architecture& arch,
+                          Configuration& config) {
   if (config.useTeleportation) {
     config.teleportationQubits =
         std::min((arch.getNqubits() - qc.getNqubits()) & ~1U,
@@ -52,6 +56,8 @@ MappingResults map(const py::object& circ, Architecture& arch,
       mapper = std::make_unique<HeuristicMapper>(qc, arch);
     } else if (config.method == Method::Exact) {
       mapper = std::make_unique<ExactMapper>(qc, arch);
+    } else if (config.method == Method::Portfolio) {
+      mapper = std::make_unique<PortfolioMapper>(qc, arch);
     }
   } catch (std::exception const& e) {
     std::stringstream ss{};
@@ -68,11 +74,55 @@ MappingResults map(const py::object& circ, Architecture& arch,
   }
 
   auto& results = mapper->getResults();
+  // the OpenQASM string is only generated if it is requested
+  results.mappedCircuitObject =
+      std::make_shared<qc::QuantumComputation>(mapper->takeMappedCircuit());
 
-  std::stringstream qasm{};
-  mapper->dumpResult(qasm, qc::Format::OpenQASM3);
-  results.mappedCircuit = qasm.str();
+  return results;
+}
 
+// c++ binding function
+MappingResults map(const py::object& circ, const Architecture& arch,
+                   const Configuration& config) {
+  qc::QuantumComputation qc{};
+
+  loadQC(qc, circ);
+
+  // the mappers modify the architecture and configuration, so they work on
+  // copies that other Python threads cannot access while the GIL is released
+  Architecture architecture = arch;
+  Configuration configuration = config;
+  const py::gil_scoped_release release{};
+  return mapCircuit(qc, architecture, configuration);
+}
+
+// maps several circuits concurrently, each with its own copy of the
+// architecture and configuration
+std::vector<MappingResults> mapBatch(const std::vector<py::object>& circuits,
+                                     const Architecture& arch,
+                                     const std::vector<Configuration>& configs,
+                                     std::size_t nThreads) {
+  if (configs.size() != 1 && configs.size() != circuits.size()) {
+    throw std::invalid_argument(
+        "Expected either a single configuration or one per circuit");
+  }
+  // importing (e.g., Qiskit) circuits requires the GIL
+  std::vector<qc::QuantumComputation> qcs(circuits.size());
+  for (std::size_t i = 0; i < circuits.size(); ++i) {
+    loadQC(qcs[i], circuits[i]);
+  }
+
+  std::vector<MappingResults> results(circuits.size());
+  const py::gil_scoped_release release{};
+  if (nThreads == 0) {
+    nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  ThreadPool pool(std::min(nThreads, circuits.size()));
+  pool.parallelFor(circuits.size(), [&](const std::size_t i) {
+    Architecture architecture = arch;
+    Configuration config = configs[configs.size() == 1 ? 0 : i];
+    results[i] = mapCircuit(qcs[i], architecture, config);
+  });
   return results;
 }
 
@@ -109,6 +159,7 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
   py::enum_<Method>(m, "Method")
       .value("heuristic", Method::Heuristic)
       .value("exact", Method::Exact)
+      .value("portfolio", Method::Portfolio)
       .export_values()
       // allow construction from string
       .def(py::init([](const std::string& str) -> Method {
@@ -220,6 +271,16 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
         return swapReductionFromString(str);
       }));
 
+  // File format of the search node logs
+  py::enum_<DataLoggingFormat>(m, "DataLoggingFormat")
+      .value("csv", DataLoggingFormat::CSV)
+      .value("binary", DataLoggingFormat::Binary)
+      .export_values()
+      // allow construction from string
+      .def(py::init([](const std::string& str) -> DataLoggingFormat {
+        return dataLoggingFormatFromString(str);
+      }));
+
   // All configuration options for QMAP
   py::class_<Configuration>(
       m, "Configuration",
@@ -230,6 +291,11 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .def_readwrite("verbose", &Configuration::verbose)
       .def_readwrite("debug", &Configuration::debug)
       .def_readwrite("data_logging_path", &Configuration::dataLoggingPath)
+      .def_readwrite("data_logging_format", &Configuration::dataLoggingFormat)
+      .def_readwrite("data_logging_only_expanded_nodes",
+                     &Configuration::dataLoggingOnlyExpandedNodes)
+      .def_readwrite("data_logging_last_layers",
+                     &Configuration::dataLoggingLastLayers)
       .def_readwrite("layering", &Configuration::layering)
       .def_readwrite("automatic_layer_splits",
                      &Configuration::automaticLayerSplits)
@@ -238,6 +304,9 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .def_readwrite("early_termination", &Configuration::earlyTermination)
       .def_readwrite("early_termination_limit",
                      &Configuration::earlyTerminationLimit)
+      .def_readwrite("n_threads_expansion", &Configuration::nThreadsExpansion)
+      .def_readwrite("portfolio", &Configuration::portfolio)
+      .def_readwrite("n_threads_portfolio", &Configuration::nThreadsPortfolio)
       .def_readwrite("initial_layout", &Configuration::initialLayout)
       .def_readwrite("iterative_bidirectional_routing",
                      &Configuration::iterativeBidirectionalRouting)
@@ -257,10 +326,13 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .def_readwrite("encoding", &Configuration::encoding)
       .def_readwrite("commander_grouping", &Configuration::commanderGrouping)
       .def_readwrite("use_subsets", &Configuration::useSubsets)
+      .def_readwrite("n_threads_subsets", &Configuration::nThreadsSubsets)
       .def_readwrite("include_WCNF", &Configuration::includeWCNF)
       .def_readwrite("enable_limits", &Configuration::enableSwapLimits)
       .def_readwrite("swap_reduction", &Configuration::swapReduction)
       .def_readwrite("swap_limit", &Configuration::swapLimit)
+      .def_readwrite("cache_swap_distances",
+                     &Configuration::cacheSwapDistances)
       .def_readwrite("subgraph", &Configuration::subgraph)
       .def_readwrite("pre_mapping_optimizations",
                      &Configuration::preMappingOptimizations)
@@ -283,11 +355,24 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .def_readwrite("configuration", &MappingResults::config)
       .def_readwrite("time", &MappingResults::time)
       .def_readwrite("timeout", &MappingResults::timeout)
-      .def_readwrite("mapped_circuit", &MappingResults::mappedCircuit)
+      .def_property(
+          "mapped_circuit", &MappingResults::getMappedCircuit,
+          [](MappingResults& results, std::string qasm) {
+            results.mappedCircuit = std::move(qasm);
+            results.mappedCircuitObject.reset();
+          })
+      .def_property_readonly(
+          "mapped_circuit_object",
+          [](const MappingResults& results) {
+            return results.mappedCircuitObject.get();
+          },
+          py::return_value_policy::reference_internal)
       .def_readwrite("heuristic_benchmark", &MappingResults::heuristicBenchmark)
       .def_readwrite("layer_heuristic_benchmark",
                      &MappingResults::layerHeuristicBenchmark)
       .def_readwrite("wcnf", &MappingResults::wcnf)
+      .def_readwrite("portfolio_runs", &MappingResults::portfolioRuns)
+      .def_readwrite("portfolio_winner", &MappingResults::portfolioWinner)
       .def("json", &MappingResults::json)
       .def("csv", &MappingResults::csv)
       .def("__repr__", &MappingResults::toString);
@@ -370,6 +455,18 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
           &MappingResults::LayerHeuristicBenchmarkInfo::earlyTermination)
       .def("json", &MappingResults::LayerHeuristicBenchmarkInfo::json);
 
+  // Outcome of a single configuration run by the portfolio mapper
+  py::class_<MappingResults::PortfolioRunInfo>(
+      m, "PortfolioRunInfo", "Portfolio run information")
+      .def(py::init<>())
+      .def_readwrite("configuration", &MappingResults::PortfolioRunInfo::config)
+      .def_readwrite("time", &MappingResults::PortfolioRunInfo::time)
+      .def_readwrite("routing_gates",
+                     &MappingResults::PortfolioRunInfo::routingGates)
+      .def_readwrite("stopped_early",
+                     &MappingResults::PortfolioRunInfo::stoppedEarly)
+      .def("json", &MappingResults::PortfolioRunInfo::json);
+
   auto arch = py::class_<Architecture>(
       m, "Architecture", "Class representing device/backend information");
   auto properties = py::class_<Architecture::Properties>(
@@ -494,6 +591,11 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
 
   // Main mapping function
   m.def("map", &map, "map a quantum circuit", "circ"_a, "arch"_a, "config"_a);
+  m.def("map_batch", &mapBatch,
+        "map several quantum circuits concurrently (with a single "
+        "configuration for all circuits or one per circuit) and return the "
+        "results in the order of the circuits",
+        "circuits"_a, "arch"_a, "configs"_a, "n_threads"_a = 0);
 
   // Target metric for the Clifford synthesizer
   py::enum_<cs::TargetMetric>(m, "TargetMetric")
@@ -547,6 +649,11 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .def_readwrite("linear_search", &cs::Configuration::linearSearch,
                      "Use liner search instead of binary search "
                      "scheme for finding the optimum. Defaults to `false`.")
+      .def_readwrite(
+          "incremental_solving", &cs::Configuration::incrementalSolving,
+          "Encode the synthesis problem only once per binary or linear search "
+          "and solve it repeatedly under assumptions, so that the SAT solver "
+          "can reuse what it learned in previous calls. Defaults to `true`.")
       .def_readwrite(
           "target_metric", &cs::Configuration::target,
           "Target metric for the Clifford synthesis. Defaults to `gates`.")
@@ -569,6 +676,20 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       .def_readwrite("solver_parameters", &cs::Configuration::solverParameters,
                      "Parameters to be passed to Z3 as dict[str, bool | int | "
                      "float | str]")
+      .def_readwrite(
+          "use_cnf_backend", &cs::Configuration::useCNFBackend,
+          "Encode the synthesis problem directly into clauses and solve it "
+          "with a plain SAT solver instead of Z3. Cannot be combined with "
+          "`use_maxsat`; optimization steps that require MaxSAT still use Z3. "
+          "Of the solver parameters, only `timeout` (in milliseconds) and "
+          "`max_conflicts` are supported, and only by the built-in solver. "
+          "Defaults to `false`.")
+      .def_readwrite(
+          "cnf_solver_command", &cs::Configuration::cnfSolverCommand,
+          "Command of an external SAT solver (e.g., `kissat -q`) used by the "
+          "CNF backend. It is called with the path of a DIMACS file and has to "
+          "report its result in the format of the SAT competition. Defaults "
+          "to the built-in solver.")
       .def_readwrite(
           "minimize_gates_after_depth_optimization",
           &cs::Configuration::minimizeGatesAfterDepthOptimization,
@@ -603,8 +724,10 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
                      "Defaults to `5`.")
       .def_readwrite(
           "n_threads_heuristic", &cs::Configuration::nThreadsHeuristic,
-          "Maximum number of threads used for the heuristic optimizer. "
-          "Defaults to the number of available threads on the system.")
+          "Maximum number of threads used for the heuristic optimizer, which "
+          "also bounds the number of solver instances alive at the same time. "
+          "`0` and the default use the number of available threads on the "
+          "system.")
       .def("json", &cs::Configuration::json,
            "Returns a JSON-style dictionary of all the information present in "
            "the :class:`.Configuration`")
@@ -614,6 +737,19 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
           "Prints a JSON-formatted representation of all the information "
           "present in the :class:`.Configuration`");
 
+  // Statistics on a block synthesized by the heuristic
+  py::class_<cs::Results::HeuristicBlockInfo>(
+      m, "HeuristicBlockInfo",
+      "Statistics on a block of the circuit synthesized by the heuristic.")
+      .def(py::init<>())
+      .def_readwrite("begin", &cs::Results::HeuristicBlockInfo::begin)
+      .def_readwrite("end", &cs::Results::HeuristicBlockInfo::end)
+      .def_readwrite("depth", &cs::Results::HeuristicBlockInfo::depth)
+      .def_readwrite("runtime", &cs::Results::HeuristicBlockInfo::runtime)
+      .def_readwrite("solver_calls",
+                     &cs::Results::HeuristicBlockInfo::solverCalls)
+      .def("json", &cs::Results::HeuristicBlockInfo::json);
+
   // Results of the synthesis
   py::class_<cs::Results>(m, "SynthesisResults",
                           "Results of the MQT QMAP Clifford synthesis tool.")
@@ -633,12 +769,30 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
                              "Returns the runtime of the synthesis in seconds.")
       .def_property_readonly("solver_calls", &cs::Results::getSolverCalls,
                              "Returns the number of calls to the SAT solver.")
+      .def_property_readonly(
+          "heuristic_blocks", &cs::Results::getHeuristicBlocks,
+          "Returns statistics on the blocks synthesized by the heuristic in "
+          "circuit order.")
       .def_property_readonly(
           "circuit", &cs::Results::getResultCircuit,
           "Returns the synthesized circuit as a qasm string.")
+      .def_property_readonly(
+          "circuit_object",
+          [](const cs::Results& results) {
+            return results.getResultCircuitObject().get();
+          },
+          py::return_value_policy::reference_internal,
+          "Returns the synthesized circuit without converting it to qasm.")
       .def_property_readonly("tableau", &cs::Results::getResultTableau,
                              "Returns a string representation of the "
                              "synthesized circuit's tableau.")
+      .def_property_readonly(
+          "tableau_object",
+          [](const cs::Results& results) {
+            return results.getResultTableauObject().get();
+          },
+          py::return_value_policy::reference_internal,
+          "Returns the synthesized circuit's tableau.")
       .def("sat", &cs::Results::sat,
            "Returns `true` if the synthesis was successful.")
       .def("unsat", &cs::Results::unsat,
@@ -709,7 +863,8 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
       "target state that starts in an initial state represented by a tableau.");
   synthesizer.def("synthesize", &cs::CliffordSynthesizer::synthesize,
                   "config"_a = cs::Configuration(),
-                  "Runs the synthesis with the given configuration.");
+                  "Runs the synthesis with the given configuration.",
+                  py::call_guard<py::gil_scoped_release>());
   synthesizer.def_property_readonly("results",
                                     &cs::CliffordSynthesizer::getResults,
                                     "Returns the results of the synthesis.");
@@ -877,12 +1032,20 @@ PYBIND11_MODULE(pyqmap, m, py::mod_gil_not_used()) {
           "filename"_a, "initial_mapping"_a = na::InitialMapping::Identity)
       .def("get_mapped_qc", &na::NeutralAtomMapper::getMappedQc,
            "Returns the mapped circuit as an extended qasm2 string")
+      .def("get_mapped_qc_object", &na::NeutralAtomMapper::getMappedQcObject,
+           py::return_value_policy::reference_internal,
+           "Returns the mapped circuit without converting it to qasm")
       .def("save_mapped_qc", &na::NeutralAtomMapper::saveMappedQc,
            "Saves the mapped circuit as an extended qasm2 string to a file",
            "filename"_a)
       .def("get_mapped_qc_aod", &na::NeutralAtomMapper::getMappedQcAOD,
            "Returns the mapped circuit as an extended qasm2 string with native "
            "AOD movements")
+      .def("get_mapped_qc_aod_object",
+           &na::NeutralAtomMapper::getMappedQcAODObject,
+           py::return_value_policy::reference_internal,
+           "Returns the mapped circuit with native AOD movements without "
+           "converting it to qasm")
       .def("save_mapped_qc_aod", &na::NeutralAtomMapper::saveMappedQcAOD,
            "Saves the mapped circuit as an extended qasm2 string with native "
            "AOD movements to a file",
@@ -9,6 +9,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <optional>
 #include <queue>
@@ -16,76 +17,186 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
+CouplingGraph::CouplingGraph(const std::uint16_t nQubits,
+                             const CouplingMap& couplingMap)
+    : nqubits(nQubits) {
+  for (const auto& [q1, q2] : couplingMap) {
+    nqubits = std::max({nqubits, static_cast<std::uint16_t>(q1 + 1U),
+                        static_cast<std::uint16_t>(q2 + 1U)});
+  }
+  const auto n = static_cast<std::size_t>(nqubits);
+
+  adjacency.assign((n * n + 63) / 64, 0U);
+  for (const auto& [q1, q2] : couplingMap) {
+    const auto bit = static_cast<std::size_t>(q1) * n + q2;
+    adjacency[bit / 64] |= std::uint64_t{1} << (bit % 64);
+  }
+
+  // every undirected edge {q1, q2} is considered once via q1 < q2 or, if only
+  // present as q1 -> q2 with q1 > q2, via that directed edge
+  const auto isRepresentative = [this](const std::uint16_t q1,
+                                       const std::uint16_t q2) {
+    return q1 < q2 || (q1 > q2 && !hasEdge(q2, q1));
+  };
+  neighborOffsets.assign(n + 1, 0U);
+  for (const auto& [q1, q2] : couplingMap) {
+    if (isRepresentative(q1, q2)) {
+      ++neighborOffsets[q1 + 1U];
+      ++neighborOffsets[q2 + 1U];
+    }
+  }
+  for (std::size_t q = 0; q < n; ++q) {
+    neighborOffsets[q + 1] += neighborOffsets[q];
+  }
+  neighborList.resize(neighborOffsets[n]);
+  auto fill = neighborOffsets;
+  for (const auto& [q1, q2] : couplingMap) {
+    if (isRepresentative(q1, q2)) {
+      neighborList[fill[q1]++] = q2;
+      neighborList[fill[q2]++] = q1;
+    }
+  }
+  for (std::size_t q = 0; q < n; ++q) {
+    std::sort(neighborList.begin() +
+                  static_cast<std::ptrdiff_t>(neighborOffsets[q]),
+              neighborList.begin() +
+                  static_cast<std::ptrdiff_t>(neighborOffsets[q + 1]));
+  }
+}
+
 void Dijkstra::buildTable(const CouplingMap& couplingMap, Matrix& distanceTable,
                           const Matrix& edgeWeights) {
+  const CouplingGraph couplingGraph(
+      static_cast<std::uint16_t>(edgeWeights.size()), couplingMap);
+  buildTable(couplingGraph, distanceTable, edgeWeights);
+}
+
+void Dijkstra::buildTable(const CouplingGraph& couplingGraph,
+                          Matrix& distanceTable, const Matrix& edgeWeights) {
   // number of qubits
   const auto n = static_cast<std::uint16_t>(edgeWeights.size());
 
   distanceTable.clear();
   distanceTable.resize(n, std::vector<double>(n, -1.));
 
+  std::vector<Dijkstra::Node> nodes(n);
   for (std::uint16_t i = 0; i < n; ++i) {
-    std::vector<Dijkstra::Node> nodes(n);
     for (std::uint16_t j = 0; j < n; ++j) {
-      nodes.at(j).visited = false;
-      nodes.at(j).pos = j;
-      nodes.at(j).cost = -1.;
+      nodes[j].visited = false;
+      nodes[j].pos = j;
+      nodes[j].cost = -1.;
     }
 
-    nodes.at(i).cost = 0;
+    nodes[i].cost = 0;
 
-    dijkstra(couplingMap, nodes, i, edgeWeights);
+    dijkstra(couplingGraph, nodes, i, edgeWeights);
 
     for (std::uint16_t j = 0; j < n; ++j) {
       if (i == j) {
-        distanceTable.at(i).at(j) = 0;
+        distanceTable[i][j] = 0;
       } else {
-        distanceTable.at(i).at(j) = nodes.at(j).cost;
+        distanceTable[i][j] = nodes[j].cost;
       }
     }
   }
 }
 
-void Dijkstra::dijkstra(const CouplingMap& couplingMap,
+void Dijkstra::dijkstra(const CouplingGraph& couplingGraph,
                         std::vector<Node>& nodes, const std::uint16_t start,
                         const Matrix& edgeWeights) {
-  std::priority_queue<Node*, std::vector<Node*>, NodeComparator> queue{};
-  queue.push(&nodes.at(start));
+  // entries are (cost, qubit); outdated entries are skipped when popped
+  using QueueEntry = std::pair<double, std::uint16_t>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                      std::greater<QueueEntry>>
+      queue{};
+  queue.emplace(nodes.at(start).cost, start);
   while (!queue.empty()) {
-    auto* current = queue.top();
-    current->visited = true;
+    const auto [cost, pos] = queue.top();
     queue.pop();
-    auto pos = current->pos;
+    auto& current = nodes[pos];
+    if (current.visited) {
+      continue;
+    }
+    current.visited = true;
 
-    for (const auto& edge : couplingMap) {
-      std::optional<std::uint16_t> to = std::nullopt;
-      if (pos == edge.first) { // forward edge
-        to = edge.second;
-      } else if (pos == edge.second) { // back edge
-        to = edge.first;
+    for (const auto to : couplingGraph.neighbors(pos)) {
+      auto& next = nodes.at(to);
+      if (next.visited) {
+        continue;
       }
-      if (to.has_value()) {
-        if (nodes.at(*to).visited) {
-          continue;
-        }
-
-        Node newNode;
-        newNode.cost = current->cost + edgeWeights.at(*pos).at(*to);
-        newNode.pos = to;
-        if (nodes.at(*to).cost < 0 || newNode < nodes.at(*to)) {
-          nodes.at(*to) = newNode;
-          queue.push(&nodes.at(*to));
-        }
+      const double newCost = cost + edgeWeights[pos][to];
+      if (next.cost < 0 || newCost < next.cost) {
+        next.cost = newCost;
+        next.pos = to;
+        queue.emplace(newCost, to);
       }
     }
   }
 }
 
+namespace {
+/**
+ * @brief min-plus update of a table row:
+ * `out[j] = min(out[j], (offset + in[j]) + penalty)` for `j` in `[first, last)`
+ *
+ * kept as a plain loop over contiguous memory without aliasing between `out`
+ * and `in`, so that it is vectorized by the compiler
+ */
+void minPlusRow(double* out, const double* in, const double offset,
+                const double penalty, const std::size_t first,
+                const std::size_t last) {
+  for (std::size_t j = first; j < last; ++j) {
+    out[j] = std::min(out[j], offset + in[j] + penalty);
+  }
+}
+
+/** @brief copy the upper triangle of a table to its lower triangle */
+void mirrorUpperTriangle(DistanceTable& table) {
+  const auto n = table.size();
+  for (std::size_t q1 = 0; q1 < n; ++q1) {
+    for (std::size_t q2 = q1 + 1; q2 < n; ++q2) {
+      table(q2, q1) = table(q1, q2);
+    }
+  }
+}
+} // namespace
+
+DistanceTable::DistanceTable(const Matrix& matrix)
+    : DistanceTable(matrix.size()) {
+  for (std::size_t i = 0; i < dim; ++i) {
+    if (matrix[i].size() != dim) {
+      throw QMAPException("Distance table has to be a square matrix.");
+    }
+    std::copy(matrix[i].begin(), matrix[i].end(), row(i));
+  }
+}
+
+Matrix DistanceTable::toMatrix() const {
+  Matrix matrix(dim);
+  for (std::size_t i = 0; i < dim; ++i) {
+    matrix[i].assign(row(i), row(i) + dim);
+  }
+  return matrix;
+}
+
 void Dijkstra::buildEdgeSkipTable(const CouplingMap& couplingMap,
                                   std::vector<Matrix>& distanceTables,
                                   const Matrix& edgeWeights) {
+  std::vector<DistanceTable> tables{};
+  buildEdgeSkipTable(couplingMap, tables, edgeWeights);
+  distanceTables.clear();
+  distanceTables.reserve(tables.size());
+  for (const auto& table : tables) {
+    distanceTables.emplace_back(table.toMatrix());
+  }
+}
+
+void Dijkstra::buildEdgeSkipTable(const CouplingMap& couplingMap,
+                                  std::vector<DistanceTable>& distanceTables,
+                                  const Matrix& edgeWeights) {
   /* to find the cheapest distance between 2 qubits skipping any 1 edge, we
   iterate over all edges, for each assume the current edge to be the one skipped
   and are thereby able to retrieve the distance by just adding the distances
@@ -97,40 +208,39 @@ void Dijkstra::buildEdgeSkipTable(const CouplingMap& couplingMap,
   skipping 1 edge. The same approach can be used for skipping any 3 edges, etc.
   */
   distanceTables.clear();
-  distanceTables.emplace_back();
-  buildTable(couplingMap, distanceTables.back(), edgeWeights);
+  Matrix simpleDistanceTable{};
+  buildTable(couplingMap, simpleDistanceTable, edgeWeights);
+  distanceTables.emplace_back(simpleDistanceTable);
   const std::size_t n = edgeWeights.size();
   for (std::size_t k = 1; k <= n; ++k) {
     // k...number of edges to be skipped along each path
-    distanceTables.emplace_back(
-        n, std::vector<double>(n, std::numeric_limits<double>::max()));
-    Matrix* currentTable = &distanceTables.back();
+    distanceTables.emplace_back(n, std::numeric_limits<double>::max());
+    DistanceTable& currentTable = distanceTables.back();
     for (std::size_t q = 0; q < n; ++q) {
-      currentTable->at(q).at(q) = 0.;
+      currentTable(q, q) = 0.;
     }
-    bool done = false;
     for (const auto& [e1, e2] : couplingMap) { // edge to be skipped
       for (std::size_t l = 0; l < k; ++l) {
-        done = true;
         // l ... number of edges to skip before edge
-        for (std::size_t q1 = 0; q1 < n; ++q1) {        // q1 ... source qubit
-          for (std::size_t q2 = q1 + 1; q2 < n; ++q2) { // q2 ... target qubit
-            currentTable->at(q1).at(q2) =
-                std::min(currentTable->at(q1).at(q2),
-                         distanceTables.at(l).at(q1).at(e1) +
-                             distanceTables.at(k - l - 1).at(e2).at(q2));
-            currentTable->at(q1).at(q2) =
-                std::min(currentTable->at(q1).at(q2),
-                         distanceTables.at(l).at(q1).at(e2) +
-                             distanceTables.at(k - l - 1).at(e1).at(q2));
-            currentTable->at(q2).at(q1) = currentTable->at(q1).at(q2);
-            if (done && currentTable->at(q2).at(q1) > 0) {
-              done = false;
-            }
-          }
+        const auto& before = distanceTables[l];
+        const auto& after = distanceTables[k - l - 1];
+        // only the upper triangle (q1 < q2) is computed
+        for (std::size_t q1 = 0; q1 < n; ++q1) { // q1 ... source qubit
+          minPlusRow(currentTable.row(q1), after.row(e2), before(q1, e1), 0.,
+                     q1 + 1, n);
+          minPlusRow(currentTable.row(q1), after.row(e1), before(q1, e2), 0.,
+                     q1 + 1, n);
         }
       }
     }
+    mirrorUpperTriangle(currentTable);
+
+    bool done = !couplingMap.empty();
+    for (std::size_t q1 = 0; q1 < n && done; ++q1) {
+      const auto* row = currentTable.row(q1);
+      done = std::all_of(row + q1 + 1, row + n,
+                         [](const double d) { return d <= 0; });
+    }
     if (done) {
       // all distances of the last matrix where 0
       distanceTables.pop_back();
@@ -143,38 +253,41 @@ void Dijkstra::buildSingleEdgeSkipTable(const Matrix& distanceTable,
                                         const CouplingMap& couplingMap,
                                         const double reversalCost,
                                         Matrix& edgeSkipDistanceTable) {
+  DistanceTable table{};
+  buildSingleEdgeSkipTable(DistanceTable(distanceTable), couplingMap,
+                           reversalCost, table);
+  edgeSkipDistanceTable = table.toMatrix();
+}
+
+void Dijkstra::buildSingleEdgeSkipTable(const DistanceTable& distanceTable,
+                                        const CouplingMap& couplingMap,
+                                        const double reversalCost,
+                                        DistanceTable& edgeSkipDistanceTable) {
   const std::size_t n = distanceTable.size();
-  edgeSkipDistanceTable.clear();
-  edgeSkipDistanceTable.resize(
-      n, std::vector<double>(n, std::numeric_limits<double>::max()));
+  edgeSkipDistanceTable = DistanceTable(n, std::numeric_limits<double>::max());
   for (std::size_t q = 0; q < n; ++q) {
-    edgeSkipDistanceTable.at(q).at(q) = 0.;
+    edgeSkipDistanceTable(q, q) = 0.;
   }
-  for (const auto& [e1, e2] : couplingMap) {        // edge to be skipped
-    for (std::size_t q1 = 0; q1 < n; ++q1) {        // q1 ... source qubit
-      for (std::size_t q2 = q1 + 1; q2 < n; ++q2) { // q2 ... target qubit
-        edgeSkipDistanceTable.at(q1).at(q2) =
-            std::min(edgeSkipDistanceTable.at(q1).at(q2),
-                     distanceTable.at(q1).at(e1) + distanceTable.at(e2).at(q2));
-        edgeSkipDistanceTable.at(q1).at(q2) =
-            std::min(edgeSkipDistanceTable.at(q1).at(q2),
-                     distanceTable.at(q1).at(e2) + distanceTable.at(e1).at(q2) +
-                         reversalCost);
-        if (reversalCost == 0.) {
-          edgeSkipDistanceTable.at(q2).at(q1) =
-              edgeSkipDistanceTable.at(q1).at(q2);
-        } else {
-          edgeSkipDistanceTable.at(q2).at(q1) = std::min(
-              edgeSkipDistanceTable.at(q2).at(q1),
-              distanceTable.at(q2).at(e1) + distanceTable.at(e2).at(q1));
-          edgeSkipDistanceTable.at(q2).at(q1) =
-              std::min(edgeSkipDistanceTable.at(q2).at(q1),
-                       distanceTable.at(q2).at(e2) +
-                           distanceTable.at(e1).at(q1) + reversalCost);
-        }
+  // without reversal costs the table is symmetric and only the upper triangle
+  // (q1 < q2) is computed, otherwise all entries except for the diagonal
+  const bool symmetric = reversalCost == 0.;
+  for (const auto& [e1, e2] : couplingMap) { // edge to be skipped
+    for (std::size_t q1 = 0; q1 < n; ++q1) { // q1 ... source qubit
+      // row[q2] ... distance to target qubit q2
+      auto* row = edgeSkipDistanceTable.row(q1);
+      const auto toE1 = distanceTable(q1, e1);
+      const auto toE2 = distanceTable(q1, e2);
+      if (!symmetric) {
+        minPlusRow(row, distanceTable.row(e2), toE1, 0., 0, q1);
+        minPlusRow(row, distanceTable.row(e1), toE2, reversalCost, 0, q1);
       }
+      minPlusRow(row, distanceTable.row(e2), toE1, 0., q1 + 1, n);
+      minPlusRow(row, distanceTable.row(e1), toE2, reversalCost, q1 + 1, n);
     }
   }
+  if (symmetric) {
+    mirrorUpperTriangle(edgeSkipDistanceTable);
+  }
 }
 
 /// Create a string representation of a given permutation
@@ -216,54 +329,6 @@ void dfs(std::uint16_t current, std::set<std::uint16_t>& visited,
   }
 }
 
-std::vector<QubitSubset> subsets(const QubitSubset& input,
-                                 const std::size_t size,
-                                 const filter_function& filter) {
-  const std::size_t n = input.size();
-  std::vector<QubitSubset> result{};
-
-  if (size == 0) {
-    throw std::invalid_argument("Length of subset must be greater than 0");
-  }
-
-  if (size > n) {
-    throw std::invalid_argument("Length of subset must be less than or equal "
-                                "to the size of the input set");
-  }
-
-  if (size == 1) {
-    for (const auto& item : input) {
-      result.emplace_back();
-      result.back().emplace(item);
-    }
-  } else {
-    std::uint64_t i = (1U << size) - 1U;
-
-    while ((i >> n) == 0U) {
-      assert(i != 0U);
-      std::set<std::uint16_t> v{};
-      auto it = input.begin();
-
-      for (std::size_t j = 0U; j < n; j++, ++it) {
-        if ((i & (1U << j)) != 0U) {
-          v.emplace(*it);
-        }
-      }
-      if (filter == nullptr || filter(v)) {
-        result.emplace_back(v);
-      }
-
-      // this computes the lexicographical next bitset from a set, see
-      // https://graphics.stanford.edu/~seander/bithacks.html#NextBitPermutation
-      const std::uint64_t t = (i | (i - 1)) + 1;
-      // NOLINTNEXTLINE (clang-analyzer-core.DivideZero)
-      i = t | ((((t & -t) / (i & -i)) >> 1) - 1);
-    }
-  }
-
-  return result;
-}
-
 void parseLine(const std::string& line, char separator,
                const std::set<char>& escapeChars,
                const std::set<char>& ignoredChars,
@@ -188,6 +188,24 @@ TEST_P(SynthesisTest, GatesLinearSearch) {
   EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
 }
 
+TEST_P(SynthesisTest, GatesNonIncremental) {
+  config.target = TargetMetric::Gates;
+  config.incrementalSolving = false;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
+}
+
+TEST_P(SynthesisTest, GatesCNFBackend) {
+  config.target = TargetMetric::Gates;
+  config.useCNFBackend = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
+}
+
 TEST_P(SynthesisTest, Depth) {
   config.target = TargetMetric::Depth;
   synthesizer.synthesize(config);
@@ -255,6 +273,28 @@ TEST_P(SynthesisTest, DepthMinimalGatesLinearSearch) {
   EXPECT_EQ(results.getGates(), test.expectedMinimalGatesAtMinimalDepth);
 }
 
+TEST_P(SynthesisTest, DepthMinimalGatesNonIncremental) {
+  config.target = TargetMetric::Depth;
+  config.incrementalSolving = false;
+  config.minimizeGatesAfterDepthOptimization = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getDepth(), test.expectedMinimalDepth);
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGatesAtMinimalDepth);
+}
+
+TEST_P(SynthesisTest, DepthMinimalGatesCNFBackend) {
+  config.target = TargetMetric::Depth;
+  config.useCNFBackend = true;
+  config.minimizeGatesAfterDepthOptimization = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getDepth(), test.expectedMinimalDepth);
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGatesAtMinimalDepth);
+}
+
 TEST_P(SynthesisTest, TwoQubitGates) {
   config.target = TargetMetric::TwoQubitGates;
   config.tryHigherGateLimitForTwoQubitGateOptimization = true;
@@ -286,6 +326,19 @@ TEST_P(SynthesisTest, TwoQubitGatesMinimalGates) {
             test.expectedMinimalGatesAtMinimalTwoQubitGates);
 }
 
+TEST_P(SynthesisTest, TwoQubitGatesMinimalGatesNonIncremental) {
+  config.target = TargetMetric::TwoQubitGates;
+  config.incrementalSolving = false;
+  config.tryHigherGateLimitForTwoQubitGateOptimization = true;
+  config.minimizeGatesAfterTwoQubitGateOptimization = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getTwoQubitGates(), test.expectedMinimalTwoQubitGates);
+  EXPECT_EQ(results.getGates(),
+            test.expectedMinimalGatesAtMinimalTwoQubitGates);
+}
+
 TEST_P(SynthesisTest, TwoQubitGatesMinimalGatesMaxSAT) {
   config.target = TargetMetric::TwoQubitGates;
   config.tryHigherGateLimitForTwoQubitGateOptimization = true;
@@ -426,4 +479,81 @@ TEST(HeuristicTest, fourLayers) {
   synth.synthesize(config);
   EXPECT_EQ(synth.getResults().getDepth(), 2);
 }
+
+TEST(HeuristicTest, blocksInCircuitOrder) {
+  auto config = Configuration();
+  auto qc = qc::QuantumComputation(3);
+  qc.h(0);
+  qc.h(1);
+  qc.h(2);
+  qc.cx(0_pc, 1);
+  qc.s(2);
+  qc.cx(1_pc, 2);
+  qc.h(0);
+  qc.s(0);
+  config.heuristic = true;
+  config.splitSize = 1;
+  config.target = TargetMetric::Depth;
+
+  config.nThreadsHeuristic = 1;
+  auto sequential = CliffordSynthesizer(qc);
+  sequential.synthesize(config);
+  config.nThreadsHeuristic = 4;
+  auto parallel = CliffordSynthesizer(qc);
+  parallel.synthesize(config);
+
+  // the blocks are put together in circuit order regardless of the order in
+  // which they are synthesized
+  const auto& blocks = parallel.getResults().getHeuristicBlocks();
+  ASSERT_FALSE(blocks.empty());
+  EXPECT_EQ(blocks.front().begin, 0U);
+  EXPECT_EQ(blocks.back().end, qc.getNindividualOps());
+  std::size_t solverCalls = 0U;
+  for (std::size_t i = 0; i < blocks.size(); ++i) {
+    EXPECT_LT(blocks[i].begin, blocks[i].end);
+    if (i + 1 < blocks.size()) {
+      EXPECT_EQ(blocks[i].end, blocks[i + 1].begin);
+    }
+    solverCalls += blocks[i].solverCalls;
+  }
+  EXPECT_EQ(parallel.getResults().getSolverCalls(), solverCalls);
+  EXPECT_EQ(parallel.getResults().getResultCircuit(),
+            sequential.getResults().getResultCircuit());
+  EXPECT_EQ(parallel.getResults().getDepth(),
+            sequential.getResults().getDepth());
+}
+
+TEST(CliffordSynthesis, ResultObjects) {
+  auto qc = qc::QuantumComputation(2U);
+  qc.h(0);
+  qc.cx(0_pc, 1);
+  qc.s(1);
+
+  auto synthesizer = CliffordSynthesizer(qc);
+  synthesizer.synthesize();
+  const auto results = synthesizer.getResults();
+
+  // copies of the results share the circuit and tableau
+  const auto& circuit = results.getResultCircuitObject();
+  const auto& tableau = results.getResultTableauObject();
+  ASSERT_NE(circuit, nullptr);
+  ASSERT_NE(tableau, nullptr);
+  EXPECT_EQ(circuit, synthesizer.getResults().getResultCircuitObject());
+  EXPECT_EQ(tableau, synthesizer.getResults().getResultTableauObject());
+
+  // the strings are generated from the objects on request
+  std::stringstream qasm;
+  circuit->dumpOpenQASM3(qasm);
+  EXPECT_EQ(results.getResultCircuit(), qasm.str());
+  std::stringstream tableauString;
+  tableauString << *tableau;
+  EXPECT_EQ(results.getResultTableau(), tableauString.str());
+  EXPECT_EQ(synthesizer.getResultTableau(), *tableau);
+  EXPECT_EQ(synthesizer.getResultCircuit().getNops(), circuit->getNops());
+
+  const Results empty{};
+  EXPECT_EQ(empty.getResultCircuitObject(), nullptr);
+  EXPECT_TRUE(empty.getResultCircuit().empty());
+  EXPECT_TRUE(empty.getResultTableau().empty());
+}
 } // namespace cs
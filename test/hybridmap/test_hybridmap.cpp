@@ -4,8 +4,12 @@
 //
 
 #include "Definitions.hpp"
+#include "circuit_optimizer/CircuitOptimizer.hpp"
+#include "hybridmap/HardwareQubits.hpp"
 #include "hybridmap/HybridNeutralAtomMapper.hpp"
+#include "hybridmap/Mapping.hpp"
 #include "hybridmap/NeutralAtomArchitecture.hpp"
+#include "hybridmap/NeutralAtomLayer.hpp"
 #include "hybridmap/NeutralAtomUtils.hpp"
 #include "ir/QuantumComputation.hpp"
 
@@ -13,6 +17,7 @@
 #include <filesystem>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 
@@ -50,6 +55,105 @@ INSTANTIATE_TEST_SUITE_P(NeutralAtomArchitectureTestSuite,
                          NeutralAtomArchitectureTest,
                          ::testing::Values("rubidium", "rubidium_hybrid",
                                            "rubidium_shuttling"));
+TEST(MappingTest, SetCircuitQubit) {
+  auto mapping = na::Mapping(3, na::InitialMapping::Identity);
+  EXPECT_EQ(mapping.getHwQubit(1), 1);
+  EXPECT_EQ(mapping.getCircQubit(1), 1);
+
+  // reassigning a circuit qubit releases its previous hardware qubit
+  mapping.setCircuitQubit(0, 3);
+  EXPECT_EQ(mapping.getHwQubit(0), 3);
+  EXPECT_EQ(mapping.getCircQubit(3), 0);
+  EXPECT_FALSE(mapping.isMapped(0));
+  EXPECT_TRUE(mapping.isMapped(3));
+  EXPECT_FALSE(mapping.isMapped(4));
+  EXPECT_THROW(static_cast<void>(mapping.getCircQubit(0)), std::runtime_error);
+
+  // circuit qubits without a hardware qubit are not mapped
+  na::Mapping partial{};
+  partial.setCircuitQubit(2, 0);
+  EXPECT_EQ(partial.getHwQubit(2), 0);
+  EXPECT_THROW(static_cast<void>(partial.getHwQubit(1)), std::runtime_error);
+  EXPECT_THROW(static_cast<void>(partial.getHwQubit(5)), std::runtime_error);
+}
+
+TEST(MappingTest, ApplySwap) {
+  auto mapping = na::Mapping(3, na::InitialMapping::Identity);
+
+  // both hardware qubits are mapped
+  mapping.applySwap({1, 2});
+  EXPECT_EQ(mapping.getHwQubit(1), 2);
+  EXPECT_EQ(mapping.getHwQubit(2), 1);
+  EXPECT_EQ(mapping.getCircQubit(1), 2);
+  EXPECT_EQ(mapping.getCircQubit(2), 1);
+  EXPECT_TRUE(mapping.isMapped(1));
+  EXPECT_TRUE(mapping.isMapped(2));
+
+  // only the first hardware qubit is mapped
+  mapping.applySwap({0, 4});
+  EXPECT_EQ(mapping.getHwQubit(0), 4);
+  EXPECT_EQ(mapping.getCircQubit(4), 0);
+  EXPECT_FALSE(mapping.isMapped(0));
+  EXPECT_THROW(static_cast<void>(mapping.getCircQubit(0)), std::runtime_error);
+
+  // only the second hardware qubit is mapped
+  mapping.applySwap({3, 2});
+  EXPECT_EQ(mapping.getHwQubit(1), 3);
+  EXPECT_EQ(mapping.getCircQubit(3), 1);
+  EXPECT_FALSE(mapping.isMapped(2));
+  EXPECT_EQ(mapping.getHwQubit(2), 1);
+  EXPECT_EQ(mapping.getCircQubit(1), 2);
+
+  EXPECT_THROW(mapping.applySwap({0, 2}), std::runtime_error);
+}
+
+TEST(HardwareQubitsTest, Move) {
+  const auto arch =
+      na::NeutralAtomArchitecture("architectures/rubidium_shuttling.json");
+  // qubits 0 to 10 occupy the first coordinates of the 4 x 4 grid
+  auto hwQubits =
+      na::HardwareQubits(arch, na::InitialCoordinateMapping::Trivial, 0);
+  EXPECT_EQ(hwQubits.getSwapDistance(0, 1), 0);
+  EXPECT_THROW(hwQubits.move(0, 1), std::runtime_error);
+  EXPECT_THROW(hwQubits.move(0, arch.getNpositions()), std::runtime_error);
+
+  hwQubits.move(0, 15);
+  EXPECT_FALSE(hwQubits.isMapped(0));
+  EXPECT_EQ(hwQubits.getHwQubit(15), 0);
+  EXPECT_EQ(hwQubits.getNearbyQubits(0), (na::HwQubits{7, 10}));
+  EXPECT_EQ(hwQubits.getNearbyQubits(1).count(0), 0);
+  EXPECT_EQ(hwQubits.getSwapDistance(0, 7), 0);
+  EXPECT_EQ(hwQubits.getSwapDistance(0, 1), 2);
+
+  // distances via the moved qubit are updated when it moves back
+  hwQubits.move(0, 0);
+  EXPECT_EQ(hwQubits.getSwapDistance(0, 7), 1);
+  EXPECT_EQ(hwQubits.getSwapDistance(0, 1), 0);
+}
+
+TEST(NeutralAtomLayerTest, UpdateLayerOffset) {
+  qc::QuantumComputation qc(5);
+  // gates between distinct qubits at varying distances
+  for (qc::Qubit i = 0; i < 12; ++i) {
+    qc.cz(i % 5, (i + 1 + (i % 4)) % 5);
+    qc.h((i + 2) % 5);
+    qc.cz((i + 3) % 5, (i + 4 + (i % 3)) % 5);
+  }
+  const auto dag = qc::CircuitOptimizer::constructDAG(qc);
+  na::NeutralAtomLayer frontLayer(dag);
+  frontLayer.initLayerOffset();
+  na::NeutralAtomLayer lookaheadLayer(dag);
+  lookaheadLayer.initLayerOffset(frontLayer.getIteratorOffset());
+  // the incrementally updated layer equals a newly initialized one
+  while (!frontLayer.getGates().empty()) {
+    frontLayer.removeGatesAndUpdate({frontLayer.getGates().back()});
+    lookaheadLayer.updateLayerOffset(frontLayer.getIteratorOffset());
+    na::NeutralAtomLayer initializedLayer(dag);
+    initializedLayer.initLayerOffset(frontLayer.getIteratorOffset());
+    EXPECT_EQ(lookaheadLayer.getGates(), initializedLayer.getGates());
+  }
+}
+
 class NeutralAtomMapperTest
     // parameters are architecture, circuit, gateWeight, shuttlingWeight,
     // lookAheadWeight, initialCoordinateMapping
@@ -207,6 +207,14 @@ TEST_F(NAArchitecture, WithConfiguration) {
 
 TEST_F(NAArchitecture, SiteAt) {
   EXPECT_FALSE(arch.getSiteAt({-1000, -1000}).has_value());
+  EXPECT_FALSE(arch.getSiteAt({4, 0}).has_value());
+  EXPECT_EQ(arch.getSiteAt({3, 0}), 0);
+  EXPECT_EQ(arch.getSiteAt({13, 12}), 37);
+  EXPECT_EQ(arch.getSiteAt({0, 56}), 144);
+  const auto modArch = arch.withConfig(na::Configuration(2, 3));
+  EXPECT_EQ(modArch.getSiteAt({3, 0}), 0);
+  EXPECT_FALSE(modArch.getSiteAt({13, 0}).has_value());
+  EXPECT_EQ(modArch.getSiteAt({33, 0}), 1);
 }
 
 TEST_F(NAArchitecture, ZoneAt) {
@@ -232,6 +240,20 @@ TEST_F(NAArchitecture, GloballyAllowed) {
 
 TEST_F(NAArchitecture, SitesInZone) {
   EXPECT_EQ(arch.getSitesInZone(arch.getZoneAt({0, 0})).size(), 144);
+  EXPECT_EQ(arch.getZoneOfSite(144), 1);
+}
+
+TEST_F(NAArchitecture, SitesInRow) {
+  EXPECT_EQ(arch.getNrowsInZone(0), 4);
+  EXPECT_EQ(arch.getNrowsInZone(1), 12);
+  const auto& sites = arch.getSitesInRow(1, 1);
+  ASSERT_EQ(sites.size(), 72);
+  EXPECT_EQ(arch.getPositionOfSite(sites.front()), (na::Point{0, 61}));
+  EXPECT_EQ(arch.getPositionOfSite(sites.back()), (na::Point{355, 61}));
+  EXPECT_EQ(arch.getNearestXLeft(10, 0), 3);
+  EXPECT_EQ(arch.getNearestXLeft(13, 0, false), 13);
+  EXPECT_EQ(arch.getNearestXRight(13, 0), 23);
+  EXPECT_EQ(arch.getNearestXRight(400, 0), 400);
 }
 
 TEST_F(NAArchitecture, SiteUp) {
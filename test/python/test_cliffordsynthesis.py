@@ -7,7 +7,7 @@ from dataclasses import dataclass
 from pathlib import Path
 
 import pytest
-from qiskit import QuantumCircuit, qasm2
+from qiskit import QuantumCircuit, qasm2, qasm3
 from qiskit.quantum_info import Clifford, PauliList
 
 from mqt import qcec, qmap
@@ -285,3 +285,26 @@ def test_invalid_kwarg_to_synthesis() -> None:
     """Test that we raise an error if we pass an invalid kwarg to synthesis."""
     with pytest.raises(ValueError, match="Invalid keyword argument"):
         qmap.synthesize_clifford(target_tableau=qmap.Tableau("Z"), invalid_kwarg=True)
+
+
+def test_result_objects(bell_circuit: QuantumCircuit) -> None:
+    """Test that the synthesized circuit and tableau are available without converting them to strings."""
+    synthesizer = qmap.CliffordSynthesizer(qmap.QuantumComputation.from_qiskit(bell_circuit), False)
+    synthesizer.synthesize()
+    results = synthesizer.results
+
+    circuit = results.circuit_object
+    assert isinstance(circuit, qmap.QuantumComputation)
+    circ = qasm3.loads(results.circuit)
+    assert qcec.verify(circ, bell_circuit).considered_equivalent()
+    # the circuit object describes the same circuit as the qasm string
+    resynthesizer = qmap.CliffordSynthesizer(circuit, False)
+    resynthesizer.synthesize()
+    assert resynthesizer.results.gates == results.gates
+
+    tableau = results.tableau_object
+    assert isinstance(tableau, qmap.Tableau)
+    synthesizer = qmap.CliffordSynthesizer(tableau)
+    synthesizer.synthesize()
+    circ = qasm3.loads(synthesizer.results.circuit)
+    assert qcec.verify(circ, bell_circuit).considered_equivalent()
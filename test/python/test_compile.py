@@ -2,6 +2,7 @@
 
 from __future__ import annotations
 
+import json
 import locale
 from pathlib import Path
 
@@ -13,6 +14,8 @@ from mqt.qmap import (
     Arch,
     Architecture,
     CommanderGrouping,
+    Configuration,
+    DataLoggingFormat,
     Encoding,
     Heuristic,
     InitialLayout,
@@ -22,7 +25,13 @@ from mqt.qmap import (
     SwapReduction,
     compile,  # noqa: A004
 )
+from mqt.qmap.pyqmap import map  # noqa: A004
 from mqt.qmap.visualization import SearchVisualizer
+from mqt.qmap.visualization.visualize_search_graph import (  # noqa: PLC2701
+    _layer_data_exists,
+    _parse_search_graph,
+    _parse_search_graph_binary,
+)
 
 
 @pytest.fixture
@@ -233,3 +242,58 @@ def test_parameters(example_circuit: QuantumCircuit) -> None:
     assert results.configuration.verbose is False
     assert results.configuration.debug is False
     assert not results.configuration.data_logging_path
+
+
+def test_binary_data_logging() -> None:
+    """Test that the visualizer reads the same search graphs from binary and CSV data logs."""
+    qc = QuantumCircuit(3)
+    qc.cx(0, 2)
+    qc.cx(1, 0)
+    qc.cx(2, 1)
+    qc.cx(0, 2)
+    arch = Architecture(3, {(0, 1), (1, 0), (1, 2), (2, 1)})
+
+    graphs = {}
+    for data_logging_format in ("csv", "binary"):
+        with SearchVisualizer() as visualizer:
+            compile(qc, arch=arch, visualizer=visualizer, data_logging_format=data_logging_format)
+            path = f"{visualizer.data_logging_path}/"
+            with Path(f"{path}mapping_result.json").open(encoding=locale.getpreferredencoding(False)) as f:
+                layers = json.load(f)["statistics"]["layers"]
+            assert layers > 1
+            graphs[data_logging_format] = []
+            for layer in range(layers):
+                with Path(f"{path}layer_{layer}.json").open(encoding=locale.getpreferredencoding(False)) as f:
+                    final_node_id = json.load(f)["final_node_id"]
+                if data_logging_format == "binary":
+                    assert not Path(f"{path}nodes_layer_{layer}.csv").exists()
+                    graph, root = _parse_search_graph_binary(
+                        f"{path}nodes_layer_{layer}.bin", f"{path}swaps_layer_{layer}.bin", final_node_id, False
+                    )
+                else:
+                    graph, root = _parse_search_graph(f"{path}nodes_layer_{layer}.csv", final_node_id, False)
+                nodes = {node: data["data"] for node, data in graph.nodes(data=True)}
+                graphs[data_logging_format].append((root, nodes))
+    assert graphs["binary"] == graphs["csv"]
+
+
+def test_data_logging_last_layers(tmp_path: Path) -> None:
+    """Test that only the data of the last layers is kept in the data log."""
+    qc = QuantumCircuit(3)
+    qc.cx(0, 2)
+    qc.cx(1, 0)
+    qc.cx(2, 1)
+    arch = Architecture(3, {(0, 1), (1, 0), (1, 2), (2, 1)})
+
+    for data_logging_format in (DataLoggingFormat.csv, DataLoggingFormat.binary):
+        config = Configuration()
+        config.data_logging_path = str(tmp_path)
+        config.data_logging_format = data_logging_format
+        config.data_logging_last_layers = 1
+        results = map(qc, arch, config)
+        layers = results.input.layers
+        assert layers > 1
+        path = f"{tmp_path}/"
+        for layer in range(layers):
+            assert _layer_data_exists(path, layer) == (layer == layers - 1)
+            assert Path(f"{path}layer_{layer}.json").exists() == (layer == layers - 1)
@@ -2,12 +2,17 @@
 
 from __future__ import annotations
 
+from concurrent.futures import ThreadPoolExecutor
+
 import pytest
 from qiskit import QuantumCircuit
 from qiskit.providers.fake_provider import GenericBackendV2
 
 from mqt import qmap
 from mqt.qcec import verify
+from mqt.qmap import pyqmap
+from mqt.qmap.load_architecture import load_architecture
+from mqt.qmap.pyqmap import map_batch
 
 
 @pytest.fixture
@@ -74,3 +79,66 @@ def test_heuristic_non_trivial_swaps(backend: GenericBackendV2) -> None:
     print(result)
 
     assert result.considered_equivalent() is True
+
+
+def test_heuristic_map_batch(backend: GenericBackendV2) -> None:
+    """Verify that mapping several circuits concurrently yields the same results as mapping them one by one."""
+    circuits = []
+    for i in range(6):
+        qc = QuantumCircuit(4)
+        qc.h(0)
+        qc.cx(0, 1 + i % 3)
+        qc.cx(1 + (i + 1) % 3, 0)
+        qc.cx(3, 1 + i % 2)
+        qc.measure_all()
+        circuits.append(qc)
+
+    arch = load_architecture(backend)
+    config = qmap.Configuration()
+    results = map_batch(circuits, arch, [config], n_threads=3)
+
+    assert len(results) == len(circuits)
+    for qc, result in zip(circuits, results):
+        assert result.timeout is False
+        assert result.mapped_circuit == pyqmap.map(qc, arch, config).mapped_circuit
+
+    with pytest.raises(ValueError, match="single configuration or one per circuit"):
+        map_batch(circuits, arch, [config, config])
+
+
+def test_heuristic_map_concurrently_shared_arguments(backend: GenericBackendV2) -> None:
+    """Verify that Python threads can map with the same architecture and configuration at the same time."""
+    qc = QuantumCircuit(4)
+    qc.h(0)
+    qc.cx(0, 1)
+    qc.cx(2, 0)
+    qc.cx(3, 1)
+    qc.measure_all()
+
+    arch = load_architecture(backend)
+    config = qmap.Configuration()
+    expected = pyqmap.map(qc, arch, config).mapped_circuit
+
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        mapped = list(executor.map(lambda _: pyqmap.map(qc, arch, config).mapped_circuit, range(8)))
+    assert all(circuit == expected for circuit in mapped)
+
+
+def test_heuristic_mapped_circuit_object(backend: GenericBackendV2) -> None:
+    """Verify that the mapped circuit is kept as an object and only converted to OpenQASM on access."""
+    qc = QuantumCircuit(3)
+    qc.h(0)
+    qc.cx(0, 1)
+    qc.cx(0, 2)
+    qc.measure_all()
+
+    results = pyqmap.map(qc, load_architecture(backend), qmap.Configuration())
+    assert isinstance(results.mapped_circuit_object, pyqmap.QuantumComputation)
+    mapped_circuit = results.mapped_circuit
+    assert "OPENQASM" in mapped_circuit
+    assert results.mapped_circuit == mapped_circuit
+
+    # setting the OpenQASM string replaces the object
+    results.mapped_circuit = "OPENQASM 3.0;"
+    assert results.mapped_circuit == "OPENQASM 3.0;"
+    assert results.mapped_circuit_object is None
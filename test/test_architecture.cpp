@@ -7,12 +7,14 @@
 #include "ir/operations/OpType.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <numeric>
 #include <random>
 #include <sstream>
 #include <stdexcept>
@@ -122,6 +124,85 @@ TEST_P(TestArchitecture, ReducedMaps) {
 
   EXPECT_EQ(cms.size(), arch.getNqubits());
 }
+TEST_P(TestArchitecture, ConnectedSubsetsMatchBruteForce) {
+  const auto& archName = GetParam();
+  Architecture arch{};
+  std::stringstream ss{};
+  if (archName.find(".arch") != std::string::npos) {
+    ss << testArchitectureDir << archName;
+    arch.loadCouplingMap(ss.str());
+  } else {
+    ss << testCalibrationDir << archName;
+    arch.loadProperties(ss.str());
+  }
+
+  const auto n = arch.getNqubits();
+  for (std::uint16_t k = 1; k < n; ++k) {
+    std::vector<QubitSubset> expected{};
+    for (std::uint64_t mask = 0; mask < (std::uint64_t{1} << n); ++mask) {
+      QubitSubset subset{};
+      for (std::uint16_t q = 0; q < n; ++q) {
+        if (((mask >> q) & 1U) != 0U) {
+          subset.emplace(q);
+        }
+      }
+      if (subset.size() != k) {
+        continue;
+      }
+      CouplingMap cm{};
+      arch.getReducedCouplingMap(subset, cm);
+      if (Architecture::isConnected(subset, cm)) {
+        expected.emplace_back(subset);
+      }
+    }
+    EXPECT_EQ(arch.getAllConnectedSubsets(k), expected);
+  }
+}
+
+TEST(TestArchitecture, ConnectedSubsetsLargeDevice) {
+  // line of qubits exceeding the range of 64-bit subset masks
+  constexpr std::uint16_t N_QUBITS = 100;
+  CouplingMap cm{};
+  for (std::uint16_t q = 0; q + 1 < N_QUBITS; ++q) {
+    cm.emplace(q, q + 1);
+    cm.emplace(q + 1, q);
+  }
+  Architecture architecture{N_QUBITS, cm};
+
+  // the connected subsets of a line are exactly its segments
+  constexpr std::uint16_t SUBSET_SIZE = 5;
+  const auto subsets = architecture.getAllConnectedSubsets(SUBSET_SIZE);
+  ASSERT_EQ(subsets.size(), N_QUBITS - SUBSET_SIZE + 1);
+  for (std::size_t i = 0; i < subsets.size(); ++i) {
+    EXPECT_EQ(*subsets[i].begin(), i);
+    EXPECT_EQ(*subsets[i].rbegin(), i + SUBSET_SIZE - 1);
+  }
+}
+
+TEST(TestArchitecture, ConnectedSubsetsStopEarly) {
+  Architecture architecture{};
+  const CouplingMap cm = {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}};
+  architecture.loadCouplingMap(5, cm);
+
+  std::size_t visited = 0;
+  EXPECT_FALSE(architecture.forEachConnectedSubset(
+      2, [&visited](const QubitSubsetMask& subset) {
+        EXPECT_EQ(subset.count(), 2);
+        return ++visited < 3;
+      }));
+  EXPECT_EQ(visited, 3);
+
+  visited = 0;
+  EXPECT_TRUE(architecture.forEachConnectedSubset(
+      3, [&visited](const QubitSubsetMask& /*subset*/) {
+        ++visited;
+        return true;
+      }));
+  EXPECT_EQ(visited, 5);
+
+  EXPECT_THROW(static_cast<void>(architecture.getAllConnectedSubsets(6)),
+               QMAPException);
+}
 
 TEST(TestArchitecture, ConnectedTest) {
   Architecture architecture{};
@@ -190,6 +271,93 @@ TEST(TestArchitecture, MinimumNumberOfSwapsError) {
                std::runtime_error);
 }
 
+TEST(TestArchitecture, MinimumNumberOfSwapsLine) {
+  // on a line, the minimal number of SWAPs is the number of inversions
+  const CouplingMap cm = {{0, 1}, {1, 0}, {1, 2}, {2, 1},
+                          {2, 3}, {3, 2}, {3, 4}, {4, 3}};
+  Architecture architecture(5, cm);
+  Architecture cachedArchitecture(5, cm);
+  cachedArchitecture.setSwapDistanceCaching(true);
+  ASSERT_TRUE(cachedArchitecture.swapDistanceCaching());
+
+  std::vector<std::uint16_t> permutation{0, 1, 2, 3, 4};
+  do {
+    std::uint64_t inversions = 0;
+    for (std::size_t i = 0; i < permutation.size(); ++i) {
+      for (std::size_t j = i + 1; j < permutation.size(); ++j) {
+        if (permutation[i] > permutation[j]) {
+          ++inversions;
+        }
+      }
+    }
+
+    for (auto* arch : {&architecture, &cachedArchitecture}) {
+      EXPECT_EQ(arch->minimumNumberOfSwaps(permutation), inversions);
+      EXPECT_EQ(arch->minimumNumberOfSwaps(permutation, 2),
+                std::min<std::uint64_t>(inversions, 3));
+
+      std::vector<Edge> swaps{};
+      arch->minimumNumberOfSwaps(permutation, swaps);
+      EXPECT_EQ(swaps.size(), inversions);
+      std::vector<std::uint16_t> realized{0, 1, 2, 3, 4};
+      for (const auto& [q0, q1] : swaps) {
+        EXPECT_TRUE(arch->isEdgeConnected({q0, q1}));
+        std::swap(realized[q0], realized[q1]);
+      }
+      EXPECT_EQ(realized, permutation);
+    }
+  } while (std::next_permutation(permutation.begin(), permutation.end()));
+}
+
+TEST(TestArchitecture, MinimumNumberOfSwapsSubset) {
+  const CouplingMap cm = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+  Architecture architecture(4, cm);
+  architecture.setSwapDistanceCaching(true);
+
+  // only SWAPs between the qubits of the permutation may be used, i.e., the
+  // qubits 0 and 2 are not exchanged via qubit 3
+  std::vector<std::uint16_t> permutation{2, 1, 0};
+  EXPECT_EQ(architecture.minimumNumberOfSwaps(permutation), 3);
+  std::vector<Edge> swaps{};
+  architecture.minimumNumberOfSwaps(permutation, swaps);
+  EXPECT_EQ(swaps.size(), 3);
+
+  // the cached distances are discarded once the coupling map changes
+  architecture.setCouplingMap({{0, 1}, {1, 2}, {2, 0}});
+  EXPECT_EQ(architecture.minimumNumberOfSwaps(permutation), 1);
+  architecture.minimumNumberOfSwaps(permutation, swaps);
+  const std::vector<Edge> expected{{2, 0}};
+  EXPECT_EQ(swaps, expected);
+}
+
+TEST(TestArchitecture, MinimumNumberOfSwapsNotCachedForLargePermutations) {
+  constexpr std::uint16_t NQUBITS = 11;
+  CouplingMap cm{};
+  for (std::uint16_t q = 0; q + 1 < NQUBITS; ++q) {
+    cm.emplace(q, q + 1);
+    cm.emplace(q + 1, q);
+  }
+  Architecture architecture(NQUBITS, cm);
+  architecture.setSwapDistanceCaching(true);
+
+  // all permutations of 11 qubits are too many to be cached, hence the
+  // bidirectional search is used instead
+  std::vector<std::uint16_t> permutation(NQUBITS);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::swap(permutation[0], permutation[1]);
+  std::swap(permutation[9], permutation[10]);
+  EXPECT_EQ(architecture.minimumNumberOfSwaps(permutation), 2);
+  std::vector<Edge> swaps{};
+  architecture.minimumNumberOfSwaps(permutation, swaps);
+  EXPECT_EQ(swaps.size(), 2);
+  EXPECT_EQ(architecture.getSwapDistanceCacheSize(), 0);
+
+  // smaller permutations are still cached
+  std::vector<std::uint16_t> subset{1, 0, 2};
+  EXPECT_EQ(architecture.minimumNumberOfSwaps(subset), 1);
+  EXPECT_EQ(architecture.getSwapDistanceCacheSize(), 1);
+}
+
 TEST(TestArchitecture, TestCouplingLimitRing) {
   Architecture architecture{};
   const CouplingMap cm = {{0, 1}, {1, 0}, {1, 2}, {2, 1}, {2, 3},
@@ -951,3 +1119,28 @@ TEST(TestArchitecture, DistanceCheapestPathTest) {
   EXPECT_EQ(distances[0].size(), 2 * nrEdges + 1);
   EXPECT_NEAR(distances[0][nrEdges], nrEdges * COST_BIDIRECTIONAL_SWAP, 1e-6);
 }
+
+TEST(TestArchitecture, TeleportationDistance) {
+  // line 0 - 1 - 2 - 3 - 4, where 2 - 3 is unidirectional
+  const CouplingMap cm = {{0, 1}, {1, 0}, {1, 2}, {2, 1},
+                          {3, 2}, {3, 4}, {4, 3}};
+  Architecture architecture(5, cm);
+  const auto distanceWithoutTeleportation = architecture.distance(0, 4);
+
+  // teleportation between 1 and 4
+  architecture.setCurrentTeleportations({{1, 4}});
+  EXPECT_EQ(architecture.getCurrentTeleportations(), (CouplingMap{{1, 4}}));
+  EXPECT_EQ(architecture.distance(0, 4), 7.);
+  EXPECT_EQ(architecture.distance(4, 1), 7.);
+  EXPECT_EQ(architecture.distance(4, 2), 7.);
+  EXPECT_EQ(architecture.distance(1, 2), 0.);
+  EXPECT_EQ(architecture.distance(2, 3), 4.);
+
+  architecture.setCurrentTeleportations({});
+  EXPECT_EQ(architecture.distance(0, 4), distanceWithoutTeleportation);
+
+  // the distances of previous teleportations are reused
+  architecture.setCurrentTeleportations({{1, 4}});
+  EXPECT_EQ(architecture.distance(0, 4), 7.);
+  EXPECT_EQ(architecture.distance(2, 3), 4.);
+}
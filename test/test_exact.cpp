@@ -5,6 +5,7 @@
 
 #include "Architecture.hpp"
 #include "Definitions.hpp"
+#include "MappingResults.hpp"
 #include "configuration/AvailableArchitecture.hpp"
 #include "configuration/CommanderGrouping.hpp"
 #include "configuration/Configuration.hpp"
@@ -355,6 +356,26 @@ TEST_P(ExactTest, NoSubsets) {
   SUCCEED() << "Mapping successful";
 }
 
+TEST_P(ExactTest, ParallelSubsets) {
+  settings.verbose = false;
+  ibmQX4Mapper->map(settings);
+  const auto& sequentialResults = ibmQX4Mapper->getResults();
+
+  settings.nThreadsSubsets = 4;
+  auto parallelMapper = ExactMapper(qc, ibmQX4);
+  parallelMapper.map(settings);
+  const auto& parallelResults = parallelMapper.getResults();
+
+  ASSERT_FALSE(sequentialResults.timeout);
+  ASSERT_FALSE(parallelResults.timeout);
+  // the optimum is unique, the mapping achieving it might not be
+  const auto routingGates = [](const MappingResults& results) {
+    return (results.output.swaps * GATES_OF_UNIDIRECTIONAL_SWAP) +
+           (results.output.directionReverse * GATES_OF_DIRECTION_REVERSE);
+  };
+  EXPECT_EQ(routingGates(sequentialResults), routingGates(parallelResults));
+}
+
 TEST_P(ExactTest, toStringMethods) {
   EXPECT_EQ(toString(InitialLayout::Identity), "identity");
   EXPECT_EQ(toString(InitialLayout::Static), "static");
@@ -4,10 +4,15 @@
 //
 
 #include "Architecture.hpp"
+#include "ThreadPool.hpp"
 #include "utils.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
 TEST(General, LoadCouplingMapNonexistentFile) {
@@ -103,6 +108,46 @@ TEST(General, DijkstraCNOTReversal) {
   EXPECT_EQ(fullDistanceTable, targetTable2);
 }
 
+TEST(General, CouplingGraph) {
+  /*
+  0 <-> 1 --> 2 <-- 3    4
+  */
+  const CouplingMap cm = {{0, 1}, {1, 0}, {1, 2}, {3, 2}};
+  const CouplingGraph graph(5, cm);
+
+  EXPECT_EQ(graph.getNqubits(), 5);
+  EXPECT_TRUE(graph.hasEdge(0, 1));
+  EXPECT_TRUE(graph.hasEdge(1, 0));
+  EXPECT_TRUE(graph.hasEdge(1, 2));
+  EXPECT_FALSE(graph.hasEdge(2, 1));
+  EXPECT_FALSE(graph.hasEdge(0, 2));
+  EXPECT_FALSE(graph.hasEdge(0, 5));
+  EXPECT_TRUE(graph.isConnected(2, 1));
+  EXPECT_TRUE(graph.isBidirectional(1, 0));
+  EXPECT_FALSE(graph.isBidirectional(1, 2));
+
+  const auto neighbors = [&graph](const std::uint16_t q) {
+    const auto range = graph.neighbors(q);
+    return std::vector<std::uint16_t>(range.begin(), range.end());
+  };
+  EXPECT_EQ(neighbors(0), (std::vector<std::uint16_t>{1}));
+  EXPECT_EQ(neighbors(1), (std::vector<std::uint16_t>{0, 2}));
+  EXPECT_EQ(neighbors(2), (std::vector<std::uint16_t>{1, 3}));
+  EXPECT_EQ(neighbors(3), (std::vector<std::uint16_t>{2}));
+  EXPECT_TRUE(graph.neighbors(4).empty());
+  EXPECT_TRUE(graph.neighbors(5).empty());
+
+  // qubits beyond the given qubit count are included
+  EXPECT_EQ(CouplingGraph(2, cm).getNqubits(), 4);
+
+  const Architecture arch(5, cm);
+  EXPECT_TRUE(arch.isEdgeConnected({3, 2}));
+  EXPECT_FALSE(arch.isEdgeConnected({2, 3}));
+  EXPECT_TRUE(arch.isEdgeConnected({2, 3}, false));
+  EXPECT_TRUE(arch.isEdgeBidirectional({0, 1}));
+  EXPECT_FALSE(arch.isEdgeBidirectional({3, 2}));
+}
+
 TEST(General, DijkstraSkipEdges) {
   /*
           0 -[2]- 1 -[5]- 2
@@ -185,3 +230,39 @@ TEST(General, DijkstraSkipEdges) {
   Dijkstra::buildEdgeSkipTable(cm, edgeSkipDistanceTable, edgeWeights);
   EXPECT_EQ(edgeSkipDistanceTable, edgeSkipTargetTable);
 }
+
+TEST(General, ThreadPool) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.size(), 4);
+
+  // repeated loops of different sizes reuse the same workers
+  for (std::size_t n = 0; n < 100; ++n) {
+    std::vector<std::size_t> squares(n, 0);
+    pool.parallelFor(n, [&squares](const std::size_t i) {
+      squares[i] = i * i;
+    });
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(squares[i], i * i);
+    }
+  }
+
+  std::vector<int> calls(64, 0);
+  EXPECT_THROW(pool.parallelFor(calls.size(),
+                                [&calls](const std::size_t i) {
+                                  ++calls[i];
+                                  if (i == 13) {
+                                    throw std::runtime_error("failed");
+                                  }
+                                }),
+               std::runtime_error);
+  // the remaining iterations are still executed
+  EXPECT_EQ(std::accumulate(calls.begin(), calls.end(), 0), 64);
+
+  ThreadPool sequential(1);
+  EXPECT_EQ(sequential.size(), 1);
+  std::vector<std::size_t> order{};
+  sequential.parallelFor(3, [&order](const std::size_t i) {
+    order.emplace_back(i);
+  });
+  EXPECT_EQ(order, (std::vector<std::size_t>{0, 1, 2}));
+}
@@ -7,6 +7,7 @@
 #include "DataLogger.hpp"
 #include "Definitions.hpp"
 #include "configuration/AvailableArchitecture.hpp"
+#include "configuration/DataLoggingFormat.hpp"
 #include "configuration/EarlyTermination.hpp"
 #include "configuration/Heuristic.hpp"
 #include "configuration/InitialLayout.hpp"
@@ -14,6 +15,8 @@
 #include "configuration/LookaheadHeuristic.hpp"
 #include "configuration/Method.hpp"
 #include "heuristic/HeuristicMapper.hpp"
+#include "heuristic/PortfolioMapper.hpp"
+#include "heuristic/UniquePriorityQueue.hpp"
 #include "ir/operations/CompoundOperation.hpp"
 #include "ir/operations/Control.hpp"
 #include "ir/operations/OpType.hpp"
@@ -24,13 +27,17 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <gtest/gtest.h>
 #include <iostream>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <random>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -73,10 +80,14 @@ std::size_t getFinalNodeFromDatalog(std::string dataLoggingPath,
  * into `nodes` with each node at the position corresponding to its id.
  *
  * Only logged values are entered into the nodes, all other values are left at
- * default (e.g. `validMappedTwoQubitGates` and `sharedSwaps`)
+ * default (e.g. `validMappedTwoQubitGates` and `sharedSwaps`). The logged swaps
+ * of each node are entered into `swaps` at the position corresponding to the
+ * node's id.
  */
 void parseNodesFromDatalog(std::string dataLoggingPath, std::size_t layer,
-                           std::vector<HeuristicMapper::Node>& nodes) {
+                           std::vector<HeuristicMapper::Node>& nodes,
+                           std::vector<std::vector<Exchange>>& swaps) {
+  swaps.resize(nodes.size());
   if (dataLoggingPath.back() != '/') {
     dataLoggingPath += '/';
   }
@@ -167,6 +178,7 @@ void parseNodesFromDatalog(std::string dataLoggingPath, std::size_t layer,
                                layerNodeFilePath);
     }
     if (std::getline(lineStream, col, ';')) {
+      auto& nodeSwaps = swaps[nodeId];
       std::stringstream swapBuffer(col);
       std::string entry;
       while (std::getline(swapBuffer, entry, ',')) {
@@ -179,12 +191,19 @@ void parseNodesFromDatalog(std::string dataLoggingPath, std::size_t layer,
           // if no opType is given, the default value is SWAP
           opType = qc::opTypeFromString(opTypeStr);
         }
-        node.swaps.emplace_back(q1, q2, opType);
+        nodeSwaps.emplace_back(q1, q2, opType);
       }
     }
   }
 }
 
+void parseNodesFromDatalog(const std::string& dataLoggingPath,
+                           std::size_t layer,
+                           std::vector<HeuristicMapper::Node>& nodes) {
+  std::vector<std::vector<Exchange>> swaps{};
+  parseNodesFromDatalog(dataLoggingPath, layer, nodes, swaps);
+}
+
 /**
  * @brief Get the path from a node to the root node (id of the given node is the
  * first element, id of the root is last)
@@ -250,14 +269,16 @@ TEST_F(InternalsTest, NodeCostCalculation) {
   EXPECT_EQ(layers.size(), 1)
       << "layering failed, not able to test node cost calculation";
 
-  const std::vector<Exchange> swaps{Exchange(0, 1, qc::OpType::Teleportation),
-                                    Exchange(1, 2, SWAP)};
+  std::size_t lastSwap = NO_SWAP;
+  lastSwap = appendSwap(lastSwap, Exchange(0, 1, qc::OpType::Teleportation));
+  lastSwap = appendSwap(lastSwap, Exchange(1, 2, SWAP));
 
-  HeuristicMapper::Node node(0, 0, {4, 3, 1, 2, 0}, {4, 2, 3, 1, 0}, swaps,
-                             {{2, 3}}, 5., 0);
+  // gate 2-3 is the second 2Q-gate of layer 0
+  HeuristicMapper::Node node(0, 0, {4, 3, 1, 2, 0}, {4, 2, 3, 1, 0}, lastSwap,
+                             TwoQubitGateMask{0b10}, 5., 0);
   EXPECT_NEAR(node.costFixed, 5., FLOAT_TOLERANCE);
   EXPECT_NEAR(node.lookaheadPenalty, 0., FLOAT_TOLERANCE);
-  EXPECT_EQ(node.validMappedTwoQubitGates.size(), 1);
+  EXPECT_EQ(node.validMappedTwoQubitGates.count(), 1);
 
   results.config.heuristic = Heuristic::GateCountSumDistance;
   updateHeuristicCost(0, node);
@@ -279,7 +300,7 @@ TEST_F(InternalsTest, NodeCostCalculation) {
   EXPECT_NEAR(node.costFixed, 5. + COST_UNIDIRECTIONAL_SWAP, FLOAT_TOLERANCE);
   EXPECT_NEAR(node.costHeur, COST_UNIDIRECTIONAL_SWAP + COST_DIRECTION_REVERSE,
               FLOAT_TOLERANCE);
-  EXPECT_EQ(node.validMappedTwoQubitGates.size(), 0);
+  EXPECT_EQ(node.validMappedTwoQubitGates.count(), 0);
 
   node.lookaheadPenalty = 0.;
   EXPECT_NEAR(node.getTotalCost(),
@@ -296,7 +317,7 @@ TEST_F(InternalsTest, NodeCostCalculation) {
               FLOAT_TOLERANCE);
 
   recalculateFixedCost(0, node);
-  EXPECT_EQ(node.validMappedTwoQubitGates.size(), 0);
+  EXPECT_EQ(node.validMappedTwoQubitGates.count(), 0);
   EXPECT_NEAR(node.costFixed, COST_TELEPORTATION + COST_UNIDIRECTIONAL_SWAP * 2,
               FLOAT_TOLERANCE);
   EXPECT_NEAR(node.costHeur, COST_UNIDIRECTIONAL_SWAP + COST_DIRECTION_REVERSE,
@@ -351,11 +372,13 @@ TEST_F(InternalsTest, NodeLookaheadCalculation) {
   EXPECT_EQ(layers.size(), 4)
       << "layering failed, not able to test node cost calculation";
 
-  const std::vector<Exchange> swaps{Exchange(0, 1, qc::OpType::Teleportation),
-                                    Exchange(1, 2, SWAP)};
+  std::size_t lastSwap = NO_SWAP;
+  lastSwap = appendSwap(lastSwap, Exchange(0, 1, qc::OpType::Teleportation));
+  lastSwap = appendSwap(lastSwap, Exchange(1, 2, SWAP));
 
-  HeuristicMapper::Node node(0, 0, {4, 3, 1, 2, 0}, {4, 2, 3, 1, 0}, swaps,
-                             {{2, 3}}, 5., 0);
+  // gate 2-3 is the second 2Q-gate of layer 0
+  HeuristicMapper::Node node(0, 0, {4, 3, 1, 2, 0}, {4, 2, 3, 1, 0}, lastSwap,
+                             TwoQubitGateMask{0b10}, 5., 0);
   EXPECT_NEAR(node.lookaheadPenalty, 0., FLOAT_TOLERANCE);
 
   results.config.firstLookaheadFactor = 0.75;
@@ -1448,7 +1471,8 @@ TEST(Functionality, DataLogger) {
 
     std::vector<HeuristicMapper::Node> nodes{
         results.layerHeuristicBenchmark.at(i).generatedNodes};
-    parseNodesFromDatalog(settings.dataLoggingPath, i, nodes);
+    std::vector<std::vector<Exchange>> nodeSwaps{};
+    parseNodesFromDatalog(settings.dataLoggingPath, i, nodes, nodeSwaps);
 
     if (finalNodeId >= nodes.size() ||
         nodes.at(finalNodeId).id != finalNodeId) {
@@ -1466,8 +1490,8 @@ TEST(Functionality, DataLogger) {
       layout.emplace_back(finalSolutionNode.qubits.at(j));
     }
     std::vector<std::pair<std::uint16_t, std::uint16_t>> swaps{};
-    swaps.reserve(finalSolutionNode.swaps.size());
-    for (auto& swap : finalSolutionNode.swaps) {
+    swaps.reserve(nodeSwaps.at(finalNodeId).size());
+    for (auto& swap : nodeSwaps.at(finalNodeId)) {
       swaps.emplace_back(swap.first, swap.second);
     }
     EXPECT_EQ(layerJson["final_layout"], layout);
@@ -1519,6 +1543,217 @@ TEST(Functionality, DataLogger) {
   }
 }
 
+TEST(Functionality, DataLoggerBinaryFormat) {
+  Architecture architecture{};
+  const CouplingMap cm = {{0, 1}, {1, 0}, {1, 2}, {2, 1}, {1, 3}, {3, 1}};
+  architecture.loadCouplingMap(4, cm);
+
+  qc::QuantumComputation qc{4, 4};
+  qc.cx(0, 2);
+  qc.cx(3, 0);
+  qc.cx(2, 3);
+  qc.cx(0, 1);
+
+  Configuration settings{};
+  settings.heuristic = Heuristic::GateCountMaxDistance;
+  settings.layering = Layering::IndividualGates;
+  settings.initialLayout = InitialLayout::Identity;
+  settings.preMappingOptimizations = false;
+  settings.postMappingOptimizations = false;
+  settings.lookaheadHeuristic = LookaheadHeuristic::GateCountMaxDistance;
+  settings.nrLookaheads = 1;
+  settings.debug = true;
+
+  const auto mapWithLog = [&](const std::string& path,
+                              const DataLoggingFormat format,
+                              const std::size_t lastLayers) {
+    if (std::filesystem::exists(path)) {
+      std::filesystem::remove_all(path);
+    }
+    settings.dataLoggingPath = path;
+    settings.dataLoggingFormat = format;
+    settings.dataLoggingLastLayers = lastLayers;
+    auto mapper = std::make_unique<HeuristicMapper>(qc, architecture);
+    mapper->map(settings);
+    return mapper->getResults();
+  };
+  const std::string csvPath = "test_log/datalogger_binary_csv/";
+  const std::string binaryPath = "test_log/datalogger_binary/";
+  const auto results = mapWithLog(csvPath, DataLoggingFormat::CSV, 0);
+  const auto layers = results.input.layers;
+  ASSERT_EQ(mapWithLog(binaryPath, DataLoggingFormat::Binary, 0).input.layers,
+            layers);
+
+  const auto readFile = [](const std::string& path) {
+    auto file = std::ifstream(path, std::ios::binary);
+    EXPECT_TRUE(file.is_open()) << "Could not open file " << path;
+    return std::string(std::istreambuf_iterator<char>(file), {});
+  };
+  const auto nqubits = architecture.getNqubits();
+  const std::size_t recordSize =
+      (DataLogger::BINARY_NODE_HEADER_SIZE + 2 * nqubits + 7) / 8 * 8;
+  for (std::size_t i = 0; i < layers; ++i) {
+    const auto layer = std::to_string(i);
+    std::vector<HeuristicMapper::Node> nodes{
+        results.layerHeuristicBenchmark.at(i).generatedNodes};
+    std::vector<std::vector<Exchange>> swaps{};
+    parseNodesFromDatalog(csvPath, i, nodes, swaps);
+    const auto csvData = readFile(csvPath + "nodes_layer_" + layer + ".csv");
+    const auto nRecords = static_cast<std::size_t>(
+        std::count(csvData.begin(), csvData.end(), '\n'));
+    const auto nodeData =
+        readFile(binaryPath + "nodes_layer_" + layer + ".bin");
+    const auto swapData =
+        readFile(binaryPath + "swaps_layer_" + layer + ".bin");
+    ASSERT_GE(nodeData.size(), DataLogger::BINARY_HEADER_SIZE);
+    ASSERT_GE(swapData.size(), DataLogger::BINARY_HEADER_SIZE);
+    EXPECT_EQ(nodeData.substr(0, 8), "QMAPNODE");
+    EXPECT_EQ(swapData.substr(0, 8), "QMAPSWAP");
+    ASSERT_EQ(nodeData.size() - DataLogger::BINARY_HEADER_SIZE,
+              nRecords * recordSize);
+
+    // swaps are stored in the order of the node records
+    std::size_t swapCount = 0;
+    for (std::size_t j = 0; j < nRecords; ++j) {
+      const auto* record =
+          nodeData.data() + DataLogger::BINARY_HEADER_SIZE + j * recordSize;
+      std::uint64_t id = 0;
+      std::uint64_t parent = 0;
+      double costHeur = 0.;
+      std::uint64_t swapsBegin = 0;
+      std::uint32_t nSwaps = 0;
+      std::memcpy(&id, record, sizeof(id));
+      std::memcpy(&parent, record + 8, sizeof(parent));
+      std::memcpy(&costHeur, record + 24, sizeof(costHeur));
+      std::memcpy(&swapsBegin, record + 48, sizeof(swapsBegin));
+      std::memcpy(&nSwaps, record + 56, sizeof(nSwaps));
+      ASSERT_LT(id, nodes.size());
+      const auto& node = nodes.at(id);
+      EXPECT_EQ(id, node.id);
+      EXPECT_EQ(parent, node.parent);
+      EXPECT_DOUBLE_EQ(costHeur, node.costHeur);
+      EXPECT_EQ(record[60], static_cast<char>(node.validMapping));
+      for (std::size_t q = 0; q < nqubits; ++q) {
+        std::int16_t qubit = 0;
+        std::memcpy(&qubit, record + 64 + 2 * q, sizeof(qubit));
+        EXPECT_EQ(qubit, node.qubits.at(q));
+      }
+      EXPECT_EQ(swapsBegin, swapCount);
+      ASSERT_EQ(nSwaps, swaps.at(id).size());
+      for (std::size_t k = 0; k < nSwaps; ++k) {
+        const auto* swapRecord = swapData.data() +
+                                 DataLogger::BINARY_HEADER_SIZE +
+                                 (swapsBegin + k) * DataLogger::BINARY_SWAP_SIZE;
+        std::uint16_t first = 0;
+        std::uint16_t second = 0;
+        std::memcpy(&first, swapRecord, sizeof(first));
+        std::memcpy(&second, swapRecord + 2, sizeof(second));
+        EXPECT_EQ(first, swaps.at(id).at(k).first);
+        EXPECT_EQ(second, swaps.at(id).at(k).second);
+      }
+      swapCount += nSwaps;
+    }
+    EXPECT_EQ(swapData.size() - DataLogger::BINARY_HEADER_SIZE,
+              swapCount * DataLogger::BINARY_SWAP_SIZE);
+  }
+
+  // only the search nodes of the last layer are kept
+  mapWithLog(binaryPath, DataLoggingFormat::Binary, 1);
+  for (std::size_t i = 0; i < layers; ++i) {
+    const auto nodesFile =
+        binaryPath + "nodes_layer_" + std::to_string(i) + ".bin";
+    EXPECT_EQ(std::filesystem::exists(nodesFile), i + 1 == layers)
+        << nodesFile;
+    EXPECT_EQ(std::filesystem::exists(binaryPath + "layer_" +
+                                      std::to_string(i) + ".json"),
+              i + 1 == layers);
+  }
+}
+
+namespace {
+/** element with a key identifying equivalent elements and a cost */
+using KeyCostPair = std::pair<int, double>;
+struct KeyHash {
+  std::size_t operator()(const KeyCostPair& x) const {
+    return std::hash<int>{}(x.first);
+  }
+};
+struct KeyEqual {
+  bool operator()(const KeyCostPair& x, const KeyCostPair& y) const {
+    return x.first == y.first;
+  }
+};
+struct CostGreater {
+  bool operator()(const KeyCostPair& x, const KeyCostPair& y) const {
+    return x.second > y.second ||
+           (x.second == y.second && x.first > y.first);
+  }
+};
+} // namespace
+
+TEST(Functionality, UniquePriorityQueueDecreaseKey) {
+  UniquePriorityQueue<KeyCostPair, CostGreater, KeyHash, KeyEqual> queue{};
+  EXPECT_TRUE(queue.push({1, 5.}));
+  EXPECT_TRUE(queue.push({2, 3.}));
+  EXPECT_TRUE(queue.push({3, 4.}));
+  // cheaper equivalent element replaces the present one
+  EXPECT_TRUE(queue.push({1, 2.}));
+  // more expensive equivalent element is discarded
+  EXPECT_FALSE(queue.push({2, 6.}));
+  EXPECT_EQ(queue.size(), 3U);
+
+  const auto copy = queue;
+  for (const auto& expected :
+       std::vector<KeyCostPair>{{1, 2.}, {2, 3.}, {3, 4.}}) {
+    ASSERT_FALSE(queue.empty());
+    EXPECT_EQ(queue.top(), expected);
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+
+  // popped elements may be inserted again
+  EXPECT_TRUE(queue.push({1, 7.}));
+  EXPECT_EQ(queue.top(), KeyCostPair(1, 7.));
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+
+  // copies have their own index
+  EXPECT_EQ(copy.size(), 3U);
+  EXPECT_EQ(copy.top(), KeyCostPair(1, 2.));
+}
+
+TEST(Functionality, UniquePriorityQueueOrder) {
+  // compare against a reference keeping only the cheapest element per key
+  UniquePriorityQueue<KeyCostPair, CostGreater, KeyHash, KeyEqual> queue{};
+  std::map<int, double> reference{};
+  std::uint32_t state = 42;
+  const auto next = [&state]() {
+    state = state * 1664525U + 1013904223U;
+    return state >> 8U;
+  };
+  for (std::size_t i = 0; i < 5000; ++i) {
+    if (next() % 4 == 0 && !queue.empty()) {
+      const auto best = std::min_element(
+          reference.begin(), reference.end(), [](const auto& x, const auto& y) {
+            return CostGreater{}({y.first, y.second}, {x.first, x.second});
+          });
+      EXPECT_EQ(queue.top(), KeyCostPair(best->first, best->second));
+      reference.erase(best);
+      queue.pop();
+      continue;
+    }
+    const KeyCostPair element{static_cast<int>(next() % 200),
+                              static_cast<double>(next() % 1000)};
+    const auto [it, inserted] = reference.emplace(element);
+    const bool improved = !inserted && element.second < it->second;
+    if (improved) {
+      it->second = element.second;
+    }
+    EXPECT_EQ(queue.push(element), inserted || improved);
+    EXPECT_EQ(queue.size(), reference.size());
+  }
+}
+
 TEST(Functionality, terminationStrategyFromString) {
   const std::vector<std::pair<std::string, EarlyTermination>>
       terminationStrategies = {
@@ -2526,3 +2761,337 @@ TEST(HeuristicTestFidelity, LayerSplitting) {
            << " does not exist";
   }
 }
+
+class IncrementalCostMapper : public HeuristicMapper {
+public:
+  using HeuristicMapper::HeuristicMapper;
+
+  void setIncrementalCostUpdates(const bool enabled) {
+    incrementalCostUpdates = enabled;
+  }
+
+  /**
+   * @brief applies random swaps in each layer, where the costs of each new
+   * node are once derived incrementally from its parent and once calculated
+   * from scratch
+   *
+   * @return pairs of the incrementally updated and the recalculated node
+   */
+  std::vector<std::pair<Node, Node>>
+  randomSwapWalks(const Configuration& configuration,
+                  const std::size_t swapsPerLayer) {
+    results = MappingResults{};
+    results.config = configuration;
+    tightHeur = isTight(configuration.heuristic);
+    fidelityAwareHeur = isFidelityAware(configuration.heuristic);
+    createLayers();
+    createInitialMapping();
+
+    const std::vector<Edge> edges(architecture->getCouplingMap().begin(),
+                                  architecture->getCouplingMap().end());
+    std::mt19937_64 rng(42); // NOLINT(cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> pick(0, edges.size() - 1);
+
+    std::vector<std::pair<Node, Node>> nodePairs{};
+    for (std::size_t layer = 0; layer < layers.size(); ++layer) {
+      nextNodeId = 0;
+      swapHistory.clear();
+      mapUnmappedGates(layer);
+      prepareIncrementalCostUpdates(layer);
+
+      Node node(nextNodeId++);
+      node.locations = locations;
+      node.qubits = qubits;
+      recalculateFixedCost(layer, node);
+      updateHeuristicCost(layer, node);
+      updateLookaheadPenalty(layer, node);
+
+      for (std::size_t i = 0; i < swapsPerLayer; ++i) {
+        const auto& swap = edges.at(pick(rng));
+        Node incremental = createSuccessor(node);
+        Node recalculated = createSuccessor(node);
+        applySWAP(swap, layer, incremental, &node);
+        applySWAP(swap, layer, recalculated);
+        nodePairs.emplace_back(incremental, recalculated);
+        node = incremental;
+      }
+    }
+    return nodePairs;
+  }
+};
+
+class IncrementalCostTest : public testing::TestWithParam<std::string> {
+protected:
+  std::string testExampleDir = "../examples/";
+
+  qc::QuantumComputation qc;
+  Architecture ibmQX5; // 16 qubits, unidirectional
+  Architecture ibmqLondon;
+  Configuration settings{};
+
+  static constexpr std::array<Heuristic, 3> HEURISTICS = {
+      Heuristic::GateCountMaxDistance, Heuristic::GateCountSumDistance,
+      Heuristic::GateCountSumDistanceMinusSharedSwaps};
+  static constexpr std::array<LookaheadHeuristic, 3> LOOKAHEAD_HEURISTICS = {
+      LookaheadHeuristic::None, LookaheadHeuristic::GateCountMaxDistance,
+      LookaheadHeuristic::GateCountSumDistance};
+
+  void SetUp() override {
+    qc.import(testExampleDir + GetParam() + ".qasm");
+    ibmQX5.loadCouplingMap(AvailableArchitecture::IbmQx5);
+    ibmqLondon.loadCouplingMap(AvailableArchitecture::IbmqLondon);
+    settings.debug = true;
+    settings.automaticLayerSplits = false;
+    settings.preMappingOptimizations = false;
+    settings.postMappingOptimizations = false;
+    settings.layering = Layering::Disjoint2qBlocks;
+    settings.lookaheadFactor = 0.75;
+    settings.nrLookaheads = 3;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Heuristic, IncrementalCostTest,
+    testing::Values("3_17_13", "ex-1_166", "ham3_102", "miller_11", "4gt11_84",
+                    "4mod5-v0_20", "mod5d1_63"),
+    [](const testing::TestParamInfo<IncrementalCostTest::ParamType>& inf) {
+      std::string name = inf.param;
+      std::replace(name.begin(), name.end(), '-', '_');
+      return name;
+    });
+
+TEST_P(IncrementalCostTest, SameCostsAsRecalculation) {
+  settings.initialLayout = InitialLayout::Dynamic;
+  for (auto* arch : {&ibmQX5, &ibmqLondon}) {
+    for (const auto heuristic : HEURISTICS) {
+      for (const auto lookahead : LOOKAHEAD_HEURISTICS) {
+        settings.heuristic = heuristic;
+        settings.lookaheadHeuristic = lookahead;
+        IncrementalCostMapper mapper(qc, *arch);
+        const auto nodePairs = mapper.randomSwapWalks(settings, 50);
+        ASSERT_FALSE(nodePairs.empty());
+        for (const auto& [incremental, recalculated] : nodePairs) {
+          // costs have to be exactly (not only approximately) the same
+          EXPECT_EQ(incremental.validMapping, recalculated.validMapping);
+          EXPECT_EQ(incremental.costHeur, recalculated.costHeur);
+          EXPECT_EQ(incremental.lookaheadPenalty,
+                    recalculated.lookaheadPenalty);
+          EXPECT_EQ(incremental.getTotalCost(), recalculated.getTotalCost());
+        }
+      }
+    }
+  }
+}
+
+TEST_P(IncrementalCostTest, SameMappingAsRecalculation) {
+  for (const auto initialLayout :
+       {InitialLayout::Identity, InitialLayout::Dynamic}) {
+    for (const auto heuristic : HEURISTICS) {
+      for (const auto lookahead : LOOKAHEAD_HEURISTICS) {
+        settings.initialLayout = initialLayout;
+        settings.heuristic = heuristic;
+        settings.lookaheadHeuristic = lookahead;
+
+        IncrementalCostMapper incrementalMapper(qc, ibmQX5);
+        incrementalMapper.map(settings);
+        IncrementalCostMapper recalculatingMapper(qc, ibmQX5);
+        recalculatingMapper.setIncrementalCostUpdates(false);
+        recalculatingMapper.map(settings);
+
+        const auto& incrementalResults = incrementalMapper.getResults();
+        const auto& recalculatingResults = recalculatingMapper.getResults();
+        EXPECT_EQ(incrementalResults.output.swaps,
+                  recalculatingResults.output.swaps);
+        EXPECT_EQ(incrementalResults.output.directionReverse,
+                  recalculatingResults.output.directionReverse);
+        ASSERT_EQ(incrementalResults.layerHeuristicBenchmark.size(),
+                  recalculatingResults.layerHeuristicBenchmark.size());
+        for (std::size_t i = 0;
+             i < incrementalResults.layerHeuristicBenchmark.size(); ++i) {
+          const auto& incrementalLayer =
+              incrementalResults.layerHeuristicBenchmark.at(i);
+          const auto& recalculatingLayer =
+              recalculatingResults.layerHeuristicBenchmark.at(i);
+          EXPECT_EQ(incrementalLayer.expandedNodes,
+                    recalculatingLayer.expandedNodes);
+          EXPECT_EQ(incrementalLayer.generatedNodes,
+                    recalculatingLayer.generatedNodes);
+          EXPECT_EQ(incrementalLayer.solutionDepth,
+                    recalculatingLayer.solutionDepth);
+        }
+
+        std::stringstream incrementalQasm{};
+        incrementalMapper.dumpResult(incrementalQasm, qc::Format::OpenQASM3);
+        std::stringstream recalculatingQasm{};
+        recalculatingMapper.dumpResult(recalculatingQasm,
+                                       qc::Format::OpenQASM3);
+        EXPECT_EQ(incrementalQasm.str(), recalculatingQasm.str());
+      }
+    }
+  }
+}
+
+TEST_P(IncrementalCostTest, ParallelExpansion) {
+  settings.initialLayout = InitialLayout::Dynamic;
+  settings.lookaheadHeuristic = LookaheadHeuristic::GateCountMaxDistance;
+  for (const auto heuristic : HEURISTICS) {
+    settings.heuristic = heuristic;
+
+    settings.nThreadsExpansion = 1;
+    HeuristicMapper sequentialMapper(qc, ibmQX5);
+    sequentialMapper.map(settings);
+    settings.nThreadsExpansion = 4;
+    HeuristicMapper parallelMapper(qc, ibmQX5);
+    parallelMapper.map(settings);
+
+    const auto& sequentialResults = sequentialMapper.getResults();
+    const auto& parallelResults = parallelMapper.getResults();
+    EXPECT_EQ(sequentialResults.output.swaps, parallelResults.output.swaps);
+    EXPECT_EQ(sequentialResults.heuristicBenchmark.generatedNodes,
+              parallelResults.heuristicBenchmark.generatedNodes);
+    EXPECT_EQ(sequentialResults.heuristicBenchmark.expandedNodes,
+              parallelResults.heuristicBenchmark.expandedNodes);
+
+    std::stringstream sequentialQasm{};
+    sequentialMapper.dumpResult(sequentialQasm, qc::Format::OpenQASM3);
+    std::stringstream parallelQasm{};
+    parallelMapper.dumpResult(parallelQasm, qc::Format::OpenQASM3);
+    EXPECT_EQ(sequentialQasm.str(), parallelQasm.str());
+  }
+}
+
+class PortfolioTest : public testing::TestWithParam<std::string> {
+protected:
+  std::string testExampleDir = "../examples/";
+
+  qc::QuantumComputation qc;
+  Architecture ibmQX5; // 16 qubits, unidirectional
+  Configuration settings{};
+
+  void SetUp() override {
+    qc.import(testExampleDir + GetParam() + ".qasm");
+    ibmQX5.loadCouplingMap(AvailableArchitecture::IbmQx5);
+    settings.method = Method::Portfolio;
+    settings.automaticLayerSplits = false;
+    settings.layering = Layering::Disjoint2qBlocks;
+    settings.nrLookaheads = 3;
+    for (const auto heuristic :
+         {Heuristic::GateCountMaxDistance, Heuristic::GateCountSumDistance}) {
+      for (const auto lookahead :
+           {LookaheadHeuristic::None, LookaheadHeuristic::GateCountMaxDistance,
+            LookaheadHeuristic::GateCountSumDistance}) {
+        auto config = settings;
+        config.method = Method::Heuristic;
+        config.heuristic = heuristic;
+        config.lookaheadHeuristic = lookahead;
+        settings.portfolio.emplace_back(config);
+      }
+    }
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Heuristic, PortfolioTest,
+    testing::Values("3_17_13", "ex-1_166", "ham3_102", "4gt11_84",
+                    "mod5d1_63"),
+    [](const testing::TestParamInfo<PortfolioTest::ParamType>& inf) {
+      std::string name = inf.param;
+      std::replace(name.begin(), name.end(), '-', '_');
+      return name;
+    });
+
+TEST_P(PortfolioTest, BestOfIndividualRuns) {
+  std::size_t expectedWinner = 0;
+  std::size_t bestRoutingGates = 0;
+  std::size_t bestGates = 0;
+  std::string bestQasm;
+  std::vector<std::size_t> routingGates{};
+  for (std::size_t i = 0; i < settings.portfolio.size(); ++i) {
+    HeuristicMapper mapper(qc, ibmQX5);
+    mapper.map(settings.portfolio.at(i));
+    routingGates.emplace_back(mapper.getRoutingGates());
+    const auto gates = mapper.getResults().output.gates;
+    if (i == 0 || mapper.getRoutingGates() < bestRoutingGates ||
+        (mapper.getRoutingGates() == bestRoutingGates && gates < bestGates)) {
+      expectedWinner = i;
+      bestRoutingGates = mapper.getRoutingGates();
+      bestGates = gates;
+      std::stringstream qasm{};
+      mapper.dumpResult(qasm, qc::Format::OpenQASM3);
+      bestQasm = qasm.str();
+    }
+  }
+
+  settings.nThreadsPortfolio = 4;
+  PortfolioMapper portfolioMapper(qc, ibmQX5);
+  portfolioMapper.map(settings);
+  const auto& results = portfolioMapper.getResults();
+  EXPECT_FALSE(results.timeout);
+  EXPECT_EQ(results.portfolioWinner, expectedWinner);
+  EXPECT_EQ(results.output.gates, bestGates);
+  ASSERT_EQ(results.portfolioRuns.size(), settings.portfolio.size());
+  for (std::size_t i = 0; i < results.portfolioRuns.size(); ++i) {
+    const auto& run = results.portfolioRuns.at(i);
+    if (run.stoppedEarly) {
+      EXPECT_GT(routingGates.at(i), bestRoutingGates);
+    } else {
+      EXPECT_EQ(run.routingGates, routingGates.at(i));
+    }
+  }
+  EXPECT_FALSE(results.portfolioRuns.at(expectedWinner).stoppedEarly);
+
+  std::stringstream qasm{};
+  portfolioMapper.dumpResult(qasm, qc::Format::OpenQASM3);
+  EXPECT_EQ(qasm.str(), bestQasm);
+}
+
+TEST_P(PortfolioTest, IndependentOfThreads) {
+  settings.nThreadsPortfolio = 1;
+  PortfolioMapper sequentialMapper(qc, ibmQX5);
+  sequentialMapper.map(settings);
+  settings.nThreadsPortfolio = 3;
+  PortfolioMapper parallelMapper(qc, ibmQX5);
+  parallelMapper.map(settings);
+
+  EXPECT_EQ(sequentialMapper.getResults().portfolioWinner,
+            parallelMapper.getResults().portfolioWinner);
+  std::stringstream sequentialQasm{};
+  sequentialMapper.dumpResult(sequentialQasm, qc::Format::OpenQASM3);
+  std::stringstream parallelQasm{};
+  parallelMapper.dumpResult(parallelQasm, qc::Format::OpenQASM3);
+  EXPECT_EQ(sequentialQasm.str(), parallelQasm.str());
+}
+
+TEST(Portfolio, DefaultPortfolio) {
+  const auto portfolio = PortfolioMapper::defaultPortfolio(Configuration{});
+  EXPECT_EQ(portfolio.size(), 6U);
+  for (const auto& config : portfolio) {
+    EXPECT_EQ(config.method, Method::Heuristic);
+    EXPECT_TRUE(config.portfolio.empty());
+  }
+  EXPECT_EQ(methodFromString("portfolio"), Method::Portfolio);
+  EXPECT_EQ(toString(Method::Portfolio), "portfolio");
+
+  qc::QuantumComputation qc{3U};
+  qc.cx(qc::Control{0}, 1);
+  qc.cx(qc::Control{1}, 2);
+  qc.cx(qc::Control{2}, 0);
+  Architecture arch{};
+  arch.loadCouplingMap(AvailableArchitecture::IbmqLondon);
+
+  Configuration settings{};
+  settings.method = Method::Portfolio;
+  PortfolioMapper mapper(qc, arch);
+  mapper.map(settings);
+  const auto& results = mapper.getResults();
+  EXPECT_EQ(results.portfolioRuns.size(), portfolio.size());
+  EXPECT_EQ(results.config.method, Method::Heuristic);
+  const auto json = results.json();
+  EXPECT_EQ(json["statistics"]["portfolio"]["runs"].size(), portfolio.size());
+  EXPECT_EQ(json["statistics"]["portfolio"]["winner"],
+            results.portfolioWinner);
+
+  settings.portfolio = {Configuration{}};
+  settings.portfolio.front().method = Method::Exact;
+  EXPECT_THROW(mapper.map(settings), QMAPException);
+}
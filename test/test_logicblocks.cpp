@@ -1,14 +1,19 @@
 
+#include "CNFLogic.hpp"
 #include "Encodings.hpp"
 #include "Logic.hpp"
 #include "LogicTerm.hpp"
 #include "Model.hpp"
 #include "Z3Logic.hpp"
+#include "util_logicblock.hpp"
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <gtest/gtest.h>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <z3++.h>
@@ -483,6 +488,74 @@ TEST_F(TestZ3, TestBasicModel) {
   z3logic.reset();
 }
 
+TEST_F(TestZ3, SolveWithAssumptions) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, true);
+
+  const LogicTerm a = z3logic.makeVariable("a", CType::BOOL);
+  const LogicTerm b = z3logic.makeVariable("b", CType::BOOL);
+  z3logic.assertFormula(a || b);
+  z3logic.assertFormula(LogicTerm::implies(a, !b));
+
+  EXPECT_EQ(z3logic.solve({a}), Result::SAT);
+  EXPECT_EQ(z3logic.getModel()->getBoolValue(b, &z3logic), false);
+  EXPECT_EQ(z3logic.solve({a, b}), Result::UNSAT);
+  EXPECT_EQ(z3logic.solve({!a}), Result::SAT);
+  EXPECT_EQ(z3logic.getModel()->getBoolValue(b, &z3logic), true);
+
+  // formulas asserted between calls are considered by subsequent calls
+  z3logic.assertFormula(!b);
+  EXPECT_EQ(z3logic.solve({!a}), Result::UNSAT);
+  EXPECT_EQ(z3logic.solve({}), Result::SAT);
+  EXPECT_EQ(z3logic.getModel()->getBoolValue(a, &z3logic), true);
+}
+
+TEST_F(TestZ3, SharedSubterms) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, true);
+
+  const LogicTerm a = z3logic.makeVariable("a", CType::BOOL);
+  const LogicTerm b = z3logic.makeVariable("b", CType::INT);
+  const LogicTerm c = z3logic.makeVariable("c", CType::INT);
+
+  // structurally identical terms share their id
+  const auto t1 = LogicTerm::implies(a, b + c > LogicTerm(2));
+  const auto t2 = LogicTerm::implies(a, b + c > LogicTerm(2));
+  EXPECT_EQ(t1.getID(), t2.getID());
+  EXPECT_TRUE(t1.deepEquals(t2));
+  EXPECT_EQ(t1.getNodes()[1].getID(), (b + c > LogicTerm(2)).getID());
+  EXPECT_NE((b + c > LogicTerm(3)).getID(), t1.getNodes()[1].getID());
+  EXPECT_NE((c + b).getID(), (b + c).getID());
+
+  z3logic.assertFormula(t1);
+  z3logic.assertFormula(t2);
+  z3logic.assertFormula(a && b == LogicTerm(1));
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+  EXPECT_GT(z3logic.getModel()->getIntValue(c, &z3logic), 1);
+
+  z3logic.reset();
+  EXPECT_EQ(z3logic.getTermTable()->size(), 0U);
+}
+
+TEST_F(TestZ3, WideBitvectors) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, true);
+
+  // bits beyond the width of the bitvector are dropped
+  const std::vector<uint64_t> words{0x8000000000000001U, 0U, 0xFFU};
+  const LogicTerm wide(words, 130);
+  EXPECT_EQ(wide.getBitVectorWords(),
+            (std::vector<uint64_t>{0x8000000000000001U, 0U, 0x3U}));
+
+  const LogicTerm a = z3logic.makeVariable("a", CType::BITVECTOR, 130);
+  const LogicTerm b = z3logic.makeVariable("b", CType::BITVECTOR, 64);
+  z3logic.assertFormula(a == wide);
+  z3logic.assertFormula(b == LogicTerm(0x8000000000000000U, 64));
+
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+  auto* model = z3logic.getModel();
+  EXPECT_EQ(model->getBitvectorWords(a, &z3logic), wide.getBitVectorWords());
+  EXPECT_EQ(model->getBitvectorWords(b, &z3logic),
+            std::vector<uint64_t>{0x8000000000000000U});
+}
+
 TEST_F(TestZ3, TestVariableConversionsToBool) {
   std::unique_ptr<z3logic::Z3LogicBlock> z3logic =
       std::make_unique<z3logic::Z3LogicBlock>(ctx, solver, true);
@@ -937,3 +1010,222 @@ TEST_F(TestZ3Opt, AMOAndExactlyOneNaive) {
   z3logic->produceInstance();
   EXPECT_EQ(z3logic->solve(), Result::SAT);
 }
+
+class TestCNF : public testing::Test {};
+
+TEST_F(TestCNF, SimpleTrueAndFalse) {
+  cnflogic::CNFLogicBlock cnf(true);
+
+  const LogicTerm a = cnf.makeVariable("a", CType::BOOL);
+  const LogicTerm b = cnf.makeVariable("b", CType::BOOL);
+  const LogicTerm c = cnf.makeVariable("c", CType::BOOL);
+  cnf.assertFormula(a && b);
+  cnf.assertFormula(LogicTerm::implies(b, c) || !a);
+  cnf.assertFormula(LogicTerm::ite(c, a, !b) == b);
+  EXPECT_EQ(cnf.solve(), Result::SAT);
+  auto* model = cnf.getModel();
+  EXPECT_TRUE(model->getBoolValue(a, &cnf));
+  EXPECT_TRUE(model->getBoolValue(b, &cnf));
+  EXPECT_TRUE(model->getBoolValue(c, &cnf));
+
+  cnf.assertFormula(a != c);
+  EXPECT_EQ(cnf.solve(), Result::UNSAT);
+  EXPECT_EQ(cnf.getModel(), nullptr);
+
+  // the block starts over after a reset
+  cnf.reset();
+  const LogicTerm d = cnf.makeVariable("d", CType::BOOL);
+  cnf.assertFormula(!d);
+  EXPECT_EQ(cnf.solve(), Result::SAT);
+  EXPECT_FALSE(cnf.getModel()->getBoolValue(d, &cnf));
+}
+
+TEST_F(TestCNF, Bitvectors) {
+  cnflogic::CNFLogicBlock cnf(false);
+
+  const std::vector<uint64_t> words{0x8000000000000001U, 0U, 0x3U};
+  const LogicTerm wide(words, 130);
+  const LogicTerm a = cnf.makeVariable("a", CType::BITVECTOR, 130);
+  const LogicTerm b = cnf.makeVariable("b", CType::BITVECTOR, 8);
+  const LogicTerm c = cnf.makeVariable("c", CType::BITVECTOR, 8);
+  cnf.assertFormula(a == wide);
+  cnf.assertFormula(b == LogicTerm(0b1100, 8));
+  cnf.assertFormula(LogicTerm::bvXor(b, c) == LogicTerm(0b1010, 8));
+
+  EXPECT_EQ(cnf.solve(), Result::SAT);
+  auto* model = cnf.getModel();
+  EXPECT_EQ(model->getBitvectorWords(a, &cnf), words);
+  EXPECT_EQ(model->getBitvectorValue(b, &cnf), 0b1100U);
+  EXPECT_EQ(model->getBitvectorValue(c, &cnf), 0b0110U);
+  EXPECT_EQ(model->getBitvectorValue(LogicTerm::bvAnd(b, c), &cnf), 0b0100U);
+  EXPECT_EQ(model->getBitvectorValue(LogicTerm::bvOr(b, c), &cnf), 0b1110U);
+
+  cnf.assertFormula(LogicTerm::bvAnd(b, c) == LogicTerm(0, 8));
+  EXPECT_EQ(cnf.solve(), Result::UNSAT);
+}
+
+TEST_F(TestCNF, SolveWithAssumptions) {
+  cnflogic::CNFLogicBlock cnf(true);
+
+  const LogicTerm a = cnf.makeVariable("a", CType::BOOL);
+  const LogicTerm b = cnf.makeVariable("b", CType::BOOL);
+  cnf.assertFormula(a || b);
+  cnf.assertFormula(LogicTerm::implies(a, !b));
+
+  EXPECT_EQ(cnf.solve({a}), Result::SAT);
+  EXPECT_EQ(cnf.getModel()->getBoolValue(b, &cnf), false);
+  EXPECT_EQ(cnf.solve({a, b}), Result::UNSAT);
+  EXPECT_EQ(cnf.solve({!a}), Result::SAT);
+  EXPECT_EQ(cnf.getModel()->getBoolValue(b, &cnf), true);
+
+  cnf.assertFormula(!b);
+  EXPECT_EQ(cnf.solve({!a}), Result::UNSAT);
+  EXPECT_EQ(cnf.solve({}), Result::SAT);
+  EXPECT_EQ(cnf.getModel()->getBoolValue(a, &cnf), true);
+}
+
+TEST_F(TestCNF, Cardinality) {
+  cnflogic::CNFLogicBlock cnf(true);
+
+  std::vector<LogicTerm> vars;
+  auto sum = LogicTerm(0);
+  auto count = LogicTerm(0);
+  for (std::size_t i = 0U; i < 6U; ++i) {
+    vars.emplace_back(cnf.makeVariable("x_" + std::to_string(i)));
+    sum = sum + vars.back();
+    count = count + LogicTerm::ite(vars.back(), LogicTerm(1), LogicTerm(0));
+  }
+  cnf.assertFormula(sum >= LogicTerm(2));
+  cnf.assertFormula(count <= LogicTerm(3));
+  cnf.assertFormula(vars[0] && vars[1] && vars[2]);
+
+  EXPECT_EQ(cnf.solve(), Result::SAT);
+  auto* model = cnf.getModel();
+  EXPECT_EQ(model->getIntValue(sum, &cnf), 3);
+  for (std::size_t i = 3U; i < 6U; ++i) {
+    EXPECT_FALSE(model->getBoolValue(vars[i], &cnf));
+  }
+
+  // limits on the same sum share their totalizer
+  const auto clauses = cnf.getClauseCount();
+  const auto limit = cnf.makeVariable("limit");
+  cnf.assertFormula(LogicTerm::implies(limit, count < LogicTerm(3)));
+  EXPECT_LT(cnf.getClauseCount() - clauses, 4U);
+  EXPECT_EQ(cnf.solve({limit}), Result::UNSAT);
+  EXPECT_EQ(cnf.solve({!limit}), Result::SAT);
+  EXPECT_EQ(cnf.solve({count == LogicTerm(4)}), Result::UNSAT);
+  EXPECT_EQ(cnf.solve({vars[4], sum - vars[3] > LogicTerm(3)}),
+            Result::UNSAT);
+  EXPECT_EQ(cnf.solve({sum - vars[3] == LogicTerm(3)}), Result::SAT);
+  EXPECT_EQ(cnf.getModel()->getIntValue(sum - vars[3], &cnf), 3);
+}
+
+TEST_F(TestCNF, AMOAndExactlyOne) {
+  using namespace encodings;
+
+  const std::size_t n = 11;
+  cnflogic::CNFLogicBlock cnf(false);
+
+  std::vector<std::vector<LogicTerm>> aNodes;
+  for (std::size_t i = 0; i < n; ++i) {
+    aNodes.emplace_back();
+    for (std::size_t j = 0; j < n; ++j) {
+      aNodes.back().emplace_back(cnf.makeVariable(
+          "a_" + std::to_string(i) + "_" + std::to_string(j), CType::BOOL));
+    }
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    std::vector<LogicTerm> row;
+    std::vector<LogicTerm> column;
+    for (std::size_t j = 0; j < n; ++j) {
+      row.emplace_back(aNodes[i][j]);
+      column.emplace_back(aNodes[j][i]);
+    }
+    cnf.assertFormula(
+        exactlyOneCmdr(groupVars(row, 3), LogicTerm::noneTerm(), &cnf));
+    cnf.assertFormula(atMostOneBiMander(column, &cnf));
+  }
+  EXPECT_EQ(cnf.solve(), Result::SAT);
+
+  auto* model = cnf.getModel();
+  for (std::size_t j = 0; j < n; ++j) {
+    std::size_t inColumn = 0U;
+    for (std::size_t i = 0; i < n; ++i) {
+      inColumn += model->getBoolValue(aNodes[i][j], &cnf) ? 1U : 0U;
+    }
+    EXPECT_EQ(inColumn, 1U);
+  }
+}
+
+TEST_F(TestCNF, DumpDIMACS) {
+  cnflogic::CNFLogicBlock cnf(true);
+
+  const LogicTerm a = cnf.makeVariable("a", CType::BOOL);
+  const LogicTerm b = cnf.makeVariable("b", CType::BOOL);
+  cnf.assertFormula(a || !b);
+  EXPECT_EQ(cnf.dumpInternalSolver(), "p cnf 3 2\n1 0\n2 -3 0\n");
+
+  std::stringstream ss;
+  cnf.dumpDIMACS(ss, {cnf.literal(b)});
+  EXPECT_EQ(ss.str(), "p cnf 3 3\n1 0\n2 -3 0\n3 0\n");
+
+  // arithmetic beyond sums of Boolean terms is not supported
+  const LogicTerm x = cnf.makeVariable("x", CType::INT);
+  EXPECT_THROW(cnf.assertFormula(x * LogicTerm(2) == LogicTerm(4)),
+               std::runtime_error);
+}
+
+TEST_F(TestCNF, ConflictLimit) {
+  // pigeonhole principle with 7 pigeons and 6 holes
+  const std::size_t holes = 6U;
+  cnflogic::CNFLogicBlock cnf(true);
+  std::vector<std::vector<LogicTerm>> in;
+  for (std::size_t p = 0U; p <= holes; ++p) {
+    in.emplace_back();
+    auto somewhere = LogicTerm(false);
+    for (std::size_t h = 0U; h < holes; ++h) {
+      in.back().emplace_back(cnf.makeVariable(
+          "p_" + std::to_string(p) + "_" + std::to_string(h), CType::BOOL));
+      somewhere = somewhere || in.back().back();
+    }
+    cnf.assertFormula(somewhere);
+  }
+  for (std::size_t h = 0U; h < holes; ++h) {
+    for (std::size_t p = 0U; p <= holes; ++p) {
+      for (std::size_t q = p + 1U; q <= holes; ++q) {
+        cnf.assertFormula(!in[p][h] || !in[q][h]);
+      }
+    }
+  }
+
+  cnf.setConflictLimit(10U);
+  EXPECT_EQ(cnf.solve(), Result::NDEF);
+  EXPECT_EQ(cnf.getModel(), nullptr);
+  cnf.setConflictLimit(0U);
+  cnf.setTimeout(std::chrono::milliseconds(60000));
+  EXPECT_EQ(cnf.solve(), Result::UNSAT);
+}
+
+TEST_F(TestCNF, UnsupportedParameters) {
+  logicutil::Params unknown;
+  unknown.addParam("random_seed", 42U);
+  bool success = false;
+  EXPECT_THROW(logicutil::getCNFLogicBlock(success, true, "", unknown),
+               std::invalid_argument);
+
+  logicutil::Params timeout;
+  timeout.addParam("timeout", 1000U);
+  EXPECT_NO_THROW(logicutil::getCNFLogicBlock(success, true, "", timeout));
+  // external solvers are not limited
+  EXPECT_THROW(logicutil::getCNFLogicBlock(success, true, "kissat", timeout),
+               std::invalid_argument);
+}
+
+#ifndef _WIN32
+TEST_F(TestCNF, ExternalSolverFailure) {
+  cnflogic::CNFLogicBlock cnf(true, "false");
+  const LogicTerm a = cnf.makeVariable("a", CType::BOOL);
+  cnf.assertFormula(a);
+  EXPECT_THROW(cnf.solve(), std::runtime_error);
+}
+#endif
@@ -13,11 +13,13 @@
 
 #include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <gtest/gtest.h>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace cs {
 
@@ -630,6 +632,53 @@ TEST_F(TestTableau, LargeBV) {
   for (std::size_t i = 0U; i < 128U; ++i) {
     EXPECT_EQ(tableau[i][256], 1U);
   }
+
+  // the same through words, which are not limited to 64 rows
+  const std::vector<std::uint64_t> words{0U, std::uint64_t{1} << 63U};
+  EXPECT_EQ(tableau.getBVWordsFrom(128U + 127U), words);
+  // only the given number of rows is overwritten
+  const std::vector<std::uint64_t> zeros{0U, 0U};
+  tableau.populateTableauFrom(zeros, 127, 256);
+  EXPECT_EQ(tableau.getBVWordsFrom(256), words);
+  tableau.populateTableauFrom(zeros, 128, 256);
+  EXPECT_EQ(tableau.getBVWordsFrom(256), zeros);
+}
+
+TEST_F(TestTableau, MultiWordGates) {
+  // with destabilizers, 100 qubits span several words per column
+  auto large = Tableau(100, true);
+  const auto initial = large;
+  large.applyH(99);
+  large.applyCX(99, 0);
+  large.applyS(64);
+  large.applyCX(64, 99);
+  large.applyY(3);
+  large.applySwap(0, 70);
+  EXPECT_NE(large, initial);
+  EXPECT_FALSE(large.isIdentityTableau());
+
+  large.applySwap(0, 70);
+  large.applyY(3);
+  large.applyCX(64, 99);
+  large.applySdag(64);
+  large.applyCX(99, 0);
+  large.applyH(99);
+  EXPECT_EQ(large, initial);
+  EXPECT_TRUE(large.isIdentityTableau());
+
+  // swapping two qubits is the same as applying three CNOTs
+  auto swapped = Tableau(100, true);
+  swapped.applyH(5);
+  swapped.applyS(80);
+  swapped.applyCX(5, 80);
+  auto cnots = swapped;
+  swapped.applySwap(5, 80);
+  cnots.applyCX(5, 80);
+  cnots.applyCX(80, 5);
+  cnots.applyCX(5, 80);
+  EXPECT_EQ(swapped, cnots);
+  EXPECT_EQ(swapped.getTableau(), cnots.getTableau());
+  EXPECT_EQ(Tableau(swapped.toString()), swapped);
 }
 
 TEST_F(TestTableau, TableauIO) {